@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <stdint.h>
 #include <array>
+#include <vector>
 
 /* Different intersection routines adapted from:
  * https://github.com/lemire/SIMDCompressionAndIntersection/blob/master/src/intersection.cpp
@@ -14,6 +15,9 @@ public:
 
   static size_t or_scalar(const uint32_t *A, const size_t lenA, const uint32_t *B, const size_t lenB, uint32_t **out);
 
+  // Merges any number of sorted arrays with a k-way merge. Returns the size of out (union of the sets)
+  static size_t or_sorted_runs(const std::vector<std::vector<uint32_t>>& runs, uint32_t **out);
+
   static size_t exclude_scalar(const uint32_t *src, const size_t lenSrc, const uint32_t *filter, const size_t lenFilter,
                               uint32_t **out);
 
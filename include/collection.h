@@ -21,6 +21,7 @@
 #include "synonym_index.h"
 #include "vq_model_manager.h"
 #include "join.h"
+#include "filter_tree_cache.h"
 
 struct doc_seq_id_t {
     uint32_t seq_id;
@@ -183,6 +184,10 @@ struct collection_search_args_t {
 
     static constexpr auto DIVERSITY_LAMBDA = "diversity_lambda";
 
+    static constexpr auto EXPLAIN = "explain";
+    static constexpr auto PROFILE_FILTER_BY = "profile_filter_by";
+    static constexpr auto CONTINUE_FILTER_BY = "continue_filter_by";
+
     std::string raw_query;
     std::vector<std::string> search_fields;
     std::string filter_query;
@@ -269,6 +274,9 @@ struct collection_search_args_t {
     std::string personalization_event_name;
     size_t personalization_n_events;
     float diversity_lamda;
+    bool explain = false;
+    bool profile_filter_by = false;
+    bool continue_filter_by = false;
 
     std::vector<std::vector<KV*>> result_group_kvs{};
 
@@ -431,6 +439,9 @@ private:
     std::vector<std::string> synonym_sets;
     std::vector<std::string> curation_sets;
 
+    // static filters whose facet counts are maintained by the index
+    std::vector<std::string> facet_count_filters;
+
     /// "field name" -> reference_info(referenced_collection_name, referenced_field_name, is_async)
     spp::sparse_hash_map<std::string, reference_info_t> reference_fields;
 
@@ -459,6 +470,8 @@ private:
 
     std::deque<nlohmann::json> alter_history;
 
+    mutable filter_tree_cache_t filter_tree_cache;
+
     // methods
 
     std::string get_doc_id_key(const std::string & doc_id) const;
@@ -724,6 +737,7 @@ public:
     static constexpr const char* COLLECTION_ENABLE_NESTED_FIELDS = "enable_nested_fields";
     static constexpr const char* COLLECTION_SYNONYM_SETS = "synonym_sets";
     static constexpr const char* COLLECTION_curation_sets = "curation_sets";
+    static constexpr const char* COLLECTION_FACET_COUNT_FILTERS = "facet_count_filters";
 
     static constexpr const char* COLLECTION_SYMBOLS_TO_INDEX = "symbols_to_index";
     static constexpr const char* COLLECTION_SEPARATORS = "token_separators";
@@ -790,12 +804,17 @@ public:
 
     std::vector<std::string> get_synonym_sets() const;
     std::vector<std::string> get_curation_sets() const;
+    std::vector<std::string> get_facet_count_filters() const;
 
     void update_metadata(const nlohmann::json& meta);
 
     void update_synonym_sets(const std::vector<std::string>& synonym_sets);
     void update_curation_sets(const std::vector<std::string>& curation_sets);
 
+    /// Registers static filters, e.g. `is_visible:true`, whose facet counts are maintained as documents are indexed
+    /// and removed. Wildcard searches with exactly one of these filters read their facet counts off the index.
+    Option<bool> update_facet_count_filters(const std::vector<std::string>& filter_queries);
+
     Option<bool> update_apikey(const nlohmann::json& model_config, const std::string& field_name);
 
     Option<doc_seq_id_t> to_doc(const std::string& json_str, nlohmann::json& document,
@@ -842,6 +861,12 @@ public:
     nlohmann::json get_facet_parent(const std::string& facet_field_name, const nlohmann::json& document,
                                     const std::string& val, bool is_array) const;
 
+    /// Nests the counted values of a hierarchical facet field under their closest counted ancestor. The children of
+    /// every node are truncated to the `max_children` values with the highest counts.
+    static nlohmann::json get_facet_hierarchy(const field& facet_field,
+                                              const std::vector<std::pair<std::string, uint32_t>>& value_counts,
+                                              size_t max_children);
+
     void batch_index(std::vector<index_record>& index_records, std::vector<std::string>& json_out, size_t &num_indexed,
                      const bool& return_doc, const bool& return_id, const size_t remote_embedding_batch_size = 200,
                      const size_t remote_embedding_timeout_ms = 60000, const size_t remote_embedding_num_tries = 2);
@@ -22,6 +22,8 @@ private:
 
     AuthManager auth_manager;
 
+    filter_continuations_t filter_continuations;
+
     spp::sparse_hash_map<std::string, std::shared_ptr<Collection>> collections;
 
     spp::sparse_hash_map<uint32_t, std::string> collection_id_names;
@@ -156,6 +158,8 @@ public:
 
     AuthManager& getAuthManager();
 
+    filter_continuations_t& get_filter_continuations();
+
     static Option<bool> do_search(std::map<std::string, std::string>& req_params,
                                   nlohmann::json& embedded_params,
                                   std::string& results_json_str,
@@ -206,6 +210,9 @@ public:
 
     Option<bool> update_collection_curation_sets(const std::string& collection, const std::vector<std::string>& curation_sets);
 
+    Option<bool> update_collection_facet_count_filters(const std::string& collection,
+                                                       const std::vector<std::string>& facet_count_filters);
+
     Option<nlohmann::json> get_collection_alter_status() const;
 
     static void remove_internal_fields(std::map<std::string, std::string>& params);
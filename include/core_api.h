@@ -29,6 +29,8 @@ bool get_search(const std::shared_ptr<http_req>& req, const std::shared_ptr<http
 
 bool post_multi_search(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res);
 
+bool get_filter_continuation(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res);
+
 bool get_export_documents(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res);
 
 bool post_add_document(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "sparsepp.h"
+
+/// Forward index of a facet field: seq_id => distinct facet ids of the document, stored densely by seq_id.
+///
+/// Facet ids are mapped to dense codes that are local to the field, so that the values of a field can be counted in
+/// a flat array indexed by code. Codes of values that are no longer referenced by any document are reused.
+///
+/// Documents with a single distinct facet id (all single valued fields and most arrays) are kept in a flat column.
+/// Documents with several distinct facet ids are kept in a CSR style layout: an (offset, length) span per document
+/// into a shared array of codes. Array values are deduplicated when the document is indexed, keeping the position of
+/// the first occurrence of each value so that the value can be read back from the stored document.
+class facet_forward_index_t {
+private:
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t MIN_COMPACTION_SIZE = 1024;
+
+    // code of the documents with a single distinct facet id
+    std::vector<uint32_t> single_codes;
+
+    // one bit per seq_id, set when the document's code is in `single_codes`
+    std::vector<uint64_t> single_present;
+
+    // span of the documents with several distinct facet ids, a length of zero means the document has no span
+    std::vector<uint32_t> span_offsets;
+    std::vector<uint32_t> span_lengths;
+
+    std::vector<uint32_t> span_codes;
+    std::vector<uint32_t> span_positions;
+
+    size_t num_docs = 0;
+
+    // entries of `span_codes` that are no longer referenced by a span
+    size_t num_dead_entries = 0;
+
+    spp::sparse_hash_map<uint32_t, uint32_t> facet_id_codes;
+    std::vector<uint32_t> code_facet_ids;
+    std::vector<uint32_t> code_num_docs;
+    std::vector<uint32_t> free_codes;
+
+    [[nodiscard]] bool has_single(uint32_t seq_id) const;
+
+    [[nodiscard]] bool has_span(uint32_t seq_id) const;
+
+    uint32_t acquire_code(uint32_t facet_id);
+
+    void release_code(uint32_t code);
+
+    void compact();
+
+public:
+    /// Fields with at most this many distinct values are counted in a flat array of codes.
+    static constexpr size_t MAX_DENSE_COUNT_IDS = 65'536;
+
+    /// Replaces the facet ids of the document. `facet_ids` are in the order of the values of the document and may
+    /// contain duplicates.
+    void upsert(uint32_t seq_id, const std::vector<uint32_t>& facet_ids);
+
+    void erase(uint32_t seq_id);
+
+    [[nodiscard]] bool contains(uint32_t seq_id) const;
+
+    /// Returns the number of distinct values of the document. `codes` is pointed to the codes of the values and
+    /// `positions` to the array position of each value, or to nullptr when the document has a single value at
+    /// position 0. The pointers are invalidated by the next write.
+    size_t get(uint32_t seq_id, const uint32_t*& codes, const uint32_t*& positions) const;
+
+    [[nodiscard]] uint32_t get_facet_id(uint32_t code) const {
+        return code_facet_ids[code];
+    }
+
+    /// Upper bound of the codes in use, i.e. the size of an array indexed by code.
+    [[nodiscard]] size_t num_codes() const {
+        return code_facet_ids.size();
+    }
+
+    /// Number of distinct facet ids of the field.
+    [[nodiscard]] size_t num_facet_ids() const {
+        return code_facet_ids.size() - free_codes.size();
+    }
+
+    /// Adds the number of documents having each code, among every `stride`-th of the given seq_ids, to `counts`.
+    /// `counts` must have room for `num_codes()` entries.
+    void count(const uint32_t* seq_ids, size_t seq_ids_len, size_t stride, uint32_t* counts) const;
+
+    [[nodiscard]] size_t num_ids() const {
+        return num_docs;
+    }
+};
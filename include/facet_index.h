@@ -6,7 +6,10 @@
 #include <posting_list.h>
 #include <num_tree.h>
 #include <list>
+#include <mutex>
 #include <field.h>
+#include "facet_forward_index.h"
+#include "facet_value_dict.h"
 
 struct facet_value_id_t {
     std::string facet_value;
@@ -46,20 +49,17 @@ public:
 
         ~facet_count_t () = default;
 
-        facet_count_t(const std::string& sv, uint32_t facet_count, uint32_t this_facet_id) {
-            facet_value = sv;
+        facet_count_t(uint32_t facet_count, uint32_t this_facet_id) {
             count = facet_count;
             facet_id = this_facet_id;
         }
 
         facet_count_t& operator=(facet_count_t& obj) {
-            facet_value = obj.facet_value;
             count = obj.count;
             facet_id = obj.facet_id;
             return *this;
         }
 
-        std::string facet_value;
         uint32_t count;
         uint32_t facet_id;
 
@@ -73,47 +73,82 @@ public:
 private:
     struct facet_id_seq_ids_t {
         void* seq_ids;
-        uint32_t facet_id;
         std::multiset<facet_count_t>::iterator facet_count_it;
 
         facet_id_seq_ids_t() {
             seq_ids = nullptr;
-            facet_id = UINT32_MAX;
         }
 
         ~facet_id_seq_ids_t() {};
     };
     
     struct facet_doc_ids_list_t {
-        std::map<std::string, facet_id_seq_ids_t> fvalue_seq_ids;
-        spp::sparse_hash_map<uint32_t, std::string> fid_fvalues;
+        // facet values are stored once in the dictionary and referred to by their facet id in the other structures
+        facet_value_dict_t fvalues;
+        spp::sparse_hash_map<uint32_t, facet_id_seq_ids_t> fid_seq_ids;
         std::multiset<facet_count_t> counts;
 
+        // facet ids of the value index in the order of their values, rebuilt lazily for alphabetical sorting
+        std::vector<uint32_t> sorted_fids;
+        bool sorted_fids_stale = true;
+        std::mutex sorted_fids_mutex;
+
+        // token => sorted facet ids of the values of the value index having that token, so that the values matching
+        // a facet query are looked up by token prefix instead of tokenizing every value at query time
+        bool has_token_index = false;
+        bool tokenize_values = false;
+        std::string locale;
+        std::vector<char> symbols_to_index;
+        std::vector<char> token_separators;
+        tsl::htrie_map<char, std::vector<uint32_t>> token_fids;
+
         posting_list_t* seq_id_hashes = nullptr;
         spp::sparse_hash_map<uint32_t, int64_t> fhash_to_int64_map;
 
+        // seq_id => distinct facet hashes, used for counting
+        facet_forward_index_t* forward_index = nullptr;
+
         bool has_value_index = true;
         bool has_hash_index = true;
 
         facet_doc_ids_list_t() {
-            fvalue_seq_ids.clear();
+            fid_seq_ids.clear();
             counts.clear();
             seq_id_hashes = new posting_list_t(256);
+            forward_index = new facet_forward_index_t();
         }
 
         facet_doc_ids_list_t(const facet_doc_ids_list_t& other) = delete;
 
         ~facet_doc_ids_list_t() {
-            for(auto it = fvalue_seq_ids.begin(); it != fvalue_seq_ids.end(); ++it) {
+            drop_value_index();
+
+            delete seq_id_hashes;
+            delete forward_index;
+        }
+
+        void drop_value_index() {
+            for(auto it = fid_seq_ids.begin(); it != fid_seq_ids.end(); ++it) {
                 if(it->second.seq_ids) {
                     ids_t::destroy_list(it->second.seq_ids);
                 }
             }
-    
-            fvalue_seq_ids.clear();
+
+            fid_seq_ids.clear();
             counts.clear();
+            sorted_fids.clear();
+            sorted_fids_stale = true;
+            token_fids.clear();
+        }
 
-            delete seq_id_hashes;
+        const facet_id_seq_ids_t* find_value(const std::string& fvalue) const {
+            uint32_t facet_id;
+            if(!fvalues.find(fvalue, facet_id)) {
+                return nullptr;
+            }
+
+            const auto it = fid_seq_ids.find(facet_id);
+            return (it == fid_seq_ids.end()) ? nullptr : &it->second;
         }
     };
 
@@ -128,6 +163,20 @@ private:
     void get_stringified_values(const nlohmann::json& document, const field& afield,
                                 std::vector<std::string>& values);
 
+    static const std::vector<uint32_t>& get_sorted_fids(facet_doc_ids_list_t& facet_index);
+
+    static void get_value_tokens(const facet_doc_ids_list_t& facet_index, const std::string& fvalue,
+                                 std::vector<std::string>& tokens);
+
+    static void index_value_tokens(facet_doc_ids_list_t& facet_index, uint32_t facet_id, const std::string& fvalue);
+
+    static void remove_value_tokens(facet_doc_ids_list_t& facet_index, uint32_t facet_id, const std::string& fvalue);
+
+    /// Maps every facet id whose value matches one of the searched queries to the index of the first such query.
+    static void search_token_index(const facet_doc_ids_list_t& facet_index,
+                                   const std::vector<std::vector<std::string>>& fvalue_searched_tokens,
+                                   spp::sparse_hash_map<uint32_t, size_t>& matched_fids);
+
 public:
 
     facet_index_t() = default;
@@ -164,6 +213,11 @@ public:
     
     void initialize(const std::string& field);
 
+    /// Indexes the tokens of the facet values of the field for facet queries. String values are tokenized like the
+    /// facet query tokens are matched against them, other values are indexed as a single token.
+    void initialize_token_index(const std::string& field_name, bool tokenize_values, const std::string& locale,
+                                const std::vector<char>& symbols_to_index, const std::vector<char>& token_separators);
+
     void handle_index_change(const std::string& field_name, size_t total_num_docs,
                              size_t facet_index_threshold, size_t facet_count);
 
@@ -175,6 +229,8 @@ public:
 
     posting_list_t* get_facet_hash_index(const std::string& field_name) const;
 
+    const facet_forward_index_t* get_facet_forward_index(const std::string& field_name) const;
+
     //get fhash=>int64 map for stats
     const spp::sparse_hash_map<uint32_t, int64_t>& get_fhash_int64_map(const std::string& field_name);
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "sparsepp.h"
+
+/// Interned facet values of a field.
+///
+/// Every distinct value is copied once into append-only blocks and is referred to everywhere else by its facet id,
+/// so that the maps of the facet index can key on integers instead of holding their own copies of the string.
+/// Space of erased values is reclaimed by compacting the blocks once it outweighs the space of live values.
+/// Views returned by `get()` are valid only until the next call that modifies the dictionary.
+class facet_value_dict_t {
+private:
+    static constexpr size_t MIN_BLOCK_SIZE = 1024;
+    static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t last_block_size = 0;
+    size_t last_block_used = 0;
+    size_t block_bytes = 0;
+
+    spp::sparse_hash_map<uint32_t, std::string_view> fid_values;
+    spp::sparse_hash_map<std::string_view, uint32_t, std::hash<std::string_view>> value_fids;
+
+    size_t live_bytes = 0;
+    size_t dead_bytes = 0;
+
+    std::string_view store(std::string_view value);
+
+    void compact();
+
+public:
+    facet_value_dict_t() = default;
+
+    facet_value_dict_t(const facet_value_dict_t& other) = delete;
+
+    facet_value_dict_t& operator=(const facet_value_dict_t& other) = delete;
+
+    /// Interns `value` under `facet_id`. Returns false, leaving the dictionary unchanged, when either the value or
+    /// the facet id is already present.
+    bool add(uint32_t facet_id, std::string_view value);
+
+    bool find(std::string_view value, uint32_t& facet_id) const;
+
+    /// Returns an empty view for an unknown facet id.
+    [[nodiscard]] std::string_view get(uint32_t facet_id) const;
+
+    [[nodiscard]] bool contains(uint32_t facet_id) const {
+        return fid_values.count(facet_id) != 0;
+    }
+
+    void erase(uint32_t facet_id);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const {
+        return fid_values.size();
+    }
+
+    /// Bytes held by the blocks, including the space of erased values that has not been reclaimed yet.
+    [[nodiscard]] size_t allocated_bytes() const {
+        return block_bytes;
+    }
+};
@@ -15,6 +15,7 @@
 #include <mutex>
 #include "stemmer_manager.h"
 #include "filter_result_iterator.h"
+#include "space_saving_sketch.h"
 
 namespace field_types {
     // first field value indexed will determine the type
@@ -87,6 +88,10 @@ namespace fields {
     static const std::string store = "store";
     
     static const std::string hnsw_params = "hnsw_params";
+
+    static const std::string expression = "expression";
+
+    static const std::string hierarchy_separator = "hierarchy_separator";
 }
 
 enum vector_distance_type_t {
@@ -110,6 +115,8 @@ struct reference_pair_t {
     }
 };
 
+struct sort_by;
+
 struct field {
     std::string name;
     std::string type;
@@ -148,6 +155,14 @@ struct field {
   
     nlohmann::json hnsw_params;
 
+    // Decay function over an integer field whose value is computed at index time, e.g.
+    // `timestamp(func: exp, origin: 1700000000, scale: 86400)`.
+    std::string expression;
+
+    // Separator of the levels of a category path like `Electronics > Phones > Android`. The values of a hierarchical
+    // facet field are faceted along with all their ancestor paths.
+    std::string hierarchy_separator;
+
     std::vector<char> token_separators;
     std::vector<char> symbols_to_index;
 
@@ -286,6 +301,17 @@ struct field {
         return is_dynamic(name, type);
     }
 
+    bool is_derived() const {
+        return !expression.empty();
+    }
+
+    bool is_hierarchical() const {
+        return !hierarchy_separator.empty();
+    }
+
+    /// Appends the ancestor paths of a hierarchical facet value, from the root down to its parent.
+    void get_hierarchy_ancestors(const std::string& path, std::vector<std::string>& ancestors) const;
+
     bool has_numerical_index() const {
         return (type == field_types::INT32 || type == field_types::INT64 ||
                 type == field_types::FLOAT || type == field_types::BOOL);
@@ -431,6 +457,13 @@ struct field {
                                                        const nlohmann::json& fields_json,
                                                        field& the_field);
 
+    /// Parses the `expression` of a derived field into the decay function it stands for.
+    static Option<bool> parse_derived_expression(const std::string& expression, sort_by& decay_function);
+
+    static Option<bool> validate_derived_field(const tsl::htrie_map<char, field>& search_schema,
+                                               const nlohmann::json& fields_json,
+                                               const field& the_field);
+
 
     static bool flatten_obj(nlohmann::json& doc, nlohmann::json& value, bool has_array, bool has_obj_array,
                             bool is_update, const field& the_field, const std::string& flat_name,
@@ -719,6 +752,9 @@ struct sort_by {
     [[nodiscard]] inline bool is_nested_join_sort_by() const {
         return nested_join_collection_names.size() > 1;
     }
+
+    /// Parses the comma separated `key: value` params of a decay function or of the `missing_values` option.
+    Option<bool> parse_decay_function_params(const std::string& sort_params_str, const std::string& error);
 };
 
 class GeoPoint {
@@ -760,6 +796,8 @@ struct facet_count_t {
     uint32_t array_pos = 0;
     //for sorting based on other field
     int64_t sort_field_val;
+    // for sketched facets: `count` overestimates the true count by at most this much
+    uint32_t count_error = 0;
 };
 
 struct facet_stats_t {
@@ -817,6 +855,33 @@ struct facet {
 
     bool is_top_k = false;
 
+    // counted against the results of the query with the filter clauses on its own field left out
+    bool is_disjunctive = false;
+    bool has_disjunctive_result_ids = false;
+    std::vector<uint32_t> disjunctive_result_ids;
+
+    // set when the top values were read off the counts of a facet count filter, which has this many distinct values
+    size_t num_filter_values = 0;
+
+    // set on the facets of a partition of the results: counts of the dense facet codes are left in `code_counts`
+    // so that they can be summed across partitions before the result map is filled
+    bool defer_code_counts = false;
+    std::vector<uint32_t> code_counts;
+
+    // set for the `sketch` strategy: values of each partition of the results are streamed into a space saving sketch of
+    // this many counters, which are merged across partitions, instead of being counted over a sample of the results
+    size_t sketch_capacity = 0;
+    space_saving_sketch_t value_sketch;
+
+    // cleared on the facets of every partition when a sketched facet can't be counted densely in all of them, since
+    // the dense counts of some partitions can't be merged with the sketches of the others
+    bool use_dense_counts = true;
+
+    // counts were estimated with a sketch rather than counted densely: no value left out of the result map occurs more
+    // than `count_error_bound` times
+    bool sketched = false;
+    uint32_t count_error_bound = 0;
+
     bool get_range(int64_t key, std::pair<int64_t, std::string>& range_pair) {
         if(facet_range_map.empty()) {
             LOG (ERROR) << "Facet range is not defined!!!";
@@ -869,6 +934,7 @@ struct facet_value_t {
     int64_t sort_field_val;
     nlohmann::json parent;
     std::string facet_filter;
+    uint32_t count_error = 0;
 };
 
 struct facet_hash_values_t {
@@ -23,7 +23,9 @@ enum NUM_COMPARATOR {
     GREATER_THAN,
     GREATER_THAN_EQUALS,
     RANGE_INCLUSIVE,
-    CONTAINS_PHRASE
+    CONTAINS_PHRASE,
+    STARTS_WITH,
+    ENDS_WITH
 };
 
 enum FILTER_OPERATOR {
@@ -114,6 +116,17 @@ struct filter_node_t {
               left(left),
               right(right) {}
 
+    /// Deep copy of the subtree.
+    filter_node_t(const filter_node_t& obj)
+            : filter_exp(obj.filter_exp),
+              filter_operator(obj.filter_operator),
+              isOperator(obj.isOperator),
+              left(obj.left == nullptr ? nullptr : new filter_node_t(*obj.left)),
+              right(obj.right == nullptr ? nullptr : new filter_node_t(*obj.right)),
+              filter_query(obj.filter_query),
+              is_object_filter_root(obj.is_object_filter_root),
+              object_field_name(obj.object_field_name) {}
+
     ~filter_node_t() {
         delete left;
         delete right;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "json.hpp"
+#include "option.h"
+#include "threadpool.h"
+
+/// Cost of evaluating a single clause of a filter tree.
+struct filter_clause_profile_t {
+    std::string filter;
+
+    /// Time spent on building the iterator of the clause and on materializing or probing its ids. The time spent on
+    /// iterating a lazily evaluated clause along with the search is not included.
+    uint64_t time_us = 0;
+
+    /// Exact when the ids were materialized, otherwise the approximate number of ids of the clause.
+    uint32_t num_ids = 0;
+    bool is_materialized = false;
+    bool is_cached = false;
+
+    /// Whether the clause was cut off by `search_cutoff_ms`.
+    bool search_cutoff = false;
+};
+
+/// Costs of the clauses of a filter tree, in the order the clauses were built.
+struct filter_profile_t {
+    // Iterators of the clauses hold on to their entries while the tree is built, which a deque doesn't invalidate.
+    std::deque<filter_clause_profile_t> clauses;
+
+    [[nodiscard]] nlohmann::json to_json() const;
+};
+
+/// Filters of the searches that were cut off by `search_cutoff_ms`, evaluated again in the background with a larger
+/// budget so that the number of documents they match can be fetched later on.
+///
+/// The budget is the `filter-continuation-timeout-ms` server option, which is off by default: the evaluation holds the
+/// read locks of the collection, so writes to it wait for up to the budget. Continuations are kept in memory on the
+/// node that served the search and are not replicated, so they can only be fetched from that node.
+class filter_continuations_t {
+private:
+    struct entry_t {
+        std::string collection_name;
+        std::string filter_query;
+        bool completed = false;
+        std::string error;
+        uint32_t found = 0;
+        uint64_t time_ms = 0;
+    };
+
+    static constexpr size_t MAX_ENTRIES = 1000;
+
+    mutable std::mutex mutex;
+    std::map<uint64_t, entry_t> entries;
+    uint64_t next_id = 0;
+    size_t num_pending = 0;
+    bool is_stopped = false;
+
+    std::unique_ptr<ThreadPool> worker;
+
+    void complete(uint64_t id, const Option<uint32_t>& found_op, uint64_t time_ms);
+
+public:
+    /// Continuations that are queued or running at once, beyond which new ones are rejected.
+    static constexpr size_t MAX_PENDING = 16;
+
+    filter_continuations_t() = default;
+
+    ~filter_continuations_t();
+
+    filter_continuations_t(const filter_continuations_t& other) = delete;
+
+    filter_continuations_t& operator=(const filter_continuations_t& other) = delete;
+
+    /// Queues `evaluate`, which returns the number of documents matched by the filter, and returns the id under which
+    /// its status is tracked. Only the most recent continuations are kept: a continuation that is dropped before it
+    /// runs is not evaluated.
+    Option<uint64_t> add(const std::string& collection_name, const std::string& filter_query,
+                         std::function<Option<uint32_t>()> evaluate);
+
+    /// Returns false when there is no continuation with the id for the collection.
+    bool get(const std::string& collection_name, uint64_t id, nlohmann::json& status) const;
+
+    /// Waits for the running continuation to finish. Queued continuations are failed without being evaluated and new
+    /// ones are rejected.
+    void shutdown();
+};
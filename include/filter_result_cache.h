@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Materialized results of the filter subtrees of a collection, keyed by the normalized subtree.
+///
+/// Every field has a write epoch that is bumped once a write to the field is visible to searches. An entry records
+/// the epochs of the fields it was computed from, which are read before the computation begins, so it is stale once
+/// any of them has been written to since. Entries are evicted in least recently used order when the ids held by the
+/// cache exceed its budget.
+class filter_result_cache_t {
+public:
+    typedef std::vector<std::pair<std::string, uint64_t>> field_epochs_t;
+
+private:
+    struct entry_t {
+        std::string key;
+        field_epochs_t field_epochs;
+        std::shared_ptr<const std::vector<uint32_t>> ids;
+        size_t num_bytes;
+    };
+
+    mutable std::mutex mutex;
+
+    // most recently used entry first
+    std::list<entry_t> entries;
+    std::unordered_map<std::string, std::list<entry_t>::iterator> key_entries;
+    std::unordered_map<std::string, uint64_t> epochs;
+
+    size_t max_bytes = 0;
+    size_t used_bytes = 0;
+
+    void erase(std::list<entry_t>::iterator entry_it);
+
+    [[nodiscard]] bool is_stale(const entry_t& entry) const;
+
+public:
+    filter_result_cache_t() = default;
+
+    filter_result_cache_t(const filter_result_cache_t& other) = delete;
+
+    filter_result_cache_t& operator=(const filter_result_cache_t& other) = delete;
+
+    /// A budget of zero disables the cache.
+    void set_max_bytes(size_t max_bytes);
+
+    [[nodiscard]] bool is_enabled() const;
+
+    /// Returns the current epochs of the fields, which are to be recorded with a result computed after this call.
+    [[nodiscard]] field_epochs_t get_epochs(const std::vector<std::string>& field_names) const;
+
+    void bump_epoch(const std::string& field_name);
+
+    /// Returns false when there is no entry for the key or the entry is stale, in which case it is dropped.
+    bool lookup(const std::string& key, std::shared_ptr<const std::vector<uint32_t>>& ids);
+
+    /// Results that would take up more than the whole budget are not cached.
+    void insert(const std::string& key, field_epochs_t field_epochs, std::vector<uint32_t>&& ids);
+
+    /// Drops all the entries. Epochs are kept, so that results being computed while clearing are still seen as stale.
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+
+    /// Bytes charged for the entries, which include their ids and bookkeeping.
+    [[nodiscard]] size_t bytes() const;
+};
@@ -9,6 +9,11 @@
 #include "option.h"
 #include "posting_list.h"
 #include "id_list.h"
+#include "min_max_column.h"
+#include "filter_result_cache.h"
+#include "id_bitset.h"
+#include "object_filter.h"
+#include "filter_profile.h"
 
 class Index;
 struct filter_node_t;
@@ -240,13 +245,31 @@ struct filter_result_t {
     constexpr uint16_t string_filter_ids_threshold = 3;
     constexpr uint16_t bool_filter_ids_threshold = 3;
     constexpr uint16_t numeric_filter_ids_threshold = 3;
+    constexpr uint32_t dense_filter_result_min_ids = 64;
+    constexpr uint32_t string_filter_max_lazy_values = 4;
+    constexpr uint32_t affix_filter_max_tokens = 3;
 #else
     constexpr uint16_t function_call_modulo = 16'384;
     constexpr uint16_t string_filter_ids_threshold = 20'000;
     constexpr uint16_t bool_filter_ids_threshold = 20'000;
     constexpr uint16_t numeric_filter_ids_threshold = 20'000;
+    constexpr uint32_t dense_filter_result_min_ids = 4'096;
+    constexpr uint32_t string_filter_max_lazy_values = 64;
+    constexpr uint32_t affix_filter_max_tokens = 10'000;
 #endif
 
+/// A subtree of `&&` that is estimated to match this many times more ids than its sibling is probed with the ids of the
+/// sibling instead of being materialized.
+constexpr uint32_t filter_probe_selectivity_ratio = 8;
+
+/// A range filter on a float field that is estimated to match at least 1/ratio of the field's values is evaluated by
+/// scanning the field's float column instead of collecting the ids from the numeric index.
+constexpr uint32_t float_column_scan_ratio = 16;
+
+/// A materialized result of at least `dense_filter_result_min_ids` ids is held as a bitset when the bitset takes at
+/// most 1/ratio of the memory of the id array, i.e. when at least 1 in 16 of the ids up to the largest one match.
+constexpr uint32_t dense_filter_result_ratio = 2;
+
 struct filter_result_iterator_timeout_info {
     filter_result_iterator_timeout_info(uint64_t search_begin_us, uint64_t search_stop_us);
 
@@ -272,13 +295,28 @@ private:
     /// Used in case of id and reference filter.
     uint32_t result_index = 0;
 
-    /// Initialized in case of `id: *` filter.
+    /// Initialized in case of `id: *` filter and of a complement iterator.
     id_list_t::iterator_t all_seq_ids_iterator = id_list_t::iterator_t(nullptr, nullptr, nullptr, false);
 
+    /// Set when the filter matches every id of the collection except the sorted `complement_excluded_ids`, e.g. in case
+    /// of `id: != [...]` and of a negated join. The ids are walked with `all_seq_ids_iterator`, skipping the excluded
+    /// ones, so that only the excluded ids are held instead of the complement. References of the matched ids, if any,
+    /// are kept in `filter_result`, which is not initialized until `compute_iterators()` materializes the complement.
+    bool is_complement_iterator = false;
+    std::vector<uint32_t> complement_excluded_ids;
+    uint32_t complement_excluded_index = 0;
+
     /// Stores the result of the filters that cannot be iterated.
     filter_result_t filter_result{};
     bool is_filter_result_initialized = false;
 
+    /// Holds the result in place of `filter_result.docs` when it is dense, in which case `filter_result.count` is still
+    /// the number of ids and `seq_id` is the position of the iterator instead of `result_index`.
+    std::unique_ptr<id_bitset_t> dense_result;
+
+    /// Filter tree of an object filter root, compiled when the iterator is initialized.
+    object_filter_t object_filter;
+
     /// Initialized in case of filter on string field.
     /// Sample filter values: ["foo bar", "baz"]. Each filter value is split into tokens. We get posting list iterator
     /// for each token.
@@ -318,10 +356,45 @@ private:
     /// Sample filter: [Chris P*].
     std::unordered_set<uint32_t> string_prefix_filter_index;
 
+    /// Initialized in case of a lazily evaluated filter on a numeric array field. Probed ids are first checked against
+    /// the smallest and largest value of the document so that the id lists are only consulted when the bounds are
+    /// inconclusive.
+    min_max_column_t const* min_max_column = nullptr;
+    std::vector<std::pair<int64_t, int64_t>> min_max_key_ranges;
+
     bool delete_filter_node = false;
 
     std::unique_ptr<filter_result_iterator_timeout_info> timeout_info;
 
+    /// Set when the results of the subtree are cached: the result is added to the cache under `filter_cache_key` once
+    /// it is computed, along with the epochs of its fields from before the computation began.
+    filter_result_cache_t* filter_cache = nullptr;
+    std::string filter_cache_key;
+    filter_result_cache_t::field_epochs_t filter_cache_epochs;
+
+    /// Set on the clauses of a profiled filter tree, i.e. its leaves and object filter roots.
+    filter_clause_profile_t* profile_clause = nullptr;
+
+    /// Builds the normalized key of the subtree and collects the fields that its result depends on. Returns false when
+    /// the result of the subtree cannot be cached.
+    static bool get_filter_cache_key(const filter_node_t* filter_node, std::string& key,
+                                     std::vector<std::string>& field_names);
+
+    void add_to_filter_cache();
+
+    void compute_filter_result();
+
+    /// Moves a dense result without references into `dense_result`.
+    void to_dense_result();
+
+    /// Moves `dense_result` back into `filter_result.docs`, for the operations that need the ids as an array.
+    void to_sparse_result();
+
+    /// Collects up to n ids of `dense_result`, skipping the ids present in excluded_result_ids.
+    void get_n_dense_ids(const uint32_t& n, uint32_t& excluded_result_index,
+                         uint32_t const* const excluded_result_ids, const size_t& excluded_result_ids_size,
+                         filter_result_t*& result);
+
     /// Initializes the state of iterator node after it's creation.
     void init(const bool& enable_lazy_evaluation, const bool& validate_field_names);
 
@@ -331,6 +404,12 @@ private:
     /// Performs OR on the subtrees of operator.
     void or_filter_iterators();
 
+    /// Adds the posting list of every token of the field that starts or ends with the token of `filter_value` as a
+    /// filter value of its own, so that the lists are OR-ed. Suffixes are looked up in the infix index of the field.
+    /// Fails when the token expands into more than `affix_filter_max_tokens` tokens.
+    Option<bool> init_affix_string_filter(const field& f, const std::string& filter_value,
+                                          const NUM_COMPARATOR& comparator);
+
     /// Advances all the token iterators that are at seq_id.
     void advance_string_filter_token_iterators();
 
@@ -357,8 +436,51 @@ private:
     /// this operation.
     void skip_to(uint32_t id);
 
-    static bool validate_object_filter_helper(Index const* const index, const nlohmann::json& doc,
-                                              const filter_node_t* filter_node);
+    /// Estimates the number of ids matched by the subtree from the number of `id` values, the value distribution of
+    /// numeric fields, the facet value counts and token posting lists of string fields and the value counts of bool
+    /// fields. Returns UINT32_MAX when the estimate is not available.
+    static uint32_t estimate_filter_ids_length(Index const* const index, const filter_node_t* filter_node);
+
+    static uint32_t estimate_string_filter_ids_length(Index const* const index, const field& f, const filter& a_filter);
+
+    /// Collects the operands of the chain of `&&` operators rooted at `filter_node` along with the operator nodes of
+    /// the chain, in pre-order.
+    static void get_and_operands(filter_node_t* filter_node, std::vector<filter_node_t*>& operator_nodes,
+                                 std::vector<filter_node_t*>& operands);
+
+    /// Returns true when a filter of the subtree is on a referenced collection.
+    static bool has_reference_filter(const filter_node_t* filter_node);
+
+    /// Records the estimate, the evaluation strategy and the size of the result of this node in `plan`.
+    void explain(nlohmann::json* plan, const uint32_t& estimate) const;
+
+    /// Turns this node into a complement iterator that matches every id except `excluded_ids`, which must be sorted.
+    void init_complement_iterator(std::vector<uint32_t>&& excluded_ids);
+
+    /// Moves `all_seq_ids_iterator` past the excluded ids and positions the complement iterator on its id.
+    void skip_complement_excluded_ids();
+
+    /// Materializes the ids of the complement iterator, along with their references, into `filter_result`.
+    void compute_complement_result();
+
+    /// Adds the time elapsed since `begin_us` to the profile of the clause and records the state of its result.
+    void update_profile_clause(const uint64_t& begin_us);
+
+    /// Returns true if the subtree is a numeric filter that can be evaluated lazily, i.e. probed via `is_valid`.
+    static bool is_lazy_numeric_filter(Index const* const index, const filter_node_t* filter_node);
+
+    /// Evaluates a broad range filter on a single valued float field by scanning its float column.
+    /// Returns false when the filter is not eligible, in which case `result` is left untouched.
+    static bool float_column_range_search(Index const* const index, const filter& a_filter, filter_result_t& result);
+
+    /// Converts the values of a numeric filter into inclusive ranges of numeric index keys.
+    /// Returns false when the filter has a comparator other than a range or equality.
+    static bool get_numeric_key_ranges(const bool& is_float, const filter& a_filter,
+                                       std::vector<std::pair<int64_t, int64_t>>& key_ranges);
+
+    void init_min_max_key_ranges(const field& f, const filter& a_filter);
+
+    [[nodiscard]] min_max_column_t::range_match_t match_min_max(const uint32_t& id) const;
 
     bool validate_object_filter();
 
@@ -389,7 +511,10 @@ public:
                                       const bool& enable_lazy_evaluation = false,
                                       const size_t& max_candidates = DEFAULT_FILTER_BY_CANDIDATES,
                                       uint64_t search_begin_us = 0, uint64_t search_stop_us = UINT64_MAX,
-                                      const bool& validate_field_names = true);
+                                      const bool& validate_field_names = true,
+                                      filter_result_cache_t* filter_cache = nullptr,
+                                      nlohmann::json* plan = nullptr,
+                                      filter_profile_t* profile = nullptr);
 
     explicit filter_result_iterator_t(FILTER_OPERATOR filter_operator, filter_result_iterator_t* filter_result_iterator,
                                       filter_result_iterator_t* new_iterator,
@@ -402,6 +527,12 @@ public:
     /// Returns the status of the initialization of iterator tree.
     Option<bool> init_status();
 
+    /// Rearranges every chain of `&&` operators in the tree so that its operands are evaluated in the increasing order
+    /// of their estimated number of matches. The most selective operand is built first and drives the evaluation of the
+    /// chain, the others can be skipped when it doesn't match any document. Chains with a reference filter in any
+    /// operand are left as they are, since the references of their operands are merged in the order of the operands.
+    static void reorder_filter_tree(Index const* const index, filter_node_t* const filter_node);
+
     /// Recursively computes the result of each node and stores the final result in the root node.
     void compute_iterators();
 
@@ -453,6 +584,10 @@ public:
         return is_filter_result_initialized;
     }
 
+    [[nodiscard]] bool _get_is_dense_result() const {
+        return dense_result != nullptr;
+    }
+
     [[nodiscard]] filter_result_iterator_t* _get_left_it() const {
         return left_it;
     }
@@ -473,6 +608,10 @@ public:
         return filter_node != nullptr;
     }
 
+    [[nodiscard]] inline const filter_node_t* get_filter_node() const {
+        return filter_node;
+    }
+
     [[nodiscard]] inline bool result_has_references() const {
         return is_filter_result_initialized && filter_result.coll_to_references != nullptr;
     }
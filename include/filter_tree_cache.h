@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "filter.h"
+#include "lru/lru.hpp"
+
+/// Parsed and validated `filter_by` trees of a collection, keyed by the filter string.
+///
+/// Every query gets its own copy of the cached tree, since the tree is owned and extended by the search. A tree is
+/// parsed against the schema of the collection, so all the trees are dropped when the schema changes. `id` filters
+/// are resolved to sequence ids while parsing, so a tree with an `id` filter is stale once a document id has been
+/// added or removed since it was parsed.
+class filter_tree_cache_t {
+private:
+    struct entry_t {
+        std::shared_ptr<const filter_node_t> root;
+        uint64_t schema_version = 0;
+        bool has_id_filter = false;
+        uint64_t doc_ids_epoch = 0;
+    };
+
+    mutable std::mutex mutex;
+
+    LRU::Cache<std::string, entry_t> entries;
+
+    std::atomic<size_t> max_entries = 0;
+
+    std::atomic<uint64_t> schema_version = 0;
+    std::atomic<uint64_t> doc_ids_epoch = 0;
+
+    /// Returns false when the tree depends on the state of another collection.
+    static bool is_cacheable(const filter_node_t* filter_node, bool& has_id_filter);
+
+public:
+    filter_tree_cache_t() = default;
+
+    filter_tree_cache_t(const filter_tree_cache_t& other) = delete;
+
+    filter_tree_cache_t& operator=(const filter_tree_cache_t& other) = delete;
+
+    /// Zero disables the cache.
+    void set_max_entries(size_t max_entries);
+
+    /// Called once a change of the schema is visible to searches.
+    void bump_schema_version();
+
+    /// Called once a document id has been written to or removed from the store.
+    void bump_doc_ids_epoch();
+
+    /// Same as `filter::parse_filter_query`, but returns a copy of the cached tree when there is a fresh one.
+    Option<bool> parse_filter_query(const std::string& filter_query,
+                                    const tsl::htrie_map<char, field>& search_schema,
+                                    const Store* store,
+                                    const std::string& doc_id_prefix,
+                                    filter_node_t*& root,
+                                    const bool& validate_field_names = true);
+
+    [[nodiscard]] size_t size() const;
+};
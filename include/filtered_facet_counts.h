@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sparsepp.h"
+
+/// Facet counts of the documents matching a static filter, e.g. `is_visible:true`.
+///
+/// The counts are maintained as documents are indexed and removed, so that the top values of a field for the filter
+/// are read off in O(top-N) instead of being counted over every matching document at query time. Values are keyed by
+/// the facet ids of the field's facet index.
+class filtered_facet_counts_t {
+private:
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    struct count_compare_t {
+        // (count, facet_id) by descending count, then by ascending facet id
+        bool operator()(const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) const {
+            return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+        }
+    };
+
+    struct field_counts_t {
+        spp::sparse_hash_map<uint32_t, uint32_t> facet_id_counts;
+        std::set<std::pair<uint32_t, uint32_t>, count_compare_t> ordered_counts;
+    };
+
+    // one bit per seq_id, set when the document matches the filter
+    std::vector<uint64_t> ids;
+
+    size_t num_ids = 0;
+
+    std::unordered_map<std::string, field_counts_t> field_counts;
+
+    void update_count(field_counts_t& counts, uint32_t facet_id, uint32_t old_count, uint32_t new_count);
+
+public:
+    /// Marks the document as matching the filter. Returns false when it was already marked.
+    bool add(uint32_t seq_id);
+
+    /// Returns false when the document was not marked as matching the filter.
+    bool remove(uint32_t seq_id);
+
+    [[nodiscard]] bool contains(uint32_t seq_id) const;
+
+    [[nodiscard]] size_t size() const {
+        return num_ids;
+    }
+
+    /// Counts the distinct facet ids of a matching document's field value.
+    void add_facet_ids(const std::string& field_name, const uint32_t* facet_ids, size_t num_facet_ids);
+
+    void remove_facet_ids(const std::string& field_name, const uint32_t* facet_ids, size_t num_facet_ids);
+
+    /// Appends up to `k` (facet_id, count) pairs of the field, by descending count.
+    void get_top_counts(const std::string& field_name, size_t k,
+                        std::vector<std::pair<uint32_t, uint32_t>>& facet_id_counts) const;
+
+    [[nodiscard]] uint32_t get_count(const std::string& field_name, uint32_t facet_id) const;
+
+    /// Number of distinct facet ids of the field with a non-zero count.
+    [[nodiscard]] size_t num_values(const std::string& field_name) const;
+
+    void erase_field(const std::string& field_name);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Columnar storage of the values of a single valued float field, stored densely by seq_id.
+///
+/// Values are kept as raw floats so that reads need no decoding. Comparisons are made on an order preserving int32 key
+/// of the value that is identical to `Index::float_to_int64_t`, so results match those of the int64 keyed numeric
+/// indices bit for bit (e.g. -0.0 is ordered before 0.0). Range searches compare four values at a time with SIMD.
+class float_column_t {
+private:
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    // sized to a multiple of `BLOCK_SIZE` so that the SIMD loads of a block never run past the end
+    std::vector<float> values;
+
+    // one bit per seq_id, set when the document has a value
+    std::vector<uint64_t> present;
+
+    size_t num_values = 0;
+
+public:
+    /// Order preserving key of a float value; identical to the value returned by `Index::float_to_int64_t`.
+    static int32_t to_key(float value);
+
+    static float from_key(int32_t key);
+
+    void set(uint32_t seq_id, float value);
+
+    void remove(uint32_t seq_id);
+
+    [[nodiscard]] bool contains(uint32_t seq_id) const;
+
+    /// Returns false when the document has no value.
+    bool get(uint32_t seq_id, float& value) const;
+
+    /// Appends the ids, in ascending order, of the documents whose value has a key within [start_key, end_key].
+    void range_search(int32_t start_key, int32_t end_key, std::vector<uint32_t>& ids) const;
+
+    /// Finds the smallest and largest of the values of the given ids. Returns false when none of the ids has a value.
+    bool get_min_max(const uint32_t* ids, size_t ids_len, float& min, float& max) const;
+
+    /// Finds the smallest, largest, sum and number of the values of the given ids, four ids at a time.
+    /// Returns false when none of the ids has a value.
+    bool get_stats(const uint32_t* ids, size_t ids_len, float& min, float& max, double& sum, size_t& count) const;
+
+    [[nodiscard]] size_t size() const {
+        return num_values;
+    }
+};
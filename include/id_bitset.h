@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Set of seq ids stored as one bit per id in [0, largest id].
+///
+/// Used in place of a sorted id array for filter results that match a large share of the collection: a lookup is a
+/// single bit test, two sets are combined a word at a time with SIMD and the set takes 1/32 of the memory of the array
+/// once every id is present.
+class id_bitset_t {
+private:
+    std::vector<uint64_t> words;
+    uint32_t num_ids = 0;
+
+public:
+    id_bitset_t() = default;
+
+    /// `ids` must be sorted.
+    id_bitset_t(const uint32_t* ids, uint32_t ids_length);
+
+    /// Returns true when a set of `ids_length` ids whose largest id is `max_id` takes less memory as a bitset than as
+    /// an array by at least the given ratio.
+    static bool is_dense(uint32_t ids_length, uint32_t max_id, uint32_t min_ids_length, uint32_t ratio);
+
+    [[nodiscard]] bool contains(const uint32_t id) const {
+        const size_t word_index = id >> 6;
+        return word_index < words.size() && ((words[word_index] >> (id & 63)) & 1) != 0;
+    }
+
+    /// Returns the smallest id in the set that is not smaller than `id`, or UINT32_MAX when there is none.
+    [[nodiscard]] uint32_t next(uint32_t id) const;
+
+    /// Copies the ids of the set into a new array, in ascending order. Returns the number of ids.
+    uint32_t to_ids(uint32_t*& ids) const;
+
+    /// Same as `to_ids`, but only copies up to `n` ids that are not smaller than `id`.
+    uint32_t to_ids(uint32_t id, uint32_t n, std::vector<uint32_t>& ids) const;
+
+    /// Copies the ids of `A` that are in the set into a new array. Returns the number of ids.
+    uint32_t and_scalar(const uint32_t* A, uint32_t lenA, uint32_t*& results) const;
+
+    static void and_bitsets(const id_bitset_t& a, const id_bitset_t& b, id_bitset_t& result);
+
+    static void or_bitsets(const id_bitset_t& a, const id_bitset_t& b, id_bitset_t& result);
+
+    [[nodiscard]] uint32_t size() const {
+        return num_ids;
+    }
+
+    /// Largest id of the set, or 0 when the set is empty.
+    [[nodiscard]] uint32_t last_id() const;
+
+    [[nodiscard]] size_t num_bytes() const {
+        return words.size() * sizeof(uint64_t);
+    }
+};
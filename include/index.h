@@ -21,7 +21,7 @@
 #include "match_score.h"
 #include "posting_list.h"
 #include "threadpool.h"
-#include "adi_tree.h"
+#include "string_sort_column.h"
 #include "tsl/htrie_set.h"
 #include <tsl/htrie_map.h>
 #include <or_iterator.h>
@@ -33,8 +33,14 @@
 #include "filter.h"
 #include "facet_index.h"
 #include "numeric_range_trie.h"
+#include "numeric_histogram.h"
+#include "float_column.h"
+#include "min_max_column.h"
+#include "filtered_facet_counts.h"
 #include "geopolygon_index.h"
 #include "join.h"
+#include "filter_result_cache.h"
+#include "filter_profile.h"
 
 
 static constexpr size_t ARRAY_FACET_DIM = 4;
@@ -132,6 +138,7 @@ enum facet_index_type_t {
     exhaustive,
     top_values,
     automatic,
+    sketch,
 };
 
 struct search_args {
@@ -204,6 +211,17 @@ struct search_args {
     size_t found_docs = 0;
     Collection const *const collection;
 
+    // when set, the plan chosen for the filter tree is described in `filter_plan`
+    bool explain = false;
+    nlohmann::json filter_plan;
+
+    // when set, the cost of each clause of the filter tree is recorded in `filter_profile`
+    bool profile_filter_by = false;
+    filter_profile_t filter_profile;
+
+    // set when the filter timed out, so the number of documents it matches is not known
+    bool filter_search_cutoff = false;
+
     diversity_t diversity{};
 
     search_args(std::vector<query_tokens_t> field_query_tokens, std::vector<search_field_t> search_fields,
@@ -348,7 +366,12 @@ public:
             return true;
         }
 
-        filter_result_iterator->reset();
+        // The iterator only moves forward, so it's rewound only when an id before its position is probed. Probing a
+        // lazily evaluated filter this way doesn't materialize its ids.
+        if(filter_result_iterator->validity != filter_result_iterator_t::valid || id < filter_result_iterator->seq_id) {
+            filter_result_iterator->reset();
+        }
+
         return filter_result_iterator->is_valid(id) == 1;
     }
 };
@@ -395,6 +418,12 @@ struct group_by_field_it_t {
     bool is_string;
 };
 
+// Static filter registered on a collection, along with the facet counts of the documents matching it.
+struct facet_count_filter_t {
+    std::unique_ptr<filter_node_t> filter_tree_root;
+    filtered_facet_counts_t counts;
+};
+
 #ifdef TEST_BUILD
     extern bool testing_not_equals_bug;
 #endif
@@ -431,20 +460,35 @@ private:
 
     spp::sparse_hash_map<std::string, NumericTrie*> geo_range_index;
 
+    // numeric_field => value distribution, used to estimate the selectivity of filters
+    spp::sparse_hash_map<std::string, numeric_histogram_t*> numeric_histogram_index;
+
+    // single valued float_field => (seq_id => raw value)
+    spp::sparse_hash_map<std::string, float_column_t*> float_column_index;
+
+    // numeric_array_field => (seq_id => smallest and largest value), used for sorting and range pre-checks
+    spp::sparse_hash_map<std::string, min_max_column_t*> min_max_index;
+
     spp::sparse_hash_map<std::string, GeoPolygonIndex*> field_geopolygon_index;
 
     // geo_array_field => (seq_id => values) used for exact filtering of geo array records
     spp::sparse_hash_map<std::string, spp::sparse_hash_map<uint32_t, int64_t*>*> geo_array_index;
 
     facet_index_t* facet_index_v4 = nullptr;
+
+    // filter_by => facet counts of the documents matching the filter, maintained as documents are indexed and removed
+    std::map<std::string, facet_count_filter_t*> facet_count_filters;
+
+    // normalized filter subtree => matching ids, invalidated by writes to the fields of the subtree
+    mutable filter_result_cache_t filter_result_cache;
   
     // sort_field => (seq_id => value)
     spp::sparse_hash_map<std::string, spp::sparse_hash_map<uint32_t, int64_t, Hasher32>*> sort_index;
     typedef spp::sparse_hash_map<std::string, 
         spp::sparse_hash_map<uint32_t, int64_t, Hasher32>*>::iterator sort_index_iterator;
 
-    // str_sort_field => adi_tree_t
-    spp::sparse_hash_map<std::string, adi_tree_t*> str_sort_index;
+    // str_sort_field => string_sort_column_t
+    spp::sparse_hash_map<std::string, string_sort_column_t*> str_sort_index;
 
     // infix field => value
     spp::sparse_hash_map<std::string, array_mapped_infix_t> infix_index;
@@ -470,6 +514,7 @@ private:
     static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> eval_sentinel_value;
     static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> geo_sentinel_value;
     static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> str_sentinel_value;
+    static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> num_array_sentinel_value;
     static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> vector_distance_sentinel_value;
     static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> vector_query_sentinel_value;
     static spp::sparse_hash_map<uint32_t, int64_t, Hasher32> union_search_index_sentinel_value;
@@ -504,6 +549,51 @@ private:
                    Collection const *const collection,
                    std::unordered_map<std::string, reference_filter_result_t>* reference_facet_ids) const;
 
+    /// Splits the filter tree into its top-level `&&` clauses.
+    static void get_filter_and_clauses(const filter_node_t* filter_node, std::vector<const filter_node_t*>& clauses);
+
+    /// Returns the field that every leaf of the clause filters on, or an empty string when the leaves differ or the
+    /// clause has a reference or an object filter.
+    static std::string get_filter_clause_field(const filter_node_t* filter_node);
+
+    /// Computes the results that each disjunctive facet is counted against: the results of the query with only the
+    /// filter clauses on other fields applied. Every clause is evaluated once and the query is run once more, with
+    /// only the clauses shared by all the facets, unless it is a wildcard query. Facets are left to be counted
+    /// against the results of the query when the clauses cannot be evaluated on their own.
+    Option<bool> compute_disjunctive_facet_ids(search_args* search_params, const filter_node_t* filter_root) const;
+
+    void do_disjunctive_facets(std::vector<facet>& facets, const facet_query_t& facet_query,
+                               size_t facet_query_num_typos, bool estimate_facets, size_t facet_sample_percent,
+                               size_t group_limit, const std::vector<std::string>& group_by_fields,
+                               bool group_missing_values, int max_facet_values, size_t max_candidates,
+                               const std::vector<facet_index_type_t>& facet_index_types,
+                               bool is_group_by_first_pass, std::set<uint32_t>& group_by_missing_value_ids,
+                               Collection const *const collection, filter_result_iterator_t& filter_result_iterator,
+                               const uint32_t* excluded_result_ids, size_t excluded_result_ids_size) const;
+
+    void count_facet_values(filtered_facet_counts_t& counts, uint32_t seq_id, bool is_removal) const;
+
+    void add_to_facet_count_filters(const std::vector<index_record>& iter_batch);
+
+    void remove_from_facet_count_filters(uint32_t seq_id);
+
+    const facet_count_filter_t* get_facet_count_filter(const filter_result_iterator_t* filter_result_iterator,
+                                                       size_t num_result_ids) const;
+
+    void fill_dense_facet_counts(facet& a_facet, const facet_info_t& facet_info,
+                                 const facet_forward_index_t* forward_index, const std::vector<uint32_t>& counts,
+                                 const uint32_t* result_ids, size_t results_size, size_t stride) const;
+
+    /// Computes the stats of a float field from its column. Returns false when the field has no column.
+    bool compute_float_facet_stats(facet& a_facet, const std::string& field_name,
+                                   const uint32_t* result_ids, size_t results_size) const;
+
+    /// Counts the results of each range of a range facet, along with the field's stats, from the field's column or
+    /// from the id lists of its distinct values. Returns false when neither is cheaper than reading the value of each
+    /// result from the sort index.
+    bool compute_range_facet_counts(facet& a_facet, const field& facet_field, bool should_compute_stats,
+                                    const uint32_t* result_ids, size_t results_size) const;
+
     bool static_filter_query_eval(const curation_t* curation, const std::string& curation_normalized_query, std::vector<std::string>& tokens,
                                   std::unique_ptr<filter_node_t>& filter_tree_root, const bool& validate_field_names) const;
 
@@ -597,6 +687,13 @@ private:
 
     static void compute_facet_stats(facet &a_facet, const int64_t raw_value, const std::string & field_type);
 
+    /// Adds the ancestor paths of the values of a hierarchical facet field to the facet values of the document, so
+    /// that counting the document once per value also counts it once for every ancestor.
+    static void add_hierarchy_ancestors(const field& afield, uint32_t seq_id,
+                                        std::unordered_map<facet_value_id_t, std::vector<uint32_t>,
+                                                           facet_value_id_t::Hash>& fvalue_to_seq_ids,
+                                        std::unordered_map<uint32_t, std::vector<facet_value_id_t>>& seq_id_to_fvalues);
+
     static void handle_doc_ops(const tsl::htrie_map<char, field>& search_schema,
                                nlohmann::json& update_doc, const nlohmann::json& old_doc);
 
@@ -620,6 +717,10 @@ private:
                                    const tsl::htrie_map<char, field> & search_schema, const size_t remote_embedding_batch_size = 200,
                                    const size_t remote_embedding_timeout_ms = 60000, const size_t remote_embedding_num_tries = 2);
 
+    /// Sets the values of the derived fields of the record from the values of their source fields.
+    static void compute_derived_fields(const std::vector<std::pair<std::string, sort_by>>& derived_fields,
+                                       index_record& record);
+
     Option<bool> get_related_ids(const std::string& reference_helper_field_name,
                                  const uint32_t& seq_id, std::vector<uint32_t>& result) const;
 
@@ -678,6 +779,18 @@ public:
 
     enum {DEFAULT_TOPSTER_SIZE = 250};
 
+    // counters of the space saving sketch of a facet with the `sketch` strategy
+    enum {FACET_SKETCH_MIN_COUNTERS = 256};
+    enum {FACET_SKETCH_COUNTERS_PER_VALUE = 16};
+
+    // range facets of an integer field are counted off its distinct values' id lists when there are at least this
+    // many results per distinct value
+    enum {RANGE_FACET_MIN_RESULTS_PER_VALUE = 8};
+
+    // a filter whose approximate count is within this factor of the flat search cutoff is computed for its exact
+    // count before a wildcard vector search decides between a flat search and HNSW
+    enum {FLAT_SEARCH_ESTIMATE_FACTOR = 4};
+
     Index() = delete;
 
     Index(const std::string& name,
@@ -714,6 +827,8 @@ public:
 
     const spp::sparse_hash_map<std::string, NumericTrie*>& _get_range_index() const;
 
+    const spp::sparse_hash_map<std::string, numeric_histogram_t*>& _get_numeric_histogram_index() const;
+
     const spp::sparse_hash_map<std::string, array_mapped_infix_t>& _get_infix_index() const;
 
     const spp::sparse_hash_map<std::string, hnsw_index_t*>& _get_vector_index() const;
@@ -796,7 +911,8 @@ public:
                 std::set<uint32_t>& group_by_missing_value_ids,
                 Collection const *const collection,
                const std::vector<std::string>& synonym_sets,
-               const diversity_t& diversity) const;
+               const diversity_t& diversity,
+               std::vector<uint32_t>* result_ids = nullptr) const;
 
     void remove_field(uint32_t seq_id, nlohmann::json& document, const std::string& field_name,
                       const bool is_update);
@@ -866,6 +982,12 @@ public:
 
     void refresh_schemas(const std::vector<field>& new_fields, const std::vector<field>& del_fields);
 
+    /// Registers a static filter whose facet counts are maintained as documents are indexed and removed. Takes
+    /// ownership of the filter tree.
+    Option<bool> add_facet_count_filter(const std::string& filter_query, filter_node_t* filter_tree_root);
+
+    void remove_facet_count_filter(const std::string& filter_query);
+
     // the following methods are not synchronized because their parent calls are synchronized or they are const/static
 
     Option<bool> search_wildcard(const std::vector<sort_by>& sort_fields, Topster<KV>*& topster,
@@ -1188,6 +1310,9 @@ public:
 
     float compute_decay_function_score(const sort_by& sort_field, uint32_t seq_id) const;
 
+    /// Computes the decay function of `sort_field` for the given value of the field.
+    static float decay_function_score(const sort_by& sort_field, int64_t val);
+
     void get_field_token_its(const size_t num_search_fields, std::vector<art_leaf*>& query_suggestion,
                              std::vector<or_iterator_t>& token_its, std::vector<posting_list_t*>& expanded_plists,
                              const std::vector<token_t>& query_tokens,
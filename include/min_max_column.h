@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Smallest and largest value of each document of a numeric array field, stored densely by seq_id.
+///
+/// Values are the int64 keys used by the numeric indices (floats are encoded with `Index::float_to_int64_t`), so a
+/// document's values all lie within [min, max] in the same order that the filters compare them in.
+class min_max_column_t {
+private:
+    std::vector<int64_t> mins;
+    std::vector<int64_t> maxs;
+
+    size_t num_values = 0;
+
+public:
+    enum range_match_t {
+        no_match,
+        match,
+        maybe_match
+    };
+
+    /// Widens the bounds of the document to include the value.
+    void insert(uint32_t seq_id, int64_t value);
+
+    void remove(uint32_t seq_id);
+
+    [[nodiscard]] bool contains(uint32_t seq_id) const;
+
+    /// Returns false when the document has no value.
+    bool get(uint32_t seq_id, int64_t& min, int64_t& max) const;
+
+    /// Checks whether any value of the document can lie within [start, end] from the bounds alone. The bounds are
+    /// values of the document, so either of them lying within the range is a match, while a range that lies entirely
+    /// between the bounds needs the document's values to be checked.
+    [[nodiscard]] range_match_t match_range(uint32_t seq_id, int64_t start, int64_t end) const;
+
+    [[nodiscard]] size_t size() const {
+        return num_values;
+    }
+};
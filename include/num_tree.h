@@ -61,6 +61,11 @@ public:
 
     std::pair<int64_t, int64_t> get_min_max(const uint32_t* result_ids, size_t result_ids_len);
 
+    /// Appends, in ascending order of value, every value held by any of the result ids along with the number of
+    /// result ids holding it.
+    void get_value_counts(const uint32_t* result_ids, size_t result_ids_len,
+                          std::vector<std::pair<int64_t, size_t>>& value_counts);
+
     class iterator_t {
         /// If true, `id_list_array` is initialized otherwise `id_list_iterator` is.
         bool is_compact_id_list = true;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Equi-depth histogram over the (int64 encoded) values of a numeric field, used to estimate filter selectivity.
+class numeric_histogram_t {
+private:
+    struct bucket_t {
+        int64_t lower;
+        int64_t upper;
+        uint32_t count;
+    };
+
+    std::vector<bucket_t> buckets;
+
+    size_t max_buckets;
+
+    uint32_t total = 0;
+
+    /// Index of the first bucket whose upper bound is >= value.
+    [[nodiscard]] size_t find_bucket(const int64_t& value) const;
+
+    void split_bucket(const size_t& index);
+
+    void merge_smallest_pair();
+
+    [[nodiscard]] uint32_t target_depth() const;
+
+public:
+
+    static constexpr size_t DEFAULT_MAX_BUCKETS = 64;
+    static constexpr uint32_t MIN_BUCKET_DEPTH = 8;
+
+    explicit numeric_histogram_t(size_t max_buckets = DEFAULT_MAX_BUCKETS);
+
+    void insert(const int64_t& value);
+
+    void remove(const int64_t& value);
+
+    /// Estimated number of values that fall within [start, end].
+    [[nodiscard]] uint32_t approx_range_count(const int64_t& start, const int64_t& end) const;
+
+    /// Estimated number of values equal to `value`.
+    [[nodiscard]] uint32_t approx_equals_count(const int64_t& value) const {
+        return approx_range_count(value, value);
+    }
+
+    [[nodiscard]] uint32_t size() const {
+        return total;
+    }
+
+    [[nodiscard]] size_t num_buckets() const {
+        return buckets.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return total == 0;
+    }
+
+    /// Lower bound of the indexed values. Exact until values are removed, approximate thereafter.
+    [[nodiscard]] int64_t min() const {
+        return buckets.empty() ? 0 : buckets.front().lower;
+    }
+
+    /// Upper bound of the indexed values. Exact until values are removed, approximate thereafter.
+    [[nodiscard]] int64_t max() const {
+        return buckets.empty() ? 0 : buckets.back().upper;
+    }
+};
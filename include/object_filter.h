@@ -0,0 +1,46 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include "json.hpp"
+#include "option.h"
+#include "tsl/htrie_map.h"
+
+struct field;
+struct filter_node_t;
+
+/// Filter tree of an object filter, e.g. `ingredients{name: cheese && concentration: >50}`, compiled into a tree of
+/// closures that is evaluated against the objects of an object array.
+///
+/// Filter values are parsed into their typed form and the key of every field is resolved once at compile time, so
+/// that validating an object only reads the typed value at that key and compares it. When the value of the key is an
+/// array, the object matches when any of its elements does (none of them for `!=`).
+class object_filter_t {
+public:
+    typedef std::function<bool(const nlohmann::json& object)> predicate_t;
+
+private:
+    predicate_t predicate;
+
+    static Option<predicate_t> compile_node(const tsl::htrie_map<char, field>& search_schema,
+                                            const filter_node_t* filter_node);
+
+    static Option<predicate_t> compile_leaf(const tsl::htrie_map<char, field>& search_schema,
+                                            const filter_node_t* filter_node);
+
+public:
+    static Option<bool> compile(const tsl::htrie_map<char, field>& search_schema, const filter_node_t* filter_node,
+                                object_filter_t& object_filter);
+
+    [[nodiscard]] bool is_compiled() const {
+        return predicate != nullptr;
+    }
+
+    [[nodiscard]] bool matches(const nlohmann::json& object) const {
+        return predicate(object);
+    }
+
+    /// Returns the value at the dot separated path, e.g. `a.b` of `{"a": {"b": [...]}}`, or nullptr when the path does
+    /// not exist in the document.
+    static const nlohmann::json* get_path(const nlohmann::json& document, const std::string& path);
+};
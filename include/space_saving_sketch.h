@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "sparsepp.h"
+
+/// Space-Saving summary (Metwally et al., 2005) of the most frequent items of a stream.
+///
+/// At most `capacity` items are monitored. When an unmonitored item arrives on a full summary, it replaces the item
+/// with the smallest count and inherits that count as its error. The count of a monitored item is therefore an upper
+/// bound of its true frequency, and `count - error` a lower bound. Any item that is not monitored occurs at most
+/// `max_unmonitored_count()` times. Summaries of disjoint streams are combined with `merge()` (Agarwal et al., 2012).
+class space_saving_sketch_t {
+public:
+    struct counter_t {
+        uint32_t item = 0;
+        uint32_t count = 0;
+        uint32_t error = 0;
+
+        // last document in which the item was seen, and the position of the item in that document's value
+        uint32_t doc_id = 0;
+        uint32_t array_pos = 0;
+    };
+
+private:
+    size_t max_counters = 0;
+
+    // min-heap of the counters on their count
+    std::vector<counter_t> counters;
+
+    spp::sparse_hash_map<uint32_t, uint32_t> item_heap_positions;
+
+    // upper bound of the frequency of items dropped while merging summaries
+    uint32_t dropped_count_bound = 0;
+
+    void sift_down(size_t pos);
+
+    void swap_counters(size_t a, size_t b);
+
+    void build_heap();
+
+public:
+    explicit space_saving_sketch_t(size_t capacity = 0): max_counters(capacity) {}
+
+    void update(uint32_t item, uint32_t doc_id, uint32_t array_pos);
+
+    /// Combines the summary of a disjoint stream into this one. An empty summary takes the other's capacity.
+    void merge(const space_saving_sketch_t& other);
+
+    [[nodiscard]] size_t capacity() const {
+        return max_counters;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return counters.size();
+    }
+
+    [[nodiscard]] uint32_t max_unmonitored_count() const;
+
+    /// Counters in no particular order.
+    [[nodiscard]] const std::vector<counter_t>& get_counters() const {
+        return counters;
+    }
+};
@@ -89,6 +89,9 @@ public:
 
     StoreStatus get(const std::string& key, std::string& value) const;
 
+    // Looks up all the keys in a single batch. Values and statuses are in the order of the keys.
+    std::vector<StoreStatus> multi_get(const std::vector<std::string>& keys, std::vector<std::string>& values) const;
+
     bool remove(const std::string& key);
 
     rocksdb::Iterator* scan(const std::string & prefix, const rocksdb::Slice* iterate_upper_bound);
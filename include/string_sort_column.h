@@ -0,0 +1,80 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include "sparsepp.h"
+
+/// Order preserving, dictionary encoded column of the values of a string sort field.
+///
+/// Distinct values are stored once in a sorted dictionary and the dictionary position of every document's value is
+/// stored densely by seq_id, so the rank of a document is an array read. Values that are not part of the dictionary yet
+/// are kept in a small ordered delta whose entries are labelled to fit between the ranks of their dictionary neighbours.
+/// The delta is merged into the dictionary once it grows beyond a fraction of the dictionary's size.
+///
+/// Values are ordered the same way as `adi_tree_t`: byte-wise on `char` with the end of a value acting as '\0'.
+class string_sort_column_t {
+private:
+    struct value_comparator_t {
+        bool operator()(const std::string& a, const std::string& b) const;
+    };
+
+    struct delta_value_t {
+        // position of the value's successor in the dictionary
+        uint32_t gap;
+        // order of the value among the delta values sharing the same gap
+        uint32_t label;
+        uint32_t count;
+    };
+
+    typedef std::map<std::string, delta_value_t, value_comparator_t> delta_map_t;
+
+    static constexpr uint32_t EMPTY_CODE = UINT32_MAX;
+    static constexpr uint32_t DELTA_CODE = UINT32_MAX - 1;
+
+    static constexpr size_t LABEL_BITS = 30;
+    static constexpr uint64_t LABEL_SPACE = uint64_t(1) << LABEL_BITS;
+
+    std::vector<std::string> dictionary;
+    std::vector<uint32_t> dictionary_counts;
+    size_t num_unused_values = 0;
+
+    // seq_id => position of the value in dictionary / DELTA_CODE / EMPTY_CODE
+    std::vector<uint32_t> codes;
+
+    delta_map_t delta_values;
+    spp::sparse_hash_map<uint32_t, delta_map_t::iterator> delta_ids;
+
+    size_t delta_limit = MIN_DELTA_LIMIT;
+    uint64_t label_stride = 0;
+
+    void assign_label(const delta_map_t::iterator& it);
+
+    void relabel_gap(const delta_map_t::iterator& it);
+
+    void reset_limits();
+
+public:
+    static constexpr int64_t NOT_FOUND = INT64_MAX;
+    static constexpr size_t MIN_DELTA_LIMIT = 1024;
+
+    string_sort_column_t();
+
+    void index(uint32_t id, const std::string& value);
+
+    /// Returns a value that orders the documents by their string value or `NOT_FOUND` when the document has no value.
+    [[nodiscard]] int64_t rank(uint32_t id) const;
+
+    void remove(uint32_t id);
+
+    /// Merges the delta into the dictionary and drops the values that are no longer used by any document.
+    void compact();
+
+    [[nodiscard]] size_t num_dictionary_values() const {
+        return dictionary.size();
+    }
+
+    [[nodiscard]] size_t num_delta_values() const {
+        return delta_values.size();
+    }
+};
@@ -89,6 +89,14 @@ private:
   
     uint32_t max_group_limit;
 
+    uint32_t facet_min_partition_size;
+
+    uint32_t filter_continuation_timeout_ms;
+
+    uint32_t filter_cache_size_mb;
+
+    uint32_t filter_tree_cache_num_entries;
+
     uint32_t db_write_buffer_size;
 
     uint32_t db_max_write_buffer_number;
@@ -140,6 +148,14 @@ protected:
         
         this->max_group_limit = 99;
 
+        this->facet_min_partition_size = 4096;
+
+        this->filter_continuation_timeout_ms = 0;
+
+        this->filter_cache_size_mb = 16;
+
+        this->filter_tree_cache_num_entries = 100;
+
         //for rocksdb
         this->db_write_buffer_size = 4*1048576;
 
@@ -301,6 +317,22 @@ public:
         this->max_group_limit = max_group_limit;
     }
 
+    void set_facet_min_partition_size(uint32_t facet_min_partition_size) {
+        this->facet_min_partition_size = facet_min_partition_size;
+    }
+
+    void set_filter_continuation_timeout_ms(uint32_t filter_continuation_timeout_ms) {
+        this->filter_continuation_timeout_ms = filter_continuation_timeout_ms;
+    }
+
+    void set_filter_cache_size_mb(uint32_t filter_cache_size_mb) {
+        this->filter_cache_size_mb = filter_cache_size_mb;
+    }
+
+    void set_filter_tree_cache_num_entries(uint32_t filter_tree_cache_num_entries) {
+        this->filter_tree_cache_num_entries = filter_tree_cache_num_entries;
+    }
+
     // getters
 
     std::string get_data_dir() const {
@@ -499,6 +531,22 @@ public:
         return this->max_group_limit;
     }
 
+    uint32_t get_facet_min_partition_size() const {
+        return this->facet_min_partition_size;
+    }
+
+    uint32_t get_filter_continuation_timeout_ms() const {
+        return this->filter_continuation_timeout_ms;
+    }
+
+    uint32_t get_filter_cache_size_mb() const {
+        return this->filter_cache_size_mb;
+    }
+
+    uint32_t get_filter_tree_cache_num_entries() const {
+        return this->filter_tree_cache_num_entries;
+    }
+
     uint32_t get_db_write_buffer_size() const {
         return this->db_write_buffer_size;
     }
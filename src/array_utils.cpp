@@ -1,5 +1,7 @@
 #include "array_utils.h"
 #include <memory.h>
+#include <algorithm>
+#include <functional>
 
 size_t ArrayUtils::and_scalar(const uint32_t *A, const size_t lenA,
                               const uint32_t *B, const size_t lenB, uint32_t **results) {
@@ -102,6 +104,49 @@ size_t ArrayUtils::or_scalar(const uint32_t *A, const size_t lenA,
   return res_index;
 }
 
+// merges sorted arrays using a min-heap of their heads and also removes duplicates
+size_t ArrayUtils::or_sorted_runs(const std::vector<std::vector<uint32_t>>& runs, uint32_t **results) {
+  size_t total_len = 0;
+  std::vector<std::pair<uint32_t, size_t>> heads;
+  std::vector<size_t> positions(runs.size(), 0);
+
+  for(size_t i = 0; i < runs.size(); i++) {
+    if(!runs[i].empty()) {
+      total_len += runs[i].size();
+      heads.emplace_back(runs[i][0], i);
+    }
+  }
+
+  if(total_len == 0) {
+    return 0;
+  }
+
+  *results = new uint32_t[total_len];
+  uint32_t *out = *results;
+  size_t res_index = 0;
+
+  std::make_heap(heads.begin(), heads.end(), std::greater<>());
+
+  while(!heads.empty()) {
+    std::pop_heap(heads.begin(), heads.end(), std::greater<>());
+    auto& head = heads.back();
+
+    if(res_index == 0 || out[res_index-1] != head.first) {
+      out[res_index++] = head.first;
+    }
+
+    const auto& run = runs[head.second];
+    if(++positions[head.second] < run.size()) {
+      head.first = run[positions[head.second]];
+      std::push_heap(heads.begin(), heads.end(), std::greater<>());
+    } else {
+      heads.pop_back();
+    }
+  }
+
+  return res_index;
+}
+
 size_t ArrayUtils::exclude_scalar(const uint32_t *A, const size_t lenA,
                                  const uint32_t *B, const size_t lenB, uint32_t **out) {
   size_t indexA = 0, indexB = 0, res_index = 0;
@@ -83,6 +83,7 @@ Collection::Collection(const std::string& name, const uint32_t collection_id, co
     this->alter_in_progress = false;
     this->altered_docs= 0;
     this->validated_docs= 0;
+    filter_tree_cache.set_max_entries(Config::get_instance().get_filter_tree_cache_num_entries());
 }
 
 Collection::~Collection() {
@@ -334,6 +335,10 @@ nlohmann::json Collection::get_summary_json() const {
     json_response["synonym_sets"] = synonym_sets;
     json_response["curation_sets"] = curation_sets;
 
+    if(!facet_count_filters.empty()) {
+        json_response["facet_count_filters"] = facet_count_filters;
+    }
+
     for(auto c: symbols_to_index) {
         json_response["symbols_to_index"].push_back(std::string(1, c));
     }
@@ -369,6 +374,14 @@ nlohmann::json Collection::get_summary_json() const {
             field_json[fields::range_index] = coll_field.range_index;
         }
 
+        if(coll_field.is_derived()) {
+            field_json[fields::expression] = coll_field.expression;
+        }
+
+        if(coll_field.is_hierarchical()) {
+            field_json[fields::hierarchy_separator] = coll_field.hierarchy_separator;
+        }
+
         // no need to sned hnsw_params for text fields
         if(coll_field.num_dim > 0) {
             field_json[fields::hnsw_params] = coll_field.hnsw_params;
@@ -599,6 +612,7 @@ nlohmann::json Collection::add_many(std::vector<std::string>& json_lines, nlohma
 
             if(found_new_field) {
                 index->refresh_schemas(new_fields, {});
+                filter_tree_cache.bump_schema_version();
             }
         }
 
@@ -781,6 +795,7 @@ void Collection::batch_index(std::vector<index_record>& index_records, std::vect
                     remove_document(index_record.doc, index_record.seq_id, false);
                     index_record.index_failure(500, "Could not write to on-disk storage.");
                 } else {
+                    filter_tree_cache.bump_doc_ids_epoch();
                     num_indexed++;
                     index_record.index_success();
                 }
@@ -1500,78 +1515,9 @@ Option<bool> Collection::validate_and_standardize_sort_fields(const std::vector<
                                                                                     sort_field_std.name.size() -
                                                                                     paran_start -
                                                                                     2);
-                    std::vector<std::string> value_params, param_parts;
-                    StringUtils::split(sort_params_str, value_params, ",");
-
-                    for(const auto& value_param : value_params) {
-                        param_parts.clear();
-                        StringUtils::split(value_param, param_parts, ":");
-
-                        if (param_parts.size() != 2) {
-                            return Option<bool>(400, error);
-                        }
-
-                        if(param_parts[0] == sort_field_const::func) {
-                            if(param_parts[1]!= sort_field_const::gauss && param_parts[1]!= sort_field_const::exp
-                               && param_parts[1]!= sort_field_const::linear && param_parts[1]!= sort_field_const::diff) {
-                                return Option<bool>(400, "Bad syntax. Not a valid decay function key `" + param_parts[1] + "`.");
-                            }
-                            auto action_op = magic_enum::enum_cast<sort_by::sort_by_params_t>(param_parts[1]);
-                            if(action_op.has_value()) {
-                                sort_field_std.sort_by_param = action_op.value();
-                            }
-                        } else if(param_parts[0] == sort_field_const::scale) {
-                            if (!StringUtils::is_integer(param_parts[1]) || param_parts[1] == "0") {
-                                return Option<bool>(400, "sort_by: scale param should be non-zero integer.");
-                            }
-                            sort_field_std.scale = std::stoll(param_parts[1]);
-                        } else if(param_parts[0] == sort_field_const::origin) {
-                            if (!StringUtils::is_integer(param_parts[1])) {
-                                return Option<bool>(400, "sort_by: origin param should be integer.");
-                            }
-                            sort_field_std.origin_val = std::stoll(param_parts[1]);
-                        } else if(param_parts[0] == sort_field_const::offset) {
-                            if (!StringUtils::is_integer(param_parts[1])) {
-                                return Option<bool>(400, "sort_by: offset param should be integer.");
-                            }
-                            sort_field_std.offset = std::stoll(param_parts[1]);
-                        } else if(param_parts[0] == sort_field_const::decay) {
-                            if (!StringUtils::is_float(param_parts[1])) {
-                                return Option<bool>(400, "sort_by: decay param should be float.");
-                            }
-                            auto val = std::stof(param_parts[1]);
-                            if(val < 0.0f || val > 1.0f) {
-                                return Option<bool>(400, "sort_by: decay param should be float in range [0.0, 1.0].");
-                            }
-                            sort_field_std.decay_val = val;
-                        } else {
-                            if (param_parts[0] != sort_field_const::missing_values) {
-                                return Option<bool>(400, error);
-                            }
-
-                            auto missing_values_op = magic_enum::enum_cast<sort_by::missing_values_t>(
-                                    param_parts[1]);
-                            if (missing_values_op.has_value()) {
-                                sort_field_std.missing_values = missing_values_op.value();
-                            } else {
-                                return Option<bool>(400, error);
-                            }
-                        }
-                    }
-
-                    if((sort_field_std.sort_by_param == sort_by::linear || sort_field_std.sort_by_param == sort_by::exp ||
-                        sort_field_std.sort_by_param == sort_by::gauss) && (sort_field_std.origin_val == INT64_MAX ||
-                        sort_field_std.scale == INT64_MAX)) {
-                            return Option<bool>(400, "Bad syntax. origin and scale are mandatory params for decay function "
-                                + std::string(magic_enum::enum_name(sort_field_std.sort_by_param)));
-
-                    } else if(sort_field_std.sort_by_param == sort_by::diff && sort_field_std.origin_val == INT64_MAX) {
-                            return Option<bool>(400, "Bad syntax. origin param is mandatory for diff function.");
-
-                    } else if(sort_field_std.sort_by_param != sort_by::linear && sort_field_std.sort_by_param != sort_by::exp &&
-                              sort_field_std.sort_by_param != sort_by::gauss && sort_field_std.sort_by_param != sort_by::diff &&
-                              sort_field_std.origin_val != INT64_MAX) {
-                            return Option<bool>(400, "Bad syntax. Missing param `func`.");
+                    auto parse_op = sort_field_std.parse_decay_function_params(sort_params_str, error);
+                    if(!parse_op.ok()) {
+                        return parse_op;
                     }
 
                 } else {
@@ -2337,8 +2283,9 @@ Option<bool> Collection::init_index_search_args(collection_search_args_t& coll_a
 
     const std::string doc_id_prefix = std::to_string(collection_id) + "_" + DOC_ID_PREFIX + "_";
     filter_node_t* filter_tree_root = nullptr;
-    Option<bool> parse_filter_op = filter::parse_filter_query(filter_query, search_schema,
-                                                              store, doc_id_prefix, filter_tree_root, validate_field_names);
+    Option<bool> parse_filter_op = filter_tree_cache.parse_filter_query(filter_query, search_schema,
+                                                                        store, doc_id_prefix, filter_tree_root,
+                                                                        validate_field_names);
     std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
 
     if(!parse_filter_op.ok()) {
@@ -2829,6 +2776,9 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
         return Option<nlohmann::json>(init_index_search_args_op.code(), init_index_search_args_op.error());
     }
 
+    search_params_guard->explain = coll_args.explain;
+    search_params_guard->profile_filter_by = coll_args.profile_filter_by;
+
     const auto search_op = index->run_search(search_params_guard.get());
     if (!search_op.ok()) {
         return Option<nlohmann::json>(search_op.code(), search_op.error());
@@ -3254,6 +3204,18 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
         std::nth_element(facet_counts.begin(), facet_counts.begin() + nthElement, facet_counts.end(),
                          Collection::facet_count_compare);
 
+        // a sketched value is certain to be among the top values when its lower bound is not below the upper bound of
+        // every value left out
+        uint32_t max_left_out_count = a_facet.count_error_bound;
+        if(a_facet.sketched) {
+            facet_result["sketched"] = true;
+            facet_result["count_error_bound"] = a_facet.count_error_bound;
+
+            if(max_facets < facet_counts.size()) {
+                max_left_out_count = std::max(max_left_out_count, facet_counts[max_facets].count);
+            }
+        }
+
         field the_field;
         std::shared_ptr<Collection> ref_collection;
         if (a_facet.reference_collection_name.empty()) {
@@ -3423,6 +3385,7 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
                 const auto& highlighted_text = highlight.snippets.empty() ? value : highlight.snippets[0];
                 facet_value_t facet_value = {value, highlighted_text, facet_count.count,
                                              facet_count.sort_field_val, parent};
+                facet_value.count_error = facet_count.count_error;
 
                 if(!a_facet.reference_collection_name.empty()) {
                     std::string facet_filter = "$" + a_facet.reference_collection_name + "(" + a_facet.field_name + ": ";
@@ -3473,6 +3436,11 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
             facet_value_count["highlighted"] = facet_count.highlighted;
             facet_value_count["count"] = facet_count.count;
 
+            if(a_facet.sketched) {
+                facet_value_count["count_error"] = facet_count.count_error;
+                facet_value_count["guaranteed"] = (facet_count.count - facet_count.count_error >= max_left_out_count);
+            }
+
             if(!facet_count.parent.empty()) {
                 facet_value_count["parent"] = facet_count.parent;
             }
@@ -3484,6 +3452,26 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
             facet_result["counts"].push_back(facet_value_count);
         }
 
+        if(the_field.is_hierarchical() && !a_facet.is_range_query) {
+            std::vector<std::pair<std::string, uint32_t>> value_counts;
+            value_counts.reserve(facet_counts.size());
+
+            for(const auto& facet_count: facet_counts) {
+                if(a_facet.is_intersected) {
+                    value_counts.emplace_back(facet_count.fvalue, facet_count.count);
+                } else if(ref_collection != nullptr) {
+                    value_counts.emplace_back(ref_collection->get_facet_str_val_with_lock(the_field.name,
+                                                                                          facet_count.fhash),
+                                              facet_count.count);
+                } else {
+                    value_counts.emplace_back(index->get_facet_str_val(the_field.name, facet_count.fhash),
+                                              facet_count.count);
+                }
+            }
+
+            facet_result["hierarchy"] = get_facet_hierarchy(the_field, value_counts, max_facet_values);
+        }
+
         // add facet value stats
         facet_result["stats"] = nlohmann::json::object();
         if(a_facet.stats.fvcount != 0) {
@@ -3493,12 +3481,73 @@ Option<nlohmann::json> Collection::search(collection_search_args_t& coll_args) c
             facet_result["stats"]["avg"] = (a_facet.stats.fvsum / a_facet.stats.fvcount);
         }
 
-        facet_result["stats"]["total_values"] = facet_counts.size();
+        facet_result["stats"]["total_values"] = (a_facet.num_filter_values != 0) ? a_facet.num_filter_values :
+                                                facet_counts.size();
         result["facet_counts"].push_back(facet_result);
     }
 
     result["search_cutoff"] = search_cutoff;
 
+    if(search_params->explain && !search_params->filter_plan.is_null()) {
+        result["explain"]["filter_by"] = search_params->filter_plan;
+    }
+
+    // the search may also have been cut off after the filter was evaluated, in which case its count is known
+    bool filter_search_cutoff = search_params->filter_search_cutoff;
+
+    if(search_params->profile_filter_by) {
+        // a clause that is iterated along with the search was not exhausted when the search was cut off
+        for(auto& clause: search_params->filter_profile.clauses) {
+            filter_search_cutoff = filter_search_cutoff || clause.search_cutoff;
+            clause.search_cutoff = clause.search_cutoff || (search_cutoff && !clause.is_materialized);
+        }
+
+        result["filter_profile"]["clauses"] = search_params->filter_profile.to_json();
+    }
+
+    if(coll_args.continue_filter_by && filter_search_cutoff && !coll_args.filter_query.empty()) {
+        // continuations are off by default, since writes to the collection wait while they are evaluated
+        const uint64_t continuation_timeout_ms = Config::get_instance().get_filter_continuation_timeout_ms();
+        if(continuation_timeout_ms == 0) {
+            result["filter_profile"]["continuation_error"] = "Filter continuations are disabled.";
+        } else {
+            auto evaluate = [collection_name = name, filter_query = coll_args.filter_query,
+                             continuation_timeout_ms]() -> Option<uint32_t> {
+                auto collection = CollectionManager::get_instance().get_collection(collection_name);
+                if(collection == nullptr) {
+                    return Option<uint32_t>(404, "Collection not found.");
+                }
+
+                search_stop_us = continuation_timeout_ms * 1000;
+                search_begin_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+
+                filter_result_t filter_result;
+                auto filter_op = collection->get_filter_ids(filter_query, filter_result, true);
+                if(!filter_op.ok()) {
+                    return Option<uint32_t>(filter_op.code(), filter_op.error());
+                }
+
+                const uint64_t time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count() - search_begin_us;
+                if(time_us >= search_stop_us) {
+                    return Option<uint32_t>(408, "Filter could not be evaluated within " +
+                                                 std::to_string(continuation_timeout_ms) + " ms.");
+                }
+
+                return Option<uint32_t>(filter_result.count);
+            };
+
+            auto add_op = CollectionManager::get_instance().get_filter_continuations()
+                                                           .add(name, coll_args.filter_query, evaluate);
+            if(add_op.ok()) {
+                result["filter_profile"]["continuation_id"] = add_op.get();
+            } else {
+                result["filter_profile"]["continuation_error"] = add_op.error();
+            }
+        }
+    }
+
     result["request_params"] = nlohmann::json::object();
     result["request_params"]["collection_name"] = name;
     result["request_params"]["per_page"] = per_page;
@@ -4867,6 +4916,67 @@ nlohmann::json Collection::get_parent_object(const nlohmann::json& parent, const
     return nlohmann::json();
 }
 
+nlohmann::json Collection::get_facet_hierarchy(const field& facet_field,
+                                               const std::vector<std::pair<std::string, uint32_t>>& value_counts,
+                                               const size_t max_children) {
+    std::unordered_map<std::string, size_t> value_indices;
+    for(size_t i = 0; i < value_counts.size(); i++) {
+        value_indices.emplace(value_counts[i].first, i);
+    }
+
+    // a value hangs off its closest ancestor that was counted, or off the root, which is node 0
+    std::vector<std::vector<size_t>> children(value_counts.size() + 1);
+    std::vector<std::string> ancestors;
+
+    for(size_t i = 0; i < value_counts.size(); i++) {
+        ancestors.clear();
+        facet_field.get_hierarchy_ancestors(value_counts[i].first, ancestors);
+
+        size_t parent = 0;
+        for(auto ancestor_it = ancestors.rbegin(); ancestor_it != ancestors.rend(); ++ancestor_it) {
+            const auto value_index_it = value_indices.find(*ancestor_it);
+            if(value_index_it != value_indices.end()) {
+                parent = value_index_it->second + 1;
+                break;
+            }
+        }
+
+        children[parent].push_back(i);
+    }
+
+    const auto& separator = facet_field.hierarchy_separator;
+
+    std::function<nlohmann::json(size_t)> get_children = [&](size_t node) {
+        auto& node_children = children[node];
+        const size_t num_children = std::min(max_children, node_children.size());
+
+        std::partial_sort(node_children.begin(), node_children.begin() + num_children, node_children.end(),
+                          [&value_counts](size_t a, size_t b) {
+            return std::tie(value_counts[b].second, value_counts[a].first) <
+                   std::tie(value_counts[a].second, value_counts[b].first);
+        });
+
+        nlohmann::json child_nodes = nlohmann::json::array();
+
+        for(size_t i = 0; i < num_children; i++) {
+            const auto& value = value_counts[node_children[i]].first;
+            const auto separator_pos = value.rfind(separator);
+
+            nlohmann::json child_node = nlohmann::json::object();
+            child_node["value"] = value;
+            child_node["label"] = (separator_pos == std::string::npos) ? value :
+                                  value.substr(separator_pos + separator.size());
+            child_node["count"] = value_counts[node_children[i]].second;
+            child_node["children"] = get_children(node_children[i] + 1);
+            child_nodes.push_back(child_node);
+        }
+
+        return child_nodes;
+    };
+
+    return get_children(0);
+}
+
 nlohmann::json Collection::get_facet_parent(const std::string& facet_field_name, const nlohmann::json& document,
                                             const std::string& val, bool is_array) const {
     std::vector<std::string> field_path;
@@ -5545,6 +5655,7 @@ void Collection::remove_document(nlohmann::json & document, const uint32_t seq_i
 
         store->remove(get_doc_id_key(id));
         store->remove(get_seq_id_key(seq_id));
+        filter_tree_cache.bump_doc_ids_epoch();
     }
 }
 
@@ -6135,6 +6246,7 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
     std::vector<field> new_fields;
     tsl::htrie_map<char, field> schema_additions;
     bool found_embedding_field = false;
+    bool found_derived_field = false;
     bool found_reference_field = false;
 
     std::unique_lock ulock(mutex);
@@ -6161,6 +6273,10 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
             found_reference_field = true;
         }
 
+        if(f.is_derived()) {
+            found_derived_field = true;
+        }
+
         if(f.embed.count(fields::from) != 0) {
             found_embedding_field = true;
             const auto& text_embedders = EmbedderManager::get_instance()._get_text_embedders();
@@ -6182,6 +6298,7 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
     std::shared_lock shlock(mutex);
 
     index->refresh_schemas(new_fields, {});
+    filter_tree_cache.bump_schema_version();
 
     // Now, we can index existing data onto the updated schema
     const std::string seq_id_prefix = get_seq_id_collection_prefix();
@@ -6242,7 +6359,7 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
                                       fallback_field_type, token_separators, symbols_to_index, true, 200, 60000, 2,
                                       found_embedding_field, true, schema_additions);
 
-            if(found_embedding_field) {
+            if(found_embedding_field || found_derived_field) {
                 for(auto& index_record : iter_batch) {
                     if(index_record.indexed.ok()) {
                         remove_flat_fields(index_record.doc);
@@ -6250,7 +6367,7 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
                         bool write_ok = store->insert(get_seq_id_key(index_record.seq_id), serialized_json);
 
                         if(!write_ok) {
-                            LOG(ERROR) << "Inserting doc with new embedding field failed for seq id: " << index_record.seq_id;
+                            LOG(ERROR) << "Inserting doc with new embedding or derived field failed for seq id: " << index_record.seq_id;
                             index_record.index_failure(500, "Could not write to on-disk storage.");
                         } else {
                             index_record.index_success();
@@ -6330,6 +6447,7 @@ Option<bool> Collection::batch_alter_data(const std::vector<field>& alter_fields
 
     index->refresh_schemas({}, del_fields);
     index->refresh_schemas({}, garbage_embedding_fields_vec);
+    filter_tree_cache.bump_schema_version();
 
     auto persist_op = persist_collection_meta();
     if(!persist_op.ok()) {
@@ -6820,6 +6938,14 @@ Option<bool> Collection::validate_alter_payload(nlohmann::json& schema_changes,
                     }
                 }
 
+                if(f.is_derived()) {
+                    auto validate_res = field::validate_derived_field(search_schema, schema_changes["fields"], f);
+
+                    if(!validate_res.ok()) {
+                        return validate_res;
+                    }
+                }
+
                 if(is_reindex) {
                     reindex_fields.push_back(f);
                 } else {
@@ -7321,6 +7447,7 @@ Option<bool> Collection::parse_facet_with_lock(const std::string& facet_field, s
 Option<bool> Collection::parse_facet(const std::string& facet_field, std::vector<facet>& facets) const {
     const std::string _alpha = "_alpha";
     bool top_k = false;
+    bool disjunctive = false;
     std::string facet_field_name, param_str;
     bool paran_open = false; //for (
     bool brace_open = false; //for [
@@ -7496,6 +7623,24 @@ Option<bool> Collection::parse_facet(const std::string& facet_field, std::vector
                     top_k = true;
                 }
                 facet_param_count++;
+            } else if (param_str == "disjunctive") { //disjunctive param
+                param_str.clear();
+                i++; //skip :
+                for (i; i < facet_field.size(); i++) {
+                    if (facet_field[i] == ',' || facet_field[i] == ')') {
+                        break;
+                    }
+                    param_str += facet_field[i];
+                }
+
+                if (param_str.empty() || (param_str != "true" && param_str != "false")) {
+                    return Option<bool>(400, "disjunctive string format is invalid.");
+                }
+
+                if (param_str == "true") {
+                    disjunctive = true;
+                }
+                facet_param_count++;
             } else if ((i + 1) < facet_field.size() && facet_field[i + 1] == '[') { //range params
                 const field& a_field = search_schema.at(facet_field_name);
                 if (tupVec.empty()) {
@@ -7623,11 +7768,13 @@ Option<bool> Collection::parse_facet(const std::string& facet_field, std::vector
         }
         a_facet.is_range_query = true;
         a_facet.is_top_k = top_k;
+        a_facet.is_disjunctive = disjunctive;
 
         facets.emplace_back(std::move(a_facet));
     } else if (!is_wildcard) { //add other facet types, wildcard facets are already added while parsing
         facets.emplace_back(facet(facet_field_name, facets.size(), top_k, {}, false, sort_alpha,
                                   order, sort_field));
+        facets.back().is_disjunctive = disjunctive;
     }
 
     return Option<bool>(true);
@@ -8467,6 +8614,9 @@ Option<bool> collection_search_args_t::init(std::map<std::string, std::string>&
     bool enable_analytics = true;
     bool rerank_hybrid_matches = false;
     bool validate_field_names = true;
+    bool explain = false;
+    bool profile_filter_by = false;
+    bool continue_filter_by = false;
 
     // personalization params
     std::string personalization_user_id;
@@ -8551,7 +8701,10 @@ Option<bool> collection_search_args_t::init(std::map<std::string, std::string>&
             {FILTER_CURATED_HITS, &filter_curated_hits_option},
             {ENABLE_ANALYTICS, &enable_analytics},
             {RERANK_HYBRID_MATCHES, &rerank_hybrid_matches},
-            {VALIDATE_FIELD_NAMES, &validate_field_names}
+            {VALIDATE_FIELD_NAMES, &validate_field_names},
+            {EXPLAIN, &explain},
+            {PROFILE_FILTER_BY, &profile_filter_by},
+            {CONTINUE_FILTER_BY, &continue_filter_by}
     };
 
     std::unordered_map<std::string, std::vector<std::string>*> str_list_values = {
@@ -8752,6 +8905,9 @@ Option<bool> collection_search_args_t::init(std::map<std::string, std::string>&
                                     personalization_user_id, personalization_model_id, personalization_type,
                                     personalization_user_field, personalization_item_field, personalization_event_name,
                                     personalization_n_events, synonym_sets, diversity_lamda);
+    args.explain = explain;
+    args.profile_filter_by = profile_filter_by;
+    args.continue_filter_by = continue_filter_by;
     return Option<bool>(true);
 }
 
@@ -8801,6 +8957,78 @@ std::vector<std::string> Collection::get_curation_sets() const {
     return curation_sets;
 }
 
+std::vector<std::string> Collection::get_facet_count_filters() const {
+    std::shared_lock lock(mutex);
+    return facet_count_filters;
+}
+
+static bool filter_has_references(const filter_node_t* filter_node) {
+    if(filter_node == nullptr) {
+        return false;
+    }
+
+    if(filter_node->isOperator) {
+        return filter_has_references(filter_node->left) || filter_has_references(filter_node->right);
+    }
+
+    return !filter_node->filter_exp.referenced_collection_name.empty();
+}
+
+Option<bool> Collection::update_facet_count_filters(const std::vector<std::string>& filter_queries) {
+    std::unique_lock lock(mutex);
+
+    const std::string doc_id_prefix = std::to_string(collection_id) + "_" + DOC_ID_PREFIX + "_";
+    std::vector<std::pair<std::string, std::unique_ptr<filter_node_t>>> filter_trees;
+
+    // all filters are validated before any of them is registered
+    for(auto filter_query: filter_queries) {
+        StringUtils::trim(filter_query);
+        if(filter_query.empty()) {
+            return Option<bool>(400, "`facet_count_filters` should be an array of non-empty filters.");
+        }
+
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> parse_filter_op = filter::parse_filter_query(filter_query, search_schema, store, doc_id_prefix,
+                                                                  filter_tree_root);
+        std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+        if(!parse_filter_op.ok()) {
+            return parse_filter_op;
+        }
+
+        if(filter_has_references(filter_tree_root)) {
+            return Option<bool>(400, "Filter `" + filter_query + "` of `facet_count_filters` can not refer to "
+                                     "other collections.");
+        }
+
+        filter_trees.emplace_back(filter_query, std::move(filter_tree_root_guard));
+    }
+
+    std::set<std::string> new_filter_queries;
+    for(const auto& filter_tree: filter_trees) {
+        new_filter_queries.insert(filter_tree.first);
+    }
+
+    for(const auto& filter_query: facet_count_filters) {
+        if(new_filter_queries.count(filter_query) == 0) {
+            index->remove_facet_count_filter(filter_query);
+        }
+    }
+
+    facet_count_filters.clear();
+
+    for(auto& filter_tree: filter_trees) {
+        auto add_op = index->add_facet_count_filter(filter_tree.first, filter_tree.second.release());
+        if(!add_op.ok()) {
+            return add_op;
+        }
+
+        facet_count_filters.push_back(filter_tree.first);
+    }
+
+    return Option<bool>(true);
+}
+
 Option<bool> Collection::set_synonym_sets(const std::vector<std::string>& synonym_sets) {
     SynonymIndexManager& synonym_manager = SynonymIndexManager::get_instance();
     for (const auto& synonym_set_name : synonym_sets) {
@@ -145,6 +145,14 @@ Collection* CollectionManager::init_collection(const nlohmann::json & collection
                 field_obj[fields::range_index], field_obj[fields::store], field_obj[fields::stem], field_obj[fields::stem_dictionary],
                 field_obj[fields::hnsw_params], field_obj[fields::async_reference], field_obj[fields::token_separators], field_obj[fields::symbols_to_index]);
 
+        if(field_obj.count(fields::expression) != 0) {
+            f.expression = field_obj[fields::expression].get<std::string>();
+        }
+
+        if(field_obj.count(fields::hierarchy_separator) != 0) {
+            f.hierarchy_separator = field_obj[fields::hierarchy_separator].get<std::string>();
+        }
+
         // value of `sort` depends on field type
         if(field_obj.count(fields::sort) == 0) {
             f.sort = f.is_num_sort_field();
@@ -278,6 +286,20 @@ Collection* CollectionManager::init_collection(const nlohmann::json & collection
         }
         collection->update_reference_field_with_lock(ref_field.first, it->second.referenced_field);
     }
+
+    if (collection_meta.count(Collection::COLLECTION_FACET_COUNT_FILTERS) != 0) {
+        if (!collection_meta[Collection::COLLECTION_FACET_COUNT_FILTERS].is_array()) {
+            LOG(ERROR) << "Parameter `facet_count_filters` must be an array.";
+        } else {
+            auto facet_count_filters = collection_meta[Collection::COLLECTION_FACET_COUNT_FILTERS].get<std::vector<std::string>>();
+            auto update_op = collection->update_facet_count_filters(facet_count_filters);
+            if (!update_op.ok()) {
+                LOG(ERROR) << "Error while registering facet count filters of collection " << this_collection_name
+                           << ": " << update_op.error();
+            }
+        }
+    }
+
     return collection;
 }
 
@@ -636,6 +658,9 @@ Option<bool> CollectionManager::load(const size_t collection_batch_size, const s
 
 
 void CollectionManager::dispose() {
+    // continuations look their collections up, so they are finished before the collections are dropped
+    filter_continuations.shutdown();
+
     std::unique_lock lock(mutex);
 
     auto referenced_ins_json = nlohmann::json::array();
@@ -1621,6 +1646,10 @@ Option<bool> CollectionManager::do_union(std::map<std::string, std::string>& req
     return Option<bool>(true);
 }
 
+filter_continuations_t& CollectionManager::get_filter_continuations() {
+    return filter_continuations;
+}
+
 ThreadPool* CollectionManager::get_thread_pool() const {
     return thread_pool;
 }
@@ -2466,5 +2495,33 @@ Option<bool> CollectionManager::update_collection_curation_sets(const std::strin
         return Option<bool>(true);
     }
 
+    return Option<bool>(400, "failed to insert into store.");
+}
+
+Option<bool> CollectionManager::update_collection_facet_count_filters(const std::string& collection,
+                                                                      const std::vector<std::string>& facet_count_filters) {
+    auto collection_ptr = get_collection(collection);
+    if (collection_ptr == nullptr) {
+        return Option<bool>(400, "failed to get collection.");
+    }
+
+    auto update_op = collection_ptr->update_facet_count_filters(facet_count_filters);
+    if (!update_op.ok()) {
+        return update_op;
+    }
+
+    std::string collection_meta_str;
+
+    auto collection_metakey = Collection::get_meta_key(collection);
+    store->get(collection_metakey, collection_meta_str);
+
+    auto collection_meta_json = nlohmann::json::parse(collection_meta_str);
+
+    collection_meta_json[Collection::COLLECTION_FACET_COUNT_FILTERS] = collection_ptr->get_facet_count_filters();
+
+    if(store->insert(collection_metakey, collection_meta_json.dump())) {
+        return Option<bool>(true);
+    }
+
     return Option<bool>(400, "failed to insert into store.");
 }
\ No newline at end of file
@@ -304,7 +304,7 @@ bool post_create_collection(const std::shared_ptr<http_req>& req, const std::sha
 
 bool patch_update_collection(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res) {
     nlohmann::json req_json;
-    std::set<std::string> allowed_keys = {"metadata", "fields", "synonym_sets", "curation_sets"};
+    std::set<std::string> allowed_keys = {"metadata", "fields", "synonym_sets", "curation_sets", "facet_count_filters"};
 
     // Ensures that only one alter can run per collection.
     // The actual check for this, happens in `ReplicationState::write` which is called only during live writes.
@@ -380,6 +380,28 @@ bool patch_update_collection(const std::shared_ptr<http_req>& req, const std::sh
         }
     }
 
+    if(req_json.contains("facet_count_filters")) {
+        if(!req_json["facet_count_filters"].is_array()) {
+            res->set_400("The `facet_count_filters` value should be an array.");
+            return false;
+        }
+
+        for(const auto& filter_query: req_json["facet_count_filters"]) {
+            if(!filter_query.is_string()) {
+                res->set_400("The `facet_count_filters` value should be an array of strings.");
+                return false;
+            }
+        }
+
+        auto facet_count_filters = req_json["facet_count_filters"].get<std::vector<std::string>>();
+        auto op = collectionManager.update_collection_facet_count_filters(req->params["collection"],
+                                                                          facet_count_filters);
+        if(!op.ok()) {
+            res->set(op.code(), op.error());
+            return false;
+        }
+    }
+
     if(req_json.contains("fields")) {
         nlohmann::json alter_payload;
         alter_payload["fields"] = req_json["fields"];
@@ -1329,6 +1351,33 @@ bool get_collection_summary(const std::shared_ptr<http_req>& req, const std::sha
     return true;
 }
 
+bool get_filter_continuation(const std::shared_ptr<http_req>& req, const std::shared_ptr<http_res>& res) {
+    CollectionManager& collectionManager = CollectionManager::get_instance();
+    auto collection = collectionManager.get_collection(req->params["collection"]);
+
+    if(collection == nullptr) {
+        res->set_404("Collection not found");
+        return false;
+    }
+
+    const std::string& id_str = req->params["id"];
+    if(!StringUtils::is_uint64_t(id_str)) {
+        res->set_400("Continuation id is invalid.");
+        return false;
+    }
+
+    nlohmann::json json_response;
+    if(!collectionManager.get_filter_continuations().get(collection->get_name(), std::stoull(id_str), json_response)) {
+        // continuations are kept in memory on the node that served the search
+        res->set_404("Continuation not found. Continuations can only be fetched from the node that served the "
+                     "search.");
+        return false;
+    }
+
+    res->set_200(json_response.dump());
+    return true;
+}
+
 Option<bool> populate_include_exclude(const std::shared_ptr<http_req>& req, std::shared_ptr<Collection>& collection,
                                       const std::string& filter_query,
                                       tsl::htrie_set<char>& include_fields, tsl::htrie_set<char>& exclude_fields,
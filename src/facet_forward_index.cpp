@@ -0,0 +1,197 @@
+#include "facet_forward_index.h"
+#include <algorithm>
+
+bool facet_forward_index_t::has_single(const uint32_t seq_id) const {
+    return seq_id / BLOCK_SIZE < single_present.size() &&
+           (single_present[seq_id / BLOCK_SIZE] >> (seq_id % BLOCK_SIZE)) & 1;
+}
+
+bool facet_forward_index_t::has_span(const uint32_t seq_id) const {
+    return seq_id < span_lengths.size() && span_lengths[seq_id] != 0;
+}
+
+bool facet_forward_index_t::contains(const uint32_t seq_id) const {
+    return has_single(seq_id) || has_span(seq_id);
+}
+
+uint32_t facet_forward_index_t::acquire_code(const uint32_t facet_id) {
+    auto it = facet_id_codes.find(facet_id);
+    if (it != facet_id_codes.end()) {
+        code_num_docs[it->second]++;
+        return it->second;
+    }
+
+    uint32_t code;
+    if (!free_codes.empty()) {
+        code = free_codes.back();
+        free_codes.pop_back();
+        code_facet_ids[code] = facet_id;
+        code_num_docs[code] = 1;
+    } else {
+        code = code_facet_ids.size();
+        code_facet_ids.push_back(facet_id);
+        code_num_docs.push_back(1);
+    }
+
+    facet_id_codes.emplace(facet_id, code);
+    return code;
+}
+
+void facet_forward_index_t::release_code(const uint32_t code) {
+    if (--code_num_docs[code] != 0) {
+        return;
+    }
+
+    facet_id_codes.erase(code_facet_ids[code]);
+    free_codes.push_back(code);
+}
+
+void facet_forward_index_t::upsert(const uint32_t seq_id, const std::vector<uint32_t>& facet_ids) {
+    erase(seq_id);
+
+    if (facet_ids.empty()) {
+        return;
+    }
+
+    // Distinct values are appended to the end of the span storage, where the span of the document starts. Arrays
+    // are short, so a linear scan for duplicates is cheaper than a set.
+    const size_t span_start = span_codes.size();
+
+    for (size_t i = 0; i < facet_ids.size(); i++) {
+        if (std::find(span_codes.begin() + span_start, span_codes.end(), facet_ids[i]) == span_codes.end()) {
+            span_codes.push_back(facet_ids[i]);
+            span_positions.push_back(i);
+        }
+    }
+
+    const size_t num_distinct = span_codes.size() - span_start;
+    for (size_t i = span_start; i < span_codes.size(); i++) {
+        span_codes[i] = acquire_code(span_codes[i]);
+    }
+
+    num_docs++;
+
+    if (num_distinct == 1) {
+        const auto code = span_codes[span_start];
+        span_codes.resize(span_start);
+        span_positions.resize(span_start);
+
+        if (seq_id >= single_codes.size()) {
+            const size_t num_blocks = (size_t(seq_id) / BLOCK_SIZE) + 1;
+            single_codes.resize(num_blocks * BLOCK_SIZE, 0);
+            single_present.resize(num_blocks, 0);
+        }
+
+        single_codes[seq_id] = code;
+        single_present[seq_id / BLOCK_SIZE] |= (uint64_t(1) << (seq_id % BLOCK_SIZE));
+        return;
+    }
+
+    if (seq_id >= span_lengths.size()) {
+        span_offsets.resize(seq_id + 1, 0);
+        span_lengths.resize(seq_id + 1, 0);
+    }
+
+    span_offsets[seq_id] = span_start;
+    span_lengths[seq_id] = num_distinct;
+}
+
+void facet_forward_index_t::erase(const uint32_t seq_id) {
+    if (has_single(seq_id)) {
+        single_present[seq_id / BLOCK_SIZE] &= ~(uint64_t(1) << (seq_id % BLOCK_SIZE));
+        release_code(single_codes[seq_id]);
+        num_docs--;
+        return;
+    }
+
+    if (!has_span(seq_id)) {
+        return;
+    }
+
+    const auto start = span_offsets[seq_id];
+    for (size_t i = start; i < start + span_lengths[seq_id]; i++) {
+        release_code(span_codes[i]);
+    }
+
+    num_dead_entries += span_lengths[seq_id];
+    span_lengths[seq_id] = 0;
+    num_docs--;
+
+    if (num_dead_entries > MIN_COMPACTION_SIZE && num_dead_entries > span_codes.size() / 2) {
+        compact();
+    }
+}
+
+void facet_forward_index_t::compact() {
+    std::vector<uint32_t> new_codes, new_positions;
+    new_codes.reserve(span_codes.size() - num_dead_entries);
+    new_positions.reserve(new_codes.capacity());
+
+    for (uint32_t seq_id = 0; seq_id < span_lengths.size(); seq_id++) {
+        if (span_lengths[seq_id] == 0) {
+            continue;
+        }
+
+        const auto start = span_offsets[seq_id];
+        span_offsets[seq_id] = new_codes.size();
+
+        new_codes.insert(new_codes.end(), span_codes.begin() + start,
+                         span_codes.begin() + start + span_lengths[seq_id]);
+        new_positions.insert(new_positions.end(), span_positions.begin() + start,
+                             span_positions.begin() + start + span_lengths[seq_id]);
+    }
+
+    span_codes = std::move(new_codes);
+    span_positions = std::move(new_positions);
+    num_dead_entries = 0;
+}
+
+size_t facet_forward_index_t::get(const uint32_t seq_id, const uint32_t*& codes, const uint32_t*& positions) const {
+    if (has_single(seq_id)) {
+        codes = single_codes.data() + seq_id;
+        positions = nullptr;
+        return 1;
+    }
+
+    if (!has_span(seq_id)) {
+        return 0;
+    }
+
+    codes = span_codes.data() + span_offsets[seq_id];
+    positions = span_positions.data() + span_offsets[seq_id];
+    return span_lengths[seq_id];
+}
+
+void facet_forward_index_t::count(const uint32_t* seq_ids, const size_t seq_ids_len, const size_t stride,
+                                  uint32_t* counts) const {
+    // Consecutive documents of a low cardinality field often share a value. Alternating between two histograms keeps
+    // the increments of the same counter by consecutive documents from stalling on each other; the second histogram
+    // is folded into `counts` at the end.
+    std::vector<uint32_t> alt_counts(num_codes(), 0);
+    uint32_t* const histograms[2] = {counts, alt_counts.data()};
+
+    auto count_doc = [&](const uint32_t seq_id, uint32_t* const histogram) {
+        if (has_single(seq_id)) {
+            histogram[single_codes[seq_id]]++;
+        } else if (has_span(seq_id)) {
+            const uint32_t* codes = span_codes.data() + span_offsets[seq_id];
+            for (uint32_t j = 0; j < span_lengths[seq_id]; j++) {
+                histogram[codes[j]]++;
+            }
+        }
+    };
+
+    size_t i = 0;
+    for (; i + stride < seq_ids_len; i += 2 * stride) {
+        count_doc(seq_ids[i], histograms[0]);
+        count_doc(seq_ids[i + stride], histograms[1]);
+    }
+
+    if (i < seq_ids_len) {
+        count_doc(seq_ids[i], histograms[0]);
+    }
+
+    for (size_t code = 0; code < alt_counts.size(); code++) {
+        counts[code] += alt_counts[code];
+    }
+}
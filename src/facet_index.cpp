@@ -2,6 +2,7 @@
 #include <tokenizer.h>
 #include "string_utils.h"
 #include "array_utils.h"
+#include <algorithm>
 
 void facet_index_t::initialize(const std::string& field) {
     const auto facet_field_map_it = facet_field_map.find(field);
@@ -11,6 +12,127 @@ void facet_index_t::initialize(const std::string& field) {
     }
 }
 
+void facet_index_t::initialize_token_index(const std::string& field_name, const bool tokenize_values,
+                                           const std::string& locale, const std::vector<char>& symbols_to_index,
+                                           const std::vector<char>& token_separators) {
+    const auto facet_field_map_it = facet_field_map.find(field_name);
+    if(facet_field_map_it == facet_field_map.end()) {
+        return;
+    }
+
+    auto& facet_index = facet_field_map_it->second;
+    facet_index.has_token_index = true;
+    facet_index.tokenize_values = tokenize_values;
+    facet_index.locale = locale;
+    facet_index.symbols_to_index = symbols_to_index;
+    facet_index.token_separators = token_separators;
+
+    facet_index.token_fids.clear();
+    for(const auto& kv: facet_index.fid_seq_ids) {
+        index_value_tokens(facet_index, kv.first, std::string(facet_index.fvalues.get(kv.first)));
+    }
+}
+
+void facet_index_t::get_value_tokens(const facet_doc_ids_list_t& facet_index, const std::string& fvalue,
+                                     std::vector<std::string>& tokens) {
+    if(!facet_index.tokenize_values) {
+        tokens.push_back(fvalue);
+        return;
+    }
+
+    Tokenizer(fvalue, true, false, facet_index.locale, facet_index.symbols_to_index,
+              facet_index.token_separators).tokenize(tokens);
+
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+}
+
+void facet_index_t::index_value_tokens(facet_doc_ids_list_t& facet_index, const uint32_t facet_id,
+                                       const std::string& fvalue) {
+    if(!facet_index.has_token_index) {
+        return;
+    }
+
+    std::vector<std::string> tokens;
+    get_value_tokens(facet_index, fvalue, tokens);
+
+    for(const auto& token: tokens) {
+        auto& fids = facet_index.token_fids[token];
+        const auto fid_it = std::lower_bound(fids.begin(), fids.end(), facet_id);
+        if(fid_it == fids.end() || *fid_it != facet_id) {
+            fids.insert(fid_it, facet_id);
+        }
+    }
+}
+
+void facet_index_t::remove_value_tokens(facet_doc_ids_list_t& facet_index, const uint32_t facet_id,
+                                        const std::string& fvalue) {
+    if(!facet_index.has_token_index) {
+        return;
+    }
+
+    std::vector<std::string> tokens;
+    get_value_tokens(facet_index, fvalue, tokens);
+
+    for(const auto& token: tokens) {
+        auto token_it = facet_index.token_fids.find(token);
+        if(token_it == facet_index.token_fids.end()) {
+            continue;
+        }
+
+        auto& fids = token_it.value();
+        const auto fid_it = std::lower_bound(fids.begin(), fids.end(), facet_id);
+        if(fid_it != fids.end() && *fid_it == facet_id) {
+            fids.erase(fid_it);
+        }
+
+        if(fids.empty()) {
+            facet_index.token_fids.erase(token);
+        }
+    }
+}
+
+void facet_index_t::search_token_index(const facet_doc_ids_list_t& facet_index,
+                                       const std::vector<std::vector<std::string>>& fvalue_searched_tokens,
+                                       spp::sparse_hash_map<uint32_t, size_t>& matched_fids) {
+    std::vector<uint32_t> query_fids, token_fids, common_fids;
+
+    for(size_t query_index = 0; query_index < fvalue_searched_tokens.size(); query_index++) {
+        const auto& searched_tokens = fvalue_searched_tokens[query_index];
+        query_fids.clear();
+
+        // a value matches when every searched token is a prefix of one of its tokens
+        for(size_t token_index = 0; token_index < searched_tokens.size(); token_index++) {
+            token_fids.clear();
+
+            const auto prefix_range = facet_index.token_fids.equal_prefix_range(searched_tokens[token_index]);
+            for(auto it = prefix_range.first; it != prefix_range.second; ++it) {
+                token_fids.insert(token_fids.end(), it.value().begin(), it.value().end());
+            }
+
+            std::sort(token_fids.begin(), token_fids.end());
+            token_fids.erase(std::unique(token_fids.begin(), token_fids.end()), token_fids.end());
+
+            if(token_index == 0) {
+                query_fids.swap(token_fids);
+            } else {
+                common_fids.clear();
+                std::set_intersection(query_fids.begin(), query_fids.end(), token_fids.begin(), token_fids.end(),
+                                      std::back_inserter(common_fids));
+                query_fids.swap(common_fids);
+            }
+
+            if(query_fids.empty()) {
+                break;
+            }
+        }
+
+        for(const auto facet_id: query_fids) {
+            matched_fids.emplace(facet_id, query_index);
+        }
+    }
+}
+
 void facet_index_t::insert(const std::string& field_name,
                            std::unordered_map<facet_value_id_t, std::vector<uint32_t>, facet_value_id_t::Hash>& fvalue_to_seq_ids,
                            std::unordered_map<uint32_t, std::vector<facet_value_id_t>>& seq_id_to_fvalues,
@@ -22,8 +144,8 @@ void facet_index_t::insert(const std::string& field_name,
     }
 
     auto& facet_index = facet_field_map_it->second;
-    auto& fvalue_index = facet_index.fvalue_seq_ids;
-    auto& fid_index = facet_index.fid_fvalues;
+    auto& fvalue_index = facet_index.fid_seq_ids;
+    auto& fvalue_dict = facet_index.fvalues;
     auto fhash_index = facet_index.seq_id_hashes;
 
     for(const auto& seq_id_fvalues: seq_id_to_fvalues) {
@@ -33,11 +155,12 @@ void facet_index_t::insert(const std::string& field_name,
 
         for(const auto& fvalue: seq_id_fvalues.second) {
             uint32_t facet_id = fvalue.facet_id;
-            const auto& fvalue_index_it = fvalue_index.find(fvalue.facet_value);
+            uint32_t dict_facet_id;
+            const bool is_new_value = !fvalue_dict.find(fvalue.facet_value, dict_facet_id);
 
             if(fvalue.facet_id == UINT32_MAX) {
                 // float, int32 & bool will provide facet_id as their own numerical values
-                facet_id = (fvalue_index_it == fvalue_index.end()) ? ++next_facet_id : fvalue_index_it->second.facet_id;
+                facet_id = is_new_value ? ++next_facet_id : dict_facet_id;
 
                 if(!is_string_field) {
                     int64_t val = std::stoll(fvalue.facet_value);
@@ -54,31 +177,32 @@ void facet_index_t::insert(const std::string& field_name,
 
             auto& seq_ids = seq_ids_it->second;
 
-            if(fvalue_index_it == fvalue_index.end()) {
-                facet_id_seq_ids_t fis;
-                fis.facet_id = facet_id;
+            if(is_new_value) {
+                fvalue_dict.add(facet_id, fvalue.facet_value);
+            }
+
+            if(!is_new_value && dict_facet_id != facet_id) {
+                LOG(ERROR) << "Wrong reference stored for facet " << fvalue.facet_value << " with facet_id " << facet_id;
+            } else if(facet_index.has_value_index) {
+                const auto fvalue_index_it = fvalue_index.find(facet_id);
 
-                if(facet_index.has_value_index) {
+                if(fvalue_index_it == fvalue_index.end()) {
+                    facet_id_seq_ids_t fis;
                     fis.seq_ids = ids_t::create(seq_ids);
                     auto new_count = ids_t::num_ids(fis.seq_ids);
-                    fis.facet_count_it = facet_index.counts.emplace(fvalue.facet_value, new_count, facet_id);
-                }
-
-                fvalue_index.emplace(fvalue.facet_value, fis);
-                fid_index.emplace(facet_id, fvalue.facet_value);
-            } else if(facet_index.has_value_index) {
-                for(const auto id : seq_ids) {
-                    ids_t::upsert(fvalue_index_it->second.seq_ids, id);
-                }
+                    fis.facet_count_it = facet_index.counts.emplace(new_count, facet_id);
 
-                auto facet_count_it = fvalue_index_it->second.facet_count_it;
+                    fvalue_index.emplace(facet_id, fis);
+                    facet_index.sorted_fids_stale = true;
+                    index_value_tokens(facet_index, facet_id, fvalue.facet_value);
+                } else {
+                    for(const auto id : seq_ids) {
+                        ids_t::upsert(fvalue_index_it->second.seq_ids, id);
+                    }
 
-                if(facet_count_it->facet_id == facet_id) {
-                    auto facet_count_node = facet_index.counts.extract(facet_count_it);
+                    auto facet_count_node = facet_index.counts.extract(fvalue_index_it->second.facet_count_it);
                     facet_count_node.value().count = ids_t::num_ids(fvalue_index_it->second.seq_ids);
-                    facet_index.counts.insert(std::move(facet_count_node));
-                } else {
-                    LOG(ERROR) << "Wrong reference stored for facet " << fvalue.facet_value << " with facet_id " << facet_id;
+                    fvalue_index_it->second.facet_count_it = facet_index.counts.insert(std::move(facet_count_node));
                 }
             }
 
@@ -87,6 +211,7 @@ void facet_index_t::insert(const std::string& field_name,
 
         if(facet_index.has_hash_index && fhash_index != nullptr) {
             fhash_index->upsert(seq_id, real_facet_ids);
+            facet_index.forward_index->upsert(seq_id, real_facet_ids);
         }
     }
 }
@@ -134,13 +259,31 @@ void facet_index_t::get_stringified_values(const nlohmann::json& document, const
     bool is_array = afield.is_array();
 
     if(!is_array) {
-        return get_stringified_value(document[afield.name], afield, values);
+        get_stringified_value(document[afield.name], afield, values);
     } else {
         const auto& field_values = document[afield.name];
         for(size_t i = 0; i < field_values.size(); i++) {
             get_stringified_value(field_values[i], afield, values);
         }
     }
+
+    if(afield.is_hierarchical()) {
+        // ancestor paths were indexed along with the document's values
+        std::set<std::string> doc_values(values.begin(), values.end());
+        std::vector<std::string> ancestors;
+        const size_t num_doc_values = values.size();
+
+        for(size_t i = 0; i < num_doc_values; i++) {
+            ancestors.clear();
+            afield.get_hierarchy_ancestors(values[i], ancestors);
+
+            for(auto& ancestor: ancestors) {
+                if(doc_values.insert(ancestor).second) {
+                    values.push_back(ancestor);
+                }
+            }
+        }
+    }
 }
 
 void facet_index_t::remove(const nlohmann::json& doc, const field& afield, const uint32_t seq_id) {
@@ -149,15 +292,19 @@ void facet_index_t::remove(const nlohmann::json& doc, const field& afield, const
         return ;
     }
 
-    auto& facet_index_map = facet_field_it->second.fvalue_seq_ids;
-    auto& facet_ids_map = facet_field_it->second.fid_fvalues;
-    std::vector<std::string> dead_fvalues;
+    auto& facet_index_map = facet_field_it->second.fid_seq_ids;
+    auto& fvalue_dict = facet_field_it->second.fvalues;
     std::vector<uint32_t> dead_fids;
     std::vector<std::string> values;
     get_stringified_values(doc, afield, values);
 
     for(const auto& value: values) {
-        auto fvalue_it = facet_index_map.find(value);
+        uint32_t facet_id;
+        if(!fvalue_dict.find(value, facet_id)) {
+            continue;
+        }
+
+        auto fvalue_it = facet_index_map.find(facet_id);
         if(fvalue_it == facet_index_map.end()) {
             continue;
         }
@@ -170,34 +317,35 @@ void facet_index_t::remove(const nlohmann::json& doc, const field& afield, const
 
             if(new_count == 0) {
                 ids_t::destroy_list(ids);
-                dead_fvalues.push_back(fvalue_it->first);
-                dead_fids.push_back(fvalue_it->second.facet_id);
+                dead_fids.push_back(facet_id);
 
                 // remove from int64 lookup map first
                 auto& fhash_int64_map = facet_field_it->second.fhash_to_int64_map;
-                uint32_t fhash = fvalue_it->second.facet_id;
-                fhash_int64_map.erase(fhash);
+                fhash_int64_map.erase(facet_id);
 
                 counts.erase(fvalue_it->second.facet_count_it);
             } else {
                 // update count
                 auto count_node = counts.extract(fvalue_it->second.facet_count_it);
                 count_node.value().count = ids_t::num_ids(ids);
-                counts.insert(std::move(count_node));
+                fvalue_it->second.facet_count_it = counts.insert(std::move(count_node));
             }
         }
     }
 
-    for(auto& dead_fvalue: dead_fvalues) {
-        facet_index_map.erase(dead_fvalue);
+    for(auto& dead_fid: dead_fids) {
+        remove_value_tokens(facet_field_it->second, dead_fid, std::string(fvalue_dict.get(dead_fid)));
+        facet_index_map.erase(dead_fid);
+        fvalue_dict.erase(dead_fid);
     }
 
-    for(auto& dead_fid: dead_fids) {
-        facet_ids_map.erase(dead_fid);
+    if(!dead_fids.empty()) {
+        facet_field_it->second.sorted_fids_stale = true;
     }
 
     auto& seq_id_hashes = facet_field_it->second.seq_id_hashes;
     seq_id_hashes->erase(seq_id);
+    facet_field_it->second.forward_index->erase(seq_id);
 }
 
 size_t facet_index_t::get_facet_count(const std::string& field_name) {
@@ -217,13 +365,31 @@ std::string facet_index_t::get_facet_str_val(const std::string& field_name, uint
         return "";
     }
 
-    auto fid_it = it->second.fid_fvalues.find(facet_id);
+    return std::string(it->second.fvalues.get(facet_id));
+}
+
+const std::vector<uint32_t>& facet_index_t::get_sorted_fids(facet_doc_ids_list_t& facet_index) {
+    // intersect() runs under a shared lock, so the first reader after a change rebuilds the order for all of them
+    std::unique_lock lock(facet_index.sorted_fids_mutex);
 
-    if(fid_it != it->second.fid_fvalues.end()) {
-        return fid_it->second;
+    if(facet_index.sorted_fids_stale) {
+        auto& sorted_fids = facet_index.sorted_fids;
+        sorted_fids.clear();
+        sorted_fids.reserve(facet_index.fid_seq_ids.size());
+
+        for(const auto& kv: facet_index.fid_seq_ids) {
+            sorted_fids.push_back(kv.first);
+        }
+
+        const auto& fvalue_dict = facet_index.fvalues;
+        std::sort(sorted_fids.begin(), sorted_fids.end(), [&fvalue_dict](uint32_t a, uint32_t b) {
+            return fvalue_dict.get(a) < fvalue_dict.get(b);
+        });
+
+        facet_index.sorted_fids_stale = false;
     }
 
-    return "";
+    return facet_index.sorted_fids;
 }
 
 //returns the count of matching seq_ids from result array
@@ -243,7 +409,8 @@ size_t facet_index_t::intersect(facet& a_facet, const field& facet_field,
         return 0;
     }
 
-    const auto& facet_index_map = facet_field_it->second.fvalue_seq_ids;
+    const auto& facet_index_map = facet_field_it->second.fid_seq_ids;
+    const auto& fvalue_dict = facet_field_it->second.fvalues;
     const auto& counter_list = facet_field_it->second.counts;
 
      //LOG(INFO) << "fvalue_seq_ids size " << facet_index_map.size() << " , counts size " << counter_list.size();
@@ -253,12 +420,27 @@ size_t facet_index_t::intersect(facet& a_facet, const field& facet_field,
     size_t max_facets = is_wildcard_no_filter_query ? std::min((size_t)max_facet_count, counter_list.size()) :
                         std::min((size_t)2 * max_facet_count, counter_list.size());
 
+    // facet id => index of the first searched query that its value matches
+    const bool use_token_index = has_facet_query && facet_field_it->second.has_token_index;
+    spp::sparse_hash_map<uint32_t, size_t> matched_fids;
+    if(use_token_index) {
+        search_token_index(facet_field_it->second, fvalue_searched_tokens, matched_fids);
+    }
+
     auto intersect_fn = [&] (std::multiset<facet_count_t>::const_iterator facet_count_it) {
         uint32_t count = 0;
         uint32_t doc_id = 0;
-        if(has_facet_query) {
+        if(use_token_index) {
+            const auto matched_it = matched_fids.find(facet_count_it->facet_id);
+            if(matched_it == matched_fids.end()) {
+                return;
+            }
+
+            a_facet.fvalue_tokens[std::string(fvalue_dict.get(facet_count_it->facet_id))] =
+                    fvalue_searched_tokens[matched_it->second];
+        } else if(has_facet_query) {
             bool found_search_token = false;
-            auto facet_str = facet_count_it->facet_value;
+            const std::string facet_str(fvalue_dict.get(facet_count_it->facet_id));
             std::vector<std::string> facet_tokens;
             if(facet_field.is_string()) {
                 const auto& token_separators = facet_field.token_separators.empty() ? coll_token_separators : facet_field.token_separators;
@@ -286,7 +468,7 @@ size_t facet_index_t::intersect(facet& a_facet, const field& facet_field,
                 }
 
                 if (found_all_search_tokens) {
-                    a_facet.fvalue_tokens[facet_count_it->facet_value] = searched_tokens;
+                    a_facet.fvalue_tokens[facet_str] = searched_tokens;
                     found_search_token = true;
                     break;
                 }
@@ -297,7 +479,7 @@ size_t facet_index_t::intersect(facet& a_facet, const field& facet_field,
             }
         }
 
-        auto ids = facet_index_map.at(facet_count_it->facet_value).seq_ids;
+        auto ids = facet_index_map.at(facet_count_it->facet_id).seq_ids;
         if (!ids) {
             return;
         }
@@ -312,11 +494,33 @@ size_t facet_index_t::intersect(facet& a_facet, const field& facet_field,
 
         if (count) {
             doc_id = ids_t::first_id(ids);
-            found[facet_count_it->facet_value] = {doc_id, count};
+            found[std::string(fvalue_dict.get(facet_count_it->facet_id))] = {doc_id, count};
         }
     };
 
-    if(sort_order.empty()) {
+    if(sort_order.empty() && use_token_index) {
+        // only the matching values are visited, in the order of their counts
+        std::vector<std::multiset<facet_count_t>::const_iterator> matched_counts;
+        matched_counts.reserve(matched_fids.size());
+
+        for(const auto& kv: matched_fids) {
+            const auto facet_index_map_it = facet_index_map.find(kv.first);
+            if(facet_index_map_it != facet_index_map.end()) {
+                matched_counts.push_back(facet_index_map_it->second.facet_count_it);
+            }
+        }
+
+        std::sort(matched_counts.begin(), matched_counts.end(), [](const auto& a, const auto& b) {
+            return std::tie(b->count, a->facet_id) < std::tie(a->count, b->facet_id);
+        });
+
+        for(const auto& facet_count_it: matched_counts) {
+            intersect_fn(facet_count_it);
+            if (found.size() == max_facets) {
+                break;
+            }
+        }
+    } else if(sort_order.empty()) {
         for (auto facet_count_it = counter_list.begin(); facet_count_it != counter_list.end();
              ++facet_count_it) {
             //LOG(INFO) << "checking ids in facet_value " << facet_count.facet_value << " having total count "
@@ -328,20 +532,18 @@ size_t facet_index_t::intersect(facet& a_facet, const field& facet_field,
             }
         }
     } else {
-        if(sort_order == "asc") {
-            for(auto facet_index_map_it = facet_index_map.begin();
-                facet_index_map_it != facet_index_map.end(); ++facet_index_map_it) {
+        const auto& sorted_fids = get_sorted_fids(facet_field_it->second);
 
-                intersect_fn(facet_index_map_it->second.facet_count_it);
+        if(sort_order == "asc") {
+            for(auto sorted_fids_it = sorted_fids.begin(); sorted_fids_it != sorted_fids.end(); ++sorted_fids_it) {
+                intersect_fn(facet_index_map.at(*sorted_fids_it).facet_count_it);
                 if (found.size() == max_facets) {
                     break;
                 }
             }
         } else if(sort_order == "desc") {
-            for(auto facet_index_map_it = facet_index_map.rbegin();
-                facet_index_map_it != facet_index_map.rend(); ++facet_index_map_it) {
-
-                intersect_fn(facet_index_map_it->second.facet_count_it);
+            for(auto sorted_fids_it = sorted_fids.rbegin(); sorted_fids_it != sorted_fids.rend(); ++sorted_fids_it) {
+                intersect_fn(facet_index_map.at(*sorted_fids_it).facet_count_it);
                 if (found.size() == max_facets) {
                     break;
                 }
@@ -365,7 +567,7 @@ size_t facet_index_t::get_facet_indexes(const std::string& field_name,
         return 0;
     }
 
-    auto& facet_index_map = facet_field_it->second.fvalue_seq_ids;
+    auto& facet_index_map = facet_field_it->second.fid_seq_ids;
 
     std::vector<uint32_t> id_list;
 
@@ -381,7 +583,7 @@ size_t facet_index_t::get_facet_indexes(const std::string& field_name,
         // emplacing seq_id => next_facet_id
         for(const auto& id : id_list) {
             //seqid_countIndexes[id].emplace_back(facet_index_map_it->facet_id);
-            seqid_countIndexes[id].emplace_back(facet_index_map_it->second.facet_id);
+            seqid_countIndexes[id].emplace_back(facet_index_map_it->first);
         }
 
         id_list.clear();
@@ -407,6 +609,7 @@ void facet_index_t::handle_index_change(const std::string& field_name, size_t to
         if(get_facet_indexes(field_name, seq_id_index_map)) {
             for(const auto& kv : seq_id_index_map) {
                 fhash_index->upsert(kv.first, kv.second);
+                facet_index.forward_index->upsert(kv.first, kv.second);
             }
         }
 
@@ -418,12 +621,7 @@ void facet_index_t::handle_index_change(const std::string& field_name, size_t to
 
         if(cardinality_ratio != 0 && cardinality_ratio < 5) {
             // drop the value index for this field
-            auto& fvalue_seq_ids = facet_index.fvalue_seq_ids;
-            for(auto it = fvalue_seq_ids.begin(); it != fvalue_seq_ids.end(); ++it) {
-                ids_t::destroy_list(it->second.seq_ids);
-            }
-            fvalue_seq_ids.clear();
-            facet_index.counts.clear();
+            facet_index.drop_value_index();
             facet_index.has_value_index = false;
         }
     }
@@ -447,6 +645,14 @@ posting_list_t* facet_index_t::get_facet_hash_index(const std::string &field_nam
     return nullptr;
 }
 
+const facet_forward_index_t* facet_index_t::get_facet_forward_index(const std::string& field_name) const {
+    auto facet_index_it = facet_field_map.find(field_name);
+    if(facet_index_it != facet_field_map.end()) {
+        return facet_index_it->second.forward_index;
+    }
+    return nullptr;
+}
+
 const spp::sparse_hash_map<uint32_t , int64_t >& facet_index_t::get_fhash_int64_map(const std::string& field_name) {
     static const spp::sparse_hash_map<uint32_t, int64_t> empty_map{};
     const auto facet_field_map_it = facet_field_map.find(field_name);
@@ -465,8 +671,8 @@ bool facet_index_t::facet_value_exists(const std::string& field_name, const std:
         return false;
     }
 
-    const auto& facet_index = facet_field_map_it->second;
-    return facet_index.fvalue_seq_ids.find(fvalue) != facet_index.fvalue_seq_ids.end();
+    uint32_t facet_id;
+    return facet_field_map_it->second.fvalues.find(fvalue, facet_id);
 }
 
 size_t facet_index_t::facet_val_num_ids(const string &field_name, const string &fvalue) {
@@ -475,12 +681,12 @@ size_t facet_index_t::facet_val_num_ids(const string &field_name, const string &
         return 0;
     }
 
-    if(facet_field_map_it->second.fvalue_seq_ids.count(fvalue) == 0) {
+    const auto fis = facet_field_map_it->second.find_value(fvalue);
+    if(fis == nullptr) {
         return 0;
     }
 
-    auto seq_ids = facet_field_map_it->second.fvalue_seq_ids[fvalue].seq_ids;
-    return seq_ids ?  ids_t::num_ids(seq_ids) : 0;
+    return fis->seq_ids ?  ids_t::num_ids(fis->seq_ids) : 0;
 }
 
 size_t facet_index_t::facet_node_count(const string &field_name, const string &fvalue) {
@@ -489,11 +695,12 @@ size_t facet_index_t::facet_node_count(const string &field_name, const string &f
         return 0;
     }
 
-    if(facet_field_map_it->second.fvalue_seq_ids.count(fvalue) == 0) {
+    const auto fis = facet_field_map_it->second.find_value(fvalue);
+    if(fis == nullptr) {
         return 0;
     }
 
-    return facet_field_map_it->second.fvalue_seq_ids[fvalue].facet_count_it->count;
+    return fis->facet_count_it->count;
 }
 
 void facet_index_t::check_for_high_cardinality(const string& field_name, size_t total_num_docs) {
@@ -511,7 +718,7 @@ void facet_index_t::check_for_high_cardinality(const string& field_name, size_t
         return ;
     }
 
-    auto num_facet_values = facet_field_map_it->second.fvalue_seq_ids.size();
+    auto num_facet_values = facet_field_map_it->second.fvalues.size();
     bool is_sparse_field = false;
 
     size_t num_docs_with_facet = facet_field_map_it->second.seq_id_hashes->num_ids();
@@ -524,13 +731,7 @@ void facet_index_t::check_for_high_cardinality(const string& field_name, size_t
     if(num_facet_values > value_facet_threshold || is_sparse_field) {
         // if there are too many unique values
         // or if there are too few docs for facet field, we will drop the value index
-        auto& fvalue_seq_ids = facet_field_map_it->second.fvalue_seq_ids;
-        for(auto it = fvalue_seq_ids.begin(); it != fvalue_seq_ids.end(); ++it) {
-            ids_t::destroy_list(it->second.seq_ids);
-            it->second.seq_ids = nullptr;
-        }
-
-        facet_field_map_it->second.counts.clear();
+        facet_field_map_it->second.drop_value_index();
         facet_field_map_it->second.has_value_index = false;
         //LOG(INFO) << "Dropped value index for field " << field_name;
     }
@@ -0,0 +1,99 @@
+#include "facet_value_dict.h"
+#include <algorithm>
+#include <cstring>
+
+std::string_view facet_value_dict_t::store(std::string_view value) {
+    if(value.empty()) {
+        return {};
+    }
+
+    if(blocks.empty() || last_block_used + value.size() > last_block_size) {
+        // blocks grow geometrically so that fields with a handful of short values stay small
+        last_block_size = std::clamp(last_block_size * 2, MIN_BLOCK_SIZE, MAX_BLOCK_SIZE);
+        last_block_size = std::max(last_block_size, value.size());
+        blocks.emplace_back(new char[last_block_size]);
+        block_bytes += last_block_size;
+        last_block_used = 0;
+    }
+
+    char* dest = blocks.back().get() + last_block_used;
+    std::memcpy(dest, value.data(), value.size());
+    last_block_used += value.size();
+    live_bytes += value.size();
+
+    return {dest, value.size()};
+}
+
+bool facet_value_dict_t::add(const uint32_t facet_id, std::string_view value) {
+    if(fid_values.count(facet_id) != 0 || value_fids.count(value) != 0) {
+        return false;
+    }
+
+    const auto stored_value = store(value);
+    fid_values.emplace(facet_id, stored_value);
+    value_fids.emplace(stored_value, facet_id);
+    return true;
+}
+
+bool facet_value_dict_t::find(std::string_view value, uint32_t& facet_id) const {
+    const auto it = value_fids.find(value);
+    if(it == value_fids.end()) {
+        return false;
+    }
+
+    facet_id = it->second;
+    return true;
+}
+
+std::string_view facet_value_dict_t::get(const uint32_t facet_id) const {
+    const auto it = fid_values.find(facet_id);
+    return (it == fid_values.end()) ? std::string_view() : it->second;
+}
+
+void facet_value_dict_t::erase(const uint32_t facet_id) {
+    const auto it = fid_values.find(facet_id);
+    if(it == fid_values.end()) {
+        return;
+    }
+
+    const auto value = it->second;
+    value_fids.erase(value);
+    fid_values.erase(it);
+
+    live_bytes -= value.size();
+    dead_bytes += value.size();
+
+    if(dead_bytes > live_bytes && dead_bytes >= MAX_BLOCK_SIZE) {
+        compact();
+    }
+}
+
+void facet_value_dict_t::compact() {
+    // the old blocks stay alive until every live value has been copied out of them
+    auto old_blocks = std::move(blocks);
+    blocks.clear();
+    last_block_size = 0;
+    last_block_used = 0;
+    block_bytes = 0;
+    live_bytes = 0;
+    dead_bytes = 0;
+
+    value_fids.clear();
+
+    for(auto& kv: fid_values) {
+        kv.second = store(kv.second);
+        value_fids.emplace(kv.second, kv.first);
+    }
+}
+
+void facet_value_dict_t::clear() {
+    blocks.clear();
+    last_block_size = 0;
+    last_block_used = 0;
+    block_bytes = 0;
+    live_bytes = 0;
+    dead_bytes = 0;
+
+    fid_values.clear();
+    value_fids.clear();
+}
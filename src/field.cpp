@@ -310,6 +310,32 @@ Option<bool> field::json_field_to_field(bool enable_nested_fields, nlohmann::jso
         }
     }
 
+    if(field_json.count(fields::expression) != 0) {
+        if(!field_json[fields::expression].is_string() || field_json[fields::expression].get<std::string>().empty()) {
+            return Option<bool>(400, "Property `" + fields::expression + "` must be a non-empty string.");
+        }
+
+        if(field_json[fields::type] != field_types::FLOAT) {
+            return Option<bool>(400, "Fields with the `" + fields::expression + "` parameter can only be of type `float`.");
+        }
+    }
+
+    if(field_json.count(fields::hierarchy_separator) != 0) {
+        if(!field_json[fields::hierarchy_separator].is_string() ||
+           field_json[fields::hierarchy_separator].get<std::string>().empty()) {
+            return Option<bool>(400, "Property `" + fields::hierarchy_separator + "` must be a non-empty string.");
+        }
+
+        if(field_json[fields::type] != field_types::STRING && field_json[fields::type] != field_types::STRING_ARRAY) {
+            return Option<bool>(400, "Fields with the `" + fields::hierarchy_separator + "` parameter can only be of "
+                                     "type `string` or `string[]`.");
+        }
+
+        if(!field_json[fields::facet].get<bool>()) {
+            return Option<bool>(400, "Fields with the `" + fields::hierarchy_separator + "` parameter must be faceted.");
+        }
+    }
+
     auto DEFAULT_VEC_DIST_METRIC = magic_enum::enum_name(vector_distance_type_t::cosine);
 
     if(!field_json[fields::num_dim].is_number_unsigned()) {
@@ -446,6 +472,14 @@ Option<bool> field::json_field_to_field(bool enable_nested_fields, nlohmann::jso
                   field_json[fields::symbols_to_index])
     );
 
+    if(field_json.count(fields::expression) != 0) {
+        the_fields.back().expression = field_json[fields::expression].get<std::string>();
+    }
+
+    if(field_json.count(fields::hierarchy_separator) != 0) {
+        the_fields.back().hierarchy_separator = field_json[fields::hierarchy_separator].get<std::string>();
+    }
+
     if (!field_json[fields::reference].get<std::string>().empty()) {
         // Add a reference helper field in the schema. It stores the doc id of the document it references to reduce the
         // computation while searching.
@@ -777,6 +811,13 @@ Option<bool> field::json_fields_to_fields(bool enable_nested_fields, nlohmann::j
                 return validate_res;
             }
         }
+
+        if(!the_fields.empty() && the_fields.back().is_derived()) {
+            auto validate_res = validate_derived_field(dummy_search_schema, fields_json, the_fields.back());
+            if(!validate_res.ok()) {
+                return validate_res;
+            }
+        }
     }
 
     if(num_auto_detect_fields > 1) {
@@ -855,6 +896,86 @@ Option<bool> field::validate_and_init_embed_field(const tsl::htrie_map<char, fie
     return Option<bool>(true);
 }
 
+Option<bool> field::parse_derived_expression(const std::string& expression, sort_by& decay_function) {
+    const std::string error = "Bad syntax for the expression `" + expression + "`.";
+
+    std::string expression_str = expression;
+    StringUtils::trim(expression_str);
+
+    auto paran_start = expression_str.find('(');
+    if(paran_start == std::string::npos || paran_start == 0 || expression_str.back() != ')') {
+        return Option<bool>(400, error);
+    }
+
+    decay_function.name = expression_str.substr(0, paran_start);
+    StringUtils::trim(decay_function.name);
+
+    const std::string& params_str = expression_str.substr(paran_start + 1, expression_str.size() - paran_start - 2);
+    auto parse_op = decay_function.parse_decay_function_params(params_str, error);
+    if(!parse_op.ok()) {
+        return parse_op;
+    }
+
+    if(decay_function.sort_by_param == sort_by::none) {
+        return Option<bool>(400, "Bad syntax. Missing param `func`.");
+    }
+
+    return Option<bool>(true);
+}
+
+Option<bool> field::validate_derived_field(const tsl::htrie_map<char, field>& search_schema,
+                                           const nlohmann::json& fields_json,
+                                           const field& the_field) {
+    sort_by decay_function("", "");
+    auto parse_op = parse_derived_expression(the_field.expression, decay_function);
+    if(!parse_op.ok()) {
+        return parse_op;
+    }
+
+    const std::string err_msg = "Property `" + fields::expression + "` can only refer to an integer field.";
+    std::string source_type;
+
+    for(const auto& field_json: fields_json) {
+        if(field_json.count(fields::name) != 0 && field_json[fields::name] == decay_function.name &&
+           field_json.count(fields::type) != 0 && field_json[fields::type].is_string()) {
+            source_type = field_json[fields::type].get<std::string>();
+            break;
+        }
+    }
+
+    if(source_type.empty()) {
+        auto search_field_it = search_schema.find(decay_function.name);
+        if(search_field_it == search_schema.end()) {
+            return Option<bool>(400, "Property `" + fields::expression + "` refers to the field `" +
+                                     decay_function.name + "` which is not found in the schema.");
+        }
+
+        source_type = search_field_it.value().type;
+    }
+
+    if(source_type != field_types::INT32 && source_type != field_types::INT64) {
+        return Option<bool>(400, err_msg);
+    }
+
+    return Option<bool>(true);
+}
+
+void field::get_hierarchy_ancestors(const std::string& path, std::vector<std::string>& ancestors) const {
+    if(hierarchy_separator.empty()) {
+        return;
+    }
+
+    // ancestors are the prefixes of the path that end right before a separator
+    size_t separator_pos = path.find(hierarchy_separator);
+    while(separator_pos != std::string::npos) {
+        if(separator_pos != 0) {
+            ancestors.push_back(path.substr(0, separator_pos));
+        }
+
+        separator_pos = path.find(hierarchy_separator, separator_pos + hierarchy_separator.size());
+    }
+}
+
 nlohmann::json field::field_to_json_field(const struct field& field) {
     nlohmann::json field_val;
     field_val[fields::name] = field.name;
@@ -912,9 +1033,95 @@ nlohmann::json field::field_to_json_field(const struct field& field) {
     if (field.num_dim > 0 && !field.hnsw_params.empty()) {
         field_val[fields::hnsw_params] = field.hnsw_params;
     }
+
+    if(field.is_derived()) {
+        field_val[fields::expression] = field.expression;
+    }
+
+    if(field.is_hierarchical()) {
+        field_val[fields::hierarchy_separator] = field.hierarchy_separator;
+    }
     return field_val;
 }
 
+Option<bool> sort_by::parse_decay_function_params(const std::string& sort_params_str, const std::string& error) {
+    std::vector<std::string> value_params, param_parts;
+    StringUtils::split(sort_params_str, value_params, ",");
+
+    for(const auto& value_param : value_params) {
+        param_parts.clear();
+        StringUtils::split(value_param, param_parts, ":");
+
+        if (param_parts.size() != 2) {
+            return Option<bool>(400, error);
+        }
+
+        if(param_parts[0] == sort_field_const::func) {
+            if(param_parts[1]!= sort_field_const::gauss && param_parts[1]!= sort_field_const::exp
+               && param_parts[1]!= sort_field_const::linear && param_parts[1]!= sort_field_const::diff) {
+                return Option<bool>(400, "Bad syntax. Not a valid decay function key `" + param_parts[1] + "`.");
+            }
+            auto action_op = magic_enum::enum_cast<sort_by::sort_by_params_t>(param_parts[1]);
+            if(action_op.has_value()) {
+                sort_by_param = action_op.value();
+            }
+        } else if(param_parts[0] == sort_field_const::scale) {
+            if (!StringUtils::is_integer(param_parts[1]) || param_parts[1] == "0") {
+                return Option<bool>(400, "sort_by: scale param should be non-zero integer.");
+            }
+            scale = std::stoll(param_parts[1]);
+        } else if(param_parts[0] == sort_field_const::origin) {
+            if (!StringUtils::is_integer(param_parts[1])) {
+                return Option<bool>(400, "sort_by: origin param should be integer.");
+            }
+            origin_val = std::stoll(param_parts[1]);
+        } else if(param_parts[0] == sort_field_const::offset) {
+            if (!StringUtils::is_integer(param_parts[1])) {
+                return Option<bool>(400, "sort_by: offset param should be integer.");
+            }
+            offset = std::stoll(param_parts[1]);
+        } else if(param_parts[0] == sort_field_const::decay) {
+            if (!StringUtils::is_float(param_parts[1])) {
+                return Option<bool>(400, "sort_by: decay param should be float.");
+            }
+            auto val = std::stof(param_parts[1]);
+            if(val < 0.0f || val > 1.0f) {
+                return Option<bool>(400, "sort_by: decay param should be float in range [0.0, 1.0].");
+            }
+            decay_val = val;
+        } else {
+            if (param_parts[0] != sort_field_const::missing_values) {
+                return Option<bool>(400, error);
+            }
+
+            auto missing_values_op = magic_enum::enum_cast<sort_by::missing_values_t>(
+                    param_parts[1]);
+            if (missing_values_op.has_value()) {
+                missing_values = missing_values_op.value();
+            } else {
+                return Option<bool>(400, error);
+            }
+        }
+    }
+
+    if((sort_by_param == sort_by::linear || sort_by_param == sort_by::exp ||
+        sort_by_param == sort_by::gauss) && (origin_val == INT64_MAX ||
+        scale == INT64_MAX)) {
+            return Option<bool>(400, "Bad syntax. origin and scale are mandatory params for decay function "
+                + std::string(magic_enum::enum_name(sort_by_param)));
+
+    } else if(sort_by_param == sort_by::diff && origin_val == INT64_MAX) {
+            return Option<bool>(400, "Bad syntax. origin param is mandatory for diff function.");
+
+    } else if(sort_by_param != sort_by::linear && sort_by_param != sort_by::exp &&
+              sort_by_param != sort_by::gauss && sort_by_param != sort_by::diff &&
+              origin_val != INT64_MAX) {
+            return Option<bool>(400, "Bad syntax. Missing param `func`.");
+    }
+
+    return Option<bool>(true);
+}
+
 Option<bool> field::fields_to_json_fields(const std::vector<field>& fields, const string& default_sorting_field,
                                           nlohmann::json& fields_json) {
     bool found_default_sorting_field = false;
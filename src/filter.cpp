@@ -453,23 +453,30 @@ Option<bool> toFilter(const std::string& expression,
         if (raw_value[0] == '[' && raw_value[raw_value.size() - 1] == ']') {
             std::vector<std::string> doc_ids;
             StringUtils::split_to_values(raw_value.substr(1, raw_value.size() - 2), doc_ids);
-            for (std::string& doc_id: doc_ids) {
-                if (doc_id == "*") {
-                    filter_exp.values.clear();
-                    filter_exp.values.emplace_back("*");
+            if (std::find(doc_ids.begin(), doc_ids.end(), "*") != doc_ids.end()) {
+                filter_exp.values.emplace_back("*");
+                filter_exp.comparators.push_back(id_comparator);
+                return Option<bool>(true);
+            }
 
-                    filter_exp.comparators.clear();
-                    filter_exp.comparators.push_back(id_comparator);
-                    break;
-                }
+            // we have to convert the doc_ids to seq ids: the distinct ids are looked up in a single batch, in the
+            // order of their keys
+            std::sort(doc_ids.begin(), doc_ids.end());
+            doc_ids.erase(std::unique(doc_ids.begin(), doc_ids.end()), doc_ids.end());
 
-                // we have to convert the doc_id to seq id
-                std::string seq_id_str;
-                StoreStatus seq_id_status = store->get(doc_id_prefix + doc_id, seq_id_str);
-                if (seq_id_status != StoreStatus::FOUND) {
+            std::vector<std::string> doc_id_keys;
+            doc_id_keys.reserve(doc_ids.size());
+            for (const auto& doc_id: doc_ids) {
+                doc_id_keys.push_back(doc_id_prefix + doc_id);
+            }
+
+            std::vector<std::string> seq_id_strs;
+            const auto seq_id_statuses = store->multi_get(doc_id_keys, seq_id_strs);
+            for (size_t i = 0; i < seq_id_statuses.size(); i++) {
+                if (seq_id_statuses[i] != StoreStatus::FOUND) {
                     continue;
                 }
-                filter_exp.values.push_back(seq_id_str);
+                filter_exp.values.push_back(std::move(seq_id_strs[i]));
                 filter_exp.comparators.push_back(id_comparator);
             }
         } else {
@@ -686,6 +693,11 @@ Option<bool> toFilter(const std::string& expression,
             }
             apply_not_equals = true;
             while (++filter_value_index < raw_value.size() && raw_value[filter_value_index] == ' ');
+        } else if (raw_value.size() >= 2 && (raw_value[0] == '^' || raw_value[0] == '$') && raw_value[1] == '=') {
+            // `^=` matches the tokens starting with the value and `$=` the tokens ending with it
+            str_comparator = raw_value[0] == '^' ? STARTS_WITH : ENDS_WITH;
+            filter_value_index++;
+            while (++filter_value_index < raw_value.size() && raw_value[filter_value_index] == ' ');
         }
         if (filter_value_index == raw_value.size()) {
             return Option<bool>(400, "Error with filter field `" + _field.name + "`: Filter value cannot be empty.");
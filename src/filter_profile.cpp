@@ -0,0 +1,132 @@
+#include "filter_profile.h"
+#include <chrono>
+
+nlohmann::json filter_profile_t::to_json() const {
+    nlohmann::json clauses_json = nlohmann::json::array();
+
+    for (const auto& clause: clauses) {
+        nlohmann::json clause_json;
+        clause_json["filter"] = clause.filter;
+        clause_json["time_us"] = clause.time_us;
+        clause_json["num_ids"] = clause.num_ids;
+        clause_json["strategy"] = clause.is_cached ? "cached" : (clause.is_materialized ? "materialize" : "iterate");
+        clause_json["search_cutoff"] = clause.search_cutoff;
+        clauses_json.push_back(clause_json);
+    }
+
+    return clauses_json;
+}
+
+filter_continuations_t::~filter_continuations_t() {
+    shutdown();
+}
+
+Option<uint64_t> filter_continuations_t::add(const std::string& collection_name, const std::string& filter_query,
+                                             std::function<Option<uint32_t>()> evaluate) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(is_stopped) {
+        return Option<uint64_t>(503, "Filter continuations are not accepted while shutting down.");
+    }
+
+    if(num_pending >= MAX_PENDING) {
+        return Option<uint64_t>(429, "Too many filter continuations are pending.");
+    }
+
+    const uint64_t id = next_id++;
+    entries.emplace(id, entry_t{collection_name, filter_query});
+    num_pending++;
+
+    while (entries.size() > MAX_ENTRIES) {
+        entries.erase(entries.begin());
+    }
+
+    // A single worker, so that the continuations don't compete with the searches for more than one core.
+    if (worker == nullptr) {
+        worker = std::make_unique<ThreadPool>(1);
+    }
+
+    worker->enqueue([this, id, evaluate = std::move(evaluate)]() {
+        bool should_evaluate;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            should_evaluate = !is_stopped && entries.count(id) != 0;
+        }
+
+        if (!should_evaluate) {
+            complete(id, Option<uint32_t>(503, "Filter continuation was not evaluated."), 0);
+            return;
+        }
+
+        const auto begin = std::chrono::high_resolution_clock::now();
+        const auto found_op = evaluate();
+        const uint64_t time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - begin).count();
+        complete(id, found_op, time_ms);
+    });
+
+    return Option<uint64_t>(id);
+}
+
+void filter_continuations_t::complete(const uint64_t id, const Option<uint32_t>& found_op, const uint64_t time_ms) {
+    std::lock_guard<std::mutex> lock(mutex);
+    num_pending--;
+
+    const auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+
+    auto& entry = it->second;
+    entry.completed = true;
+    entry.time_ms = time_ms;
+
+    if (found_op.ok()) {
+        entry.found = found_op.get();
+    } else {
+        entry.error = found_op.error();
+    }
+}
+
+bool filter_continuations_t::get(const std::string& collection_name, const uint64_t id,
+                                 nlohmann::json& status) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = entries.find(id);
+    if (it == entries.end() || it->second.collection_name != collection_name) {
+        return false;
+    }
+
+    const auto& entry = it->second;
+    status["id"] = id;
+    status["filter_by"] = entry.filter_query;
+
+    if (!entry.completed) {
+        status["status"] = "pending";
+    } else if (!entry.error.empty()) {
+        status["status"] = "failed";
+        status["error"] = entry.error;
+    } else {
+        status["status"] = "completed";
+        status["found"] = entry.found;
+        status["time_ms"] = entry.time_ms;
+    }
+
+    return true;
+}
+
+void filter_continuations_t::shutdown() {
+    std::unique_ptr<ThreadPool> stopped_worker;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_stopped = true;
+        stopped_worker = std::move(worker);
+    }
+
+    // The continuations complete under the lock, so the worker is joined without it. Queued continuations see the
+    // stop and return without being evaluated.
+    if (stopped_worker != nullptr) {
+        stopped_worker->shutdown();
+    }
+}
@@ -0,0 +1,110 @@
+#include "filter_result_cache.h"
+
+void filter_result_cache_t::erase(std::list<entry_t>::iterator entry_it) {
+    used_bytes -= entry_it->num_bytes;
+    key_entries.erase(entry_it->key);
+    entries.erase(entry_it);
+}
+
+bool filter_result_cache_t::is_stale(const entry_t& entry) const {
+    for(const auto& field_epoch: entry.field_epochs) {
+        const auto epoch_it = epochs.find(field_epoch.first);
+        const uint64_t epoch = (epoch_it == epochs.end()) ? 0 : epoch_it->second;
+        if(epoch != field_epoch.second) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void filter_result_cache_t::set_max_bytes(const size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->max_bytes = max_bytes;
+
+    while(used_bytes > max_bytes && !entries.empty()) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+bool filter_result_cache_t::is_enabled() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_bytes != 0;
+}
+
+filter_result_cache_t::field_epochs_t filter_result_cache_t::get_epochs(const std::vector<std::string>& field_names) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    field_epochs_t field_epochs;
+
+    for(const auto& field_name: field_names) {
+        const auto epoch_it = epochs.find(field_name);
+        field_epochs.emplace_back(field_name, (epoch_it == epochs.end()) ? 0 : epoch_it->second);
+    }
+
+    return field_epochs;
+}
+
+void filter_result_cache_t::bump_epoch(const std::string& field_name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    epochs[field_name]++;
+}
+
+bool filter_result_cache_t::lookup(const std::string& key, std::shared_ptr<const std::vector<uint32_t>>& ids) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto key_it = key_entries.find(key);
+    if(key_it == key_entries.end()) {
+        return false;
+    }
+
+    if(is_stale(*key_it->second)) {
+        erase(key_it->second);
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, key_it->second);
+    ids = key_it->second->ids;
+    return true;
+}
+
+void filter_result_cache_t::insert(const std::string& key, field_epochs_t field_epochs, std::vector<uint32_t>&& ids) {
+    // entries of empty results are charged for their bookkeeping, so that they cannot pile up
+    const size_t num_bytes = ids.size() * sizeof(uint32_t) + key.size() + sizeof(entry_t);
+    auto shared_ids = std::make_shared<const std::vector<uint32_t>>(std::move(ids));
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(max_bytes == 0 || num_bytes > max_bytes) {
+        return;
+    }
+
+    const auto key_it = key_entries.find(key);
+    if(key_it != key_entries.end()) {
+        erase(key_it->second);
+    }
+
+    entries.push_front({key, std::move(field_epochs), std::move(shared_ids), num_bytes});
+    key_entries.emplace(key, entries.begin());
+    used_bytes += num_bytes;
+
+    while(used_bytes > max_bytes) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+void filter_result_cache_t::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    key_entries.clear();
+    used_bytes = 0;
+}
+
+size_t filter_result_cache_t::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+size_t filter_result_cache_t::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return used_bytes;
+}
@@ -15,6 +15,11 @@
 #include "collection_manager.h"
 #include <variant>
 
+inline uint64_t get_time_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void copy_references_helper(const std::map<std::string, reference_filter_result_t>* from,
                             std::map<std::string, reference_filter_result_t>*& to, const uint32_t& count) {
     if (from == nullptr || count == 0) {
@@ -508,6 +513,96 @@ void filter_result_iterator_t::or_filter_iterators() {
     validity = invalid;
 }
 
+int collect_affix_posting_lists(void* data, const unsigned char* key, uint32_t key_len, void* value) {
+    auto raw_posting_lists = static_cast<std::vector<void*>*>(data);
+    raw_posting_lists->push_back(value);
+
+    // one more than the limit is collected, so that exceeding it can be told apart from reaching it
+    return raw_posting_lists->size() > affix_filter_max_tokens ? 1 : 0;
+}
+
+Option<bool> filter_result_iterator_t::init_affix_string_filter(const field& f, const std::string& filter_value,
+                                                                const NUM_COMPARATOR& comparator) {
+    const auto& symbols = f.symbols_to_index.empty() ? index->symbols_to_index : f.symbols_to_index;
+    const auto& separators = f.token_separators.empty() ? index->token_separators : f.token_separators;
+    // a prefix or suffix is a part of a word, which is not stemmed
+    Tokenizer tokenizer(filter_value, true, false, f.locale, symbols, separators, nullptr);
+
+    std::vector<std::string> str_tokens;
+    std::string str_token;
+    size_t token_index = 0;
+    while (tokenizer.next(str_token, token_index)) {
+        str_tokens.push_back(str_token);
+    }
+
+    if (str_tokens.empty()) {
+        return Option<bool>(400, "Error with filter field `" + f.name + "`: Filter value cannot be empty.");
+    } else if (str_tokens.size() > 1) {
+        return Option<bool>(400, "Error with filter field `" + f.name + "`: The value `" + filter_value +
+                                 "` of a prefix or suffix filter must be a single token.");
+    }
+
+    const auto& affix = str_tokens[0];
+    art_tree* t = index->search_index.at(f.name);
+    std::vector<void*> raw_posting_lists;
+
+    if (comparator == STARTS_WITH) {
+        art_iter_prefix(t, (const unsigned char*) affix.c_str(), affix.size(), collect_affix_posting_lists,
+                        &raw_posting_lists);
+    } else {
+        const auto infix_it = index->infix_index.find(f.name);
+        if (infix_it == index->infix_index.end()) {
+            return Option<bool>(400, "Error with filter field `" + f.name + "`: Suffix filters need the infix index "
+                                     "of the field. Make sure to enable it by specifying `infix: true` in the schema.");
+        }
+
+        // The infix index has no order by suffix, so every token of the field is compared with the suffix.
+        std::string key_buffer;
+        for (const auto infix_set: infix_it->second) {
+            for (auto it = infix_set->begin(); it != infix_set->end() &&
+                                               raw_posting_lists.size() <= affix_filter_max_tokens; it++) {
+                it.key(key_buffer);
+                if (key_buffer.size() < affix.size() ||
+                    key_buffer.compare(key_buffer.size() - affix.size(), affix.size(), affix) != 0) {
+                    continue;
+                }
+
+                auto const leaf = (art_leaf*) art_search(t, (const unsigned char*) key_buffer.c_str(),
+                                                         key_buffer.size() + 1);
+                if (leaf != nullptr) {
+                    raw_posting_lists.push_back(leaf->values);
+                }
+            }
+        }
+    }
+
+    if (raw_posting_lists.size() > affix_filter_max_tokens) {
+        return Option<bool>(400, "Error with filter field `" + f.name + "`: The " +
+                                 (comparator == STARTS_WITH ? "prefix" : "suffix") + " `" + affix + "` matches more than " +
+                                 std::to_string(affix_filter_max_tokens) + " tokens. Use a longer " +
+                                 (comparator == STARTS_WITH ? "prefix." : "suffix."));
+    }
+
+    // The lists are OR-ed like the values of an IN-list.
+    for (const auto raw_posting_list: raw_posting_lists) {
+        std::vector<posting_list_t*> plists;
+        posting_t::to_expanded_plists({raw_posting_list}, plists, expanded_plists);
+        if (plists.empty()) {
+            continue;
+        }
+
+        posting_lists.push_back(plists);
+        posting_list_iterators.emplace_back(std::vector<posting_list_t::iterator_t>());
+        for (auto const& plist: plists) {
+            posting_list_iterators.back().push_back(plist->new_iterator());
+        }
+
+        approx_filter_ids_length += posting_t::num_ids(raw_posting_list);
+    }
+
+    return Option<bool>(true);
+}
+
 void filter_result_iterator_t::advance_string_filter_token_iterators() {
     for (uint32_t i = 0; i < posting_list_iterators.size(); i++) {
         auto& filter_value_tokens = posting_list_iterators[i];
@@ -831,6 +926,17 @@ void filter_result_iterator_t::next() {
         return;
     }
 
+    if (dense_result != nullptr) {
+        auto const next_id = dense_result->next(seq_id + 1);
+        if (next_id == UINT32_MAX) {
+            validity = invalid;
+            return;
+        }
+
+        seq_id = next_id;
+        return;
+    }
+
     // No need to traverse iterator tree if there's only one filter or compute_iterators() has been called.
     if (is_filter_result_initialized) {
         if (++result_index >= filter_result.count) {
@@ -872,6 +978,12 @@ void filter_result_iterator_t::next() {
         return;
     }
 
+    if (is_complement_iterator) {
+        all_seq_ids_iterator.next();
+        skip_complement_excluded_ids();
+        return;
+    }
+
     const filter a_filter = filter_node->filter_exp;
 
     if (a_filter.field_name == "id") {
@@ -951,12 +1063,48 @@ void apply_not_equals(uint32_t*&& all_ids,
     result_ids_len = to_include_ids_len;
 }
 
+/// Merges the sorted runs into result_ids and clears the runs.
+void or_sorted_runs(std::vector<std::vector<uint32_t>>& runs,
+                    uint32_t*& result_ids,
+                    size_t& result_ids_len) {
+    if (runs.empty()) {
+        return;
+    }
+
+    uint32_t* merged_ids = nullptr;
+    auto const merged_ids_len = ArrayUtils::or_sorted_runs(runs, &merged_ids);
+    std::vector<std::vector<uint32_t>>().swap(runs);  // clears out memory
+
+    if (result_ids == nullptr) {
+        result_ids = merged_ids;
+        result_ids_len = merged_ids_len;
+        return;
+    }
+
+    uint32_t* out = nullptr;
+    result_ids_len = ArrayUtils::or_scalar(result_ids, result_ids_len, merged_ids, merged_ids_len, &out);
+
+    delete[] result_ids;
+    delete[] merged_ids;
+    result_ids = out;
+}
+
 void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bool& validate_field_names) {
     if (filter_node == nullptr) {
         return;
     }
 
     if (filter_node->isOperator) {
+        if (filter_node->is_object_filter_root) {
+            // Compiled once, before it's validated against any document.
+            auto compile_op = object_filter_t::compile(index->search_schema, filter_node, object_filter);
+            if (!compile_op.ok()) {
+                status = Option<bool>(compile_op.code(), compile_op.error());
+                validity = invalid;
+                return;
+            }
+        }
+
         if (filter_node->filter_operator == AND) {
             approx_filter_ids_length = std::min(left_it->approx_filter_ids_length, right_it->approx_filter_ids_length);
             if (approx_filter_ids_length < COMPUTE_FILTER_ITERATOR_THRESHOLD) {
@@ -1031,7 +1179,14 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
                 return;
             }
 
-            if (negate_left_join_info.is_negate_join) {
+            if (negate_left_join_info.is_negate_join && enable_lazy_evaluation) {
+                // The docs matched by the join have no excluded reference, so they are a subset of the complement
+                // and only their references are needed.
+                init_complement_iterator(std::vector<uint32_t>(negate_left_join_info.excluded_ids.get(),
+                                                               negate_left_join_info.excluded_ids.get() +
+                                                               negate_left_join_info.excluded_ids_size));
+                return;
+            } else if (negate_left_join_info.is_negate_join) {
                 auto index_ids = index->seq_ids->uncompress();
                 uint32_t* left_included_ids = nullptr;
                 size_t left_included_ids_length = ArrayUtils::exclude_scalar(index_ids, index->seq_ids->num_ids(),
@@ -1123,6 +1278,12 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
             }
 
             std::sort(result_ids.begin(), result_ids.end());
+            result_ids.erase(std::unique(result_ids.begin(), result_ids.end()), result_ids.end());
+
+            if (a_filter.apply_not_equals && enable_lazy_evaluation) {
+                init_complement_iterator(std::move(result_ids));
+                return;
+            }
 
             filter_result.count = result_ids.size();
             filter_result.docs = new uint32_t[result_ids.size()];
@@ -1297,6 +1458,8 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
                     seq_id = 0;
                 }
                 last_valid_id = index->seq_ids->last_id();
+
+                init_min_max_key_ranges(f, a_filter);
             } else {
                 if (a_filter.apply_not_equals) {
                     apply_not_equals(index->seq_ids->uncompress(), index->seq_ids->num_ids(),
@@ -1316,6 +1479,24 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
         }
         return;
     } else if (f.is_float()) {
+        if ((f.range_index || !enable_lazy_evaluation) && float_column_range_search(index, a_filter, filter_result)) {
+            if (a_filter.apply_not_equals) {
+                apply_not_equals(index->seq_ids->uncompress(), index->seq_ids->num_ids(),
+                                 filter_result.docs, filter_result.count);
+            }
+
+            is_filter_result_initialized = true;
+
+            if (filter_result.count == 0) {
+                validity = invalid;
+                return;
+            }
+
+            seq_id = filter_result.docs[result_index];
+            approx_filter_ids_length = filter_result.count;
+            return;
+        }
+
         if (f.range_index) {
             auto const& trie = index->range_index.at(a_filter.field_name);
 
@@ -1455,6 +1636,8 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
                     seq_id = 0;
                 }
                 last_valid_id = index->seq_ids->last_id();
+
+                init_min_max_key_ranges(f, a_filter);
             } else {
                 if (a_filter.apply_not_equals) {
                     apply_not_equals(index->seq_ids->uncompress(), index->seq_ids->num_ids(),
@@ -1739,8 +1922,26 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
     } else if (f.is_string()) {
         art_tree* t = index->search_index.at(a_filter.field_name);
 
+        // A long list of values tends to repeat tokens and values, so each distinct token is searched once and each
+        // distinct value only gets one set of posting lists.
+        std::unordered_map<std::string, art_leaf*> token_leaves;
+        std::set<std::pair<bool, std::vector<std::string>>> searched_values;
+
         for (uint32_t i = 0; i < a_filter.values.size(); i++) {
             auto filter_value = a_filter.values[i];
+            auto const& comparator = i < a_filter.comparators.size() ? a_filter.comparators[i] : a_filter.comparators[0];
+
+            if (comparator == STARTS_WITH || comparator == ENDS_WITH) {
+                auto affix_op = init_affix_string_filter(f, filter_value, comparator);
+                if (!affix_op.ok()) {
+                    status = Option<bool>(affix_op.code(), affix_op.error());
+                    validity = invalid;
+                    return;
+                }
+
+                continue;
+            }
+
             auto is_prefix_match = filter_value.size() > 1 && filter_value[filter_value.size() - 1] == '*';
             if (is_prefix_match) {
                 filter_value.erase(filter_value.size() - 1);
@@ -1770,8 +1971,14 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
                     continue;
                 }
 
-                art_leaf* leaf = (art_leaf *) art_search(t, (const unsigned char*) str_token.c_str(),
-                                                         str_token.length()+1);
+                auto leaf_it = token_leaves.find(str_token);
+                if (leaf_it == token_leaves.end()) {
+                    auto const leaf = (art_leaf *) art_search(t, (const unsigned char*) str_token.c_str(),
+                                                              str_token.length()+1);
+                    leaf_it = token_leaves.emplace(str_token, leaf).first;
+                }
+
+                art_leaf* leaf = leaf_it->second;
                 if (leaf == nullptr) {
                     continue;
                 }
@@ -1787,6 +1994,10 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
                 return;
             }
 
+            if (!searched_values.emplace(is_prefix_match, str_tokens).second) {
+                continue;
+            }
+
             if (is_prefix_match) {
                 std::vector<search_field_t> fq_fields;
                 fq_fields.emplace_back(f.name, f.name, 1, 0, true, enable_t::off);
@@ -1892,18 +2103,22 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
             approx_filter_ids_length += approx_filter_value_match;
         }
 
+        // A lazy OR steps through the iterators of every value for each id, so a filter that expands into many
+        // values, e.g. a short prefix or suffix, is materialized instead.
+        const bool has_many_values = posting_list_iterators.size() > string_filter_max_lazy_values;
+
         if (a_filter.apply_not_equals) {
             auto const& num_ids = index->seq_ids->num_ids();
             approx_filter_ids_length = approx_filter_ids_length >= num_ids ? num_ids : (num_ids - approx_filter_ids_length);
 
-            if (approx_filter_ids_length < string_filter_ids_threshold) {
+            if (approx_filter_ids_length < string_filter_ids_threshold || has_many_values) {
                 // Since there are very few matches, and we have to apply not equals, iteration will be inefficient.
                 compute_iterators();
                 return;
             } else {
                 is_not_equals_iterator = true;
             }
-        } else if (approx_filter_ids_length < string_filter_ids_threshold) {
+        } else if (approx_filter_ids_length < string_filter_ids_threshold || has_many_values) {
             compute_iterators();
             return;
         }
@@ -1919,6 +2134,21 @@ void filter_result_iterator_t::init(const bool& enable_lazy_evaluation, const bo
 }
 
 void filter_result_iterator_t::skip_to(uint32_t id) {
+    if (dense_result != nullptr) {
+        if (id <= seq_id) {
+            return;
+        }
+
+        auto const next_id = dense_result->next(id);
+        if (next_id == UINT32_MAX) {
+            validity = invalid;
+            return;
+        }
+
+        seq_id = next_id;
+        return;
+    }
+
     if (is_filter_result_initialized) {
         ArrayUtils::skip_index_to_id(result_index, filter_result.docs, filter_result.count, id);
 
@@ -1937,6 +2167,16 @@ void filter_result_iterator_t::skip_to(uint32_t id) {
         return;
     }
 
+    if (is_complement_iterator) {
+        if (id <= seq_id) {
+            return;
+        }
+
+        all_seq_ids_iterator.skip_to(id);
+        skip_complement_excluded_ids();
+        return;
+    }
+
     const filter a_filter = filter_node->filter_exp;
 
     if (a_filter.field_name == "id") {
@@ -2135,6 +2375,11 @@ int filter_result_iterator_t::is_valid(uint32_t id, const bool& curation_timeout
 
     // No need to traverse iterator tree if there's only one filter or compute_iterators() has been called.
     if (is_filter_result_initialized) {
+        if (dense_result != nullptr && id >= seq_id && dense_result->contains(id)) {
+            seq_id = id;
+            return 1;
+        }
+
         skip_to(id);
         return validity ? (seq_id == id ? 1 : 0) : -1;
     }
@@ -2227,6 +2472,11 @@ int filter_result_iterator_t::is_valid(uint32_t id, const bool& curation_timeout
         }
     }
 
+    if (is_complement_iterator) {
+        skip_to(id);
+        return validity ? (seq_id == id ? 1 : 0) : -1;
+    }
+
     if (is_not_equals_iterator) {
         if (id > last_valid_id) {
             validity = invalid;
@@ -2259,7 +2509,7 @@ int filter_result_iterator_t::is_valid(uint32_t id, const bool& curation_timeout
 }
 
 Option<bool> filter_result_iterator_t::init_status() {
-    if (is_filter_result_initialized) {
+    if (is_filter_result_initialized || !status.ok()) {
         return status;
     } else if (filter_node != nullptr && filter_node->isOperator) {
         auto left_status = left_it->init_status();
@@ -2354,6 +2604,12 @@ void filter_result_iterator_t::reset(const bool& curation_timeout) {
             return;
         }
 
+        if (dense_result != nullptr) {
+            seq_id = dense_result->next(0);
+            validity = valid;
+            return;
+        }
+
         result_index = 0;
         seq_id = filter_result.docs[result_index];
 
@@ -2382,6 +2638,15 @@ void filter_result_iterator_t::reset(const bool& curation_timeout) {
         return;
     }
 
+    if (is_complement_iterator) {
+        all_seq_ids_iterator = index->seq_ids->new_iterator();
+        complement_excluded_index = 0;
+        result_index = 0;
+        validity = valid;
+        skip_complement_excluded_ids();
+        return;
+    }
+
     const filter a_filter = filter_node->filter_exp;
 
     if (a_filter.field_name == "id") {
@@ -2450,6 +2715,10 @@ uint32_t filter_result_iterator_t::to_filter_id_array(uint32_t*& filter_array) {
         return 0;
     }
 
+    if (dense_result != nullptr) {
+        return dense_result->to_ids(filter_array);
+    }
+
     filter_array = new uint32_t[filter_result.count];
     std::copy(filter_result.docs, filter_result.docs + filter_result.count, filter_array);
     return filter_result.count;
@@ -2460,13 +2729,26 @@ uint32_t filter_result_iterator_t::and_scalar(const uint32_t* A, const uint32_t&
         return 0;
     }
 
-    if (is_filter_result_initialized) {
+    if (dense_result != nullptr) {
+        return dense_result->and_scalar(A, lenA, results);
+    } else if (is_filter_result_initialized) {
         return ArrayUtils::and_scalar(A, lenA, filter_result.docs, filter_result.count, &results);
     }
 
     std::vector<uint32_t> filter_ids;
     for (uint32_t i = 0; i < lenA; i++) {
         auto const& id = A[i];
+
+        if (min_max_column != nullptr) {
+            auto const bounds_match = match_min_max(id);
+            if (bounds_match == min_max_column_t::no_match) {
+                continue;
+            } else if (bounds_match == min_max_column_t::match) {
+                filter_ids.push_back(id);
+                continue;
+            }
+        }
+
         auto const& result = is_valid(id);
 
         if (result == 1) {
@@ -2492,7 +2774,10 @@ void filter_result_iterator_t::and_scalar(const uint32_t* A, const uint32_t& len
     }
 
     if (filter_result.coll_to_references == nullptr) {
-        if (is_filter_result_initialized) {
+        if (dense_result != nullptr) {
+            result.count = dense_result->and_scalar(A, lenA, result.docs);
+            return;
+        } else if (is_filter_result_initialized) {
             result.count = ArrayUtils::and_scalar(A, lenA, filter_result.docs, filter_result.count, &result.docs);
             return;
         }
@@ -2500,6 +2785,17 @@ void filter_result_iterator_t::and_scalar(const uint32_t* A, const uint32_t& len
         std::vector<uint32_t> filter_ids;
         for (uint32_t i = 0; i < lenA; i++) {
             auto const& id = A[i];
+
+            if (min_max_column != nullptr) {
+                auto const bounds_match = match_min_max(id);
+                if (bounds_match == min_max_column_t::no_match) {
+                    continue;
+                } else if (bounds_match == min_max_column_t::match) {
+                    filter_ids.push_back(id);
+                    continue;
+                }
+            }
+
             auto const& _result = is_valid(id);
 
             if (_result == 1) {
@@ -2548,117 +2844,858 @@ void filter_result_iterator_t::and_scalar(const uint32_t* A, const uint32_t& len
     }
 }
 
-filter_result_iterator_t::filter_result_iterator_t(const std::string& collection_name, const Index *const index,
-                                                   const filter_node_t *const filter_node,
-                                                   const bool& enable_lazy_evaluation, const size_t& max_candidates,
-                                                   uint64_t search_begin, uint64_t search_stop,
-                                                   const bool& validate_field_names)  :
-        collection_name(collection_name),
-        index(index),
-        filter_node(filter_node) {
-    if (filter_node == nullptr) {
-        validity = invalid;
-        return;
-    }
-
-    // Only initialize timeout_info in the root node. We won't pass search_begin/search_stop parameters to the sub-nodes.
-    if (search_stop != UINT64_MAX) {
-        timeout_info = std::make_unique<filter_result_iterator_timeout_info>(search_begin, search_stop);
+uint32_t filter_result_iterator_t::estimate_filter_ids_length(Index const* const index,
+                                                              const filter_node_t* filter_node) {
+    if (index == nullptr || filter_node == nullptr) {
+        return UINT32_MAX;
     }
 
-    // Generate the iterator tree and then initialize each node.
     if (filter_node->isOperator) {
-        left_it = new filter_result_iterator_t(collection_name, index, filter_node->left, enable_lazy_evaluation,
-                                               max_candidates, validate_field_names);
-        // If left subtree of && operator is invalid, we don't have to evaluate its right subtree.
-        if (filter_node->filter_operator == AND && left_it->validity == invalid) {
-            validity = invalid;
-            is_filter_result_initialized = true;
-            delete left_it;
-            left_it = nullptr;
-            return;
+        auto const left_estimate = estimate_filter_ids_length(index, filter_node->left);
+        auto const right_estimate = estimate_filter_ids_length(index, filter_node->right);
+
+        if (filter_node->filter_operator == AND) {
+            return std::min(left_estimate, right_estimate);
+        } else if (left_estimate == UINT32_MAX || right_estimate == UINT32_MAX) {
+            return UINT32_MAX;
         }
 
-        right_it = new filter_result_iterator_t(collection_name, index, filter_node->right, enable_lazy_evaluation,
-                                                max_candidates, validate_field_names);
+        return (uint32_t) std::min<uint64_t>(uint64_t(left_estimate) + right_estimate, index->seq_ids->num_ids());
     }
 
-    max_filter_by_candidates = max_candidates;
+    const filter& a_filter = filter_node->filter_exp;
+    if (a_filter.is_ignored_filter || !a_filter.referenced_collection_name.empty() ||
+        filter_node->is_object_filter_root) {
+        return UINT32_MAX;
+    }
 
-    init(enable_lazy_evaluation, validate_field_names);
+    uint32_t const num_ids = index->seq_ids->num_ids();
 
-    if (!validity) {
-        this->approx_filter_ids_length = 0;
+    if (a_filter.field_name == "id") {
+        // Ids are resolved while parsing, so every value matches exactly one document.
+        auto const estimate = (!a_filter.values.empty() && a_filter.values.front() == "*") ? num_ids :
+                              std::min<uint32_t>(a_filter.values.size(), num_ids);
+        return a_filter.apply_not_equals ? num_ids - estimate : estimate;
     }
-}
 
-filter_result_iterator_t::~filter_result_iterator_t() {
-    // In case the filter was on string field.
-    for(auto expanded_plist: expanded_plists) {
-        delete expanded_plist;
+    auto const field_it = index->search_schema.find(a_filter.field_name);
+    if (field_it == index->search_schema.end()) {
+        return UINT32_MAX;
     }
 
-    // In case the filter was on int/float field.
-    for (auto item: expanded_id_lists) {
-        delete item;
+    if (field_it.value().is_string()) {
+        return estimate_string_filter_ids_length(index, field_it.value(), a_filter);
     }
 
-    if (delete_filter_node) {
-        delete filter_node;
-    }
+    if (field_it.value().is_bool()) {
+        auto const num_tree_it = index->numerical_index.find(a_filter.field_name);
+        if (num_tree_it == index->numerical_index.end()) {
+            return UINT32_MAX;
+        }
 
-    delete left_it;
-    delete right_it;
-}
+        uint64_t count = 0;
+        for (size_t fi = 0; fi < a_filter.values.size() && fi < a_filter.comparators.size(); fi++) {
+            auto const value_count = num_tree_it->second->approx_search_count(EQUALS,
+                                                                               a_filter.values[fi] == "1" ? 1 : 0);
+            count += a_filter.comparators[fi] == NOT_EQUALS ? num_ids - std::min(value_count, num_ids) : value_count;
+        }
 
-filter_result_iterator_t& filter_result_iterator_t::operator=(filter_result_iterator_t&& obj) noexcept {
-    if (&obj == this) {
-        return *this;
+        auto const estimate = (uint32_t) std::min<uint64_t>(count, num_ids);
+        return a_filter.apply_not_equals ? num_ids - estimate : estimate;
     }
 
-    // In case the filter was on string field.
-    for(auto expanded_plist: expanded_plists) {
-        delete expanded_plist;
+    auto const histogram_it = index->numeric_histogram_index.find(a_filter.field_name);
+    if (histogram_it == index->numeric_histogram_index.end()) {
+        return UINT32_MAX;
     }
 
-    delete left_it;
-    delete right_it;
+    auto const& histogram = histogram_it->second;
+    auto const is_float = field_it.value().is_float();
 
-    collection_name = obj.collection_name;
-    index = obj.index;
-    filter_node = obj.filter_node;
-    left_it = obj.left_it;
-    right_it = obj.right_it;
+    auto const to_int64 = [&is_float](const std::string& value) {
+        return is_float ? Index::float_to_int64_t((float) std::atof(value.c_str())) : (int64_t) std::stoll(value);
+    };
 
-    obj.left_it = nullptr;
-    obj.right_it = nullptr;
+    uint64_t count = 0;
+    for (size_t fi = 0; fi < a_filter.values.size() && fi < a_filter.comparators.size(); fi++) {
+        int64_t value;
+        try {
+            value = to_int64(a_filter.values[fi]);
+        } catch (...) {
+            return UINT32_MAX;
+        }
 
-    result_index = obj.result_index;
+        switch (a_filter.comparators[fi]) {
+            case EQUALS:
+                count += histogram->approx_equals_count(value);
+                break;
+            case NOT_EQUALS:
+                count += histogram->size() - histogram->approx_equals_count(value);
+                break;
+            case GREATER_THAN:
+                count += value == INT64_MAX ? 0 : histogram->approx_range_count(value + 1, INT64_MAX);
+                break;
+            case GREATER_THAN_EQUALS:
+                count += histogram->approx_range_count(value, INT64_MAX);
+                break;
+            case LESS_THAN:
+                count += value == INT64_MIN ? 0 : histogram->approx_range_count(INT64_MIN, value - 1);
+                break;
+            case LESS_THAN_EQUALS:
+                count += histogram->approx_range_count(INT64_MIN, value);
+                break;
+            case RANGE_INCLUSIVE:
+                if (fi + 1 < a_filter.values.size()) {
+                    int64_t range_end_value;
+                    try {
+                        range_end_value = to_int64(a_filter.values[fi + 1]);
+                    } catch (...) {
+                        return UINT32_MAX;
+                    }
 
-    filter_result = std::move(obj.filter_result);
+                    count += histogram->approx_range_count(value, range_end_value);
+                    fi++;
+                }
+                break;
+            default:
+                return UINT32_MAX;
+        }
+    }
 
-    posting_list_iterators = std::move(obj.posting_list_iterators);
-    expanded_plists = std::move(obj.expanded_plists);
+    // Histogram counts values, so the estimate of an array field can exceed the number of documents.
+    auto const estimate = (uint32_t) std::min<uint64_t>(count, num_ids);
 
-    validity = obj.validity;
+    return a_filter.apply_not_equals ? num_ids - estimate : estimate;
+}
 
-    seq_id = obj.seq_id;
-    reference = std::move(obj.reference);
-    status = std::move(obj.status);
-    is_filter_result_initialized = obj.is_filter_result_initialized;
+uint32_t filter_result_iterator_t::estimate_string_filter_ids_length(Index const* const index, const field& f,
+                                                                     const filter& a_filter) {
+    auto const tree_it = index->search_index.find(a_filter.field_name);
+    if (tree_it == index->search_index.end()) {
+        return UINT32_MAX;
+    }
 
-    approx_filter_ids_length = obj.approx_filter_ids_length;
+    auto const& symbols = f.symbols_to_index.empty() ? index->symbols_to_index : f.symbols_to_index;
+    auto const& separators = f.token_separators.empty() ? index->token_separators : f.token_separators;
+    auto const has_facet_values = f.facet && index->facet_index_v4->has_value_index(f.name);
 
-    return *this;
+    uint64_t count = 0;
+    for (size_t i = 0; i < a_filter.values.size(); i++) {
+        auto const& filter_value = a_filter.values[i];
+        if (filter_value.size() > 1 && filter_value.back() == '*') {
+            // The tokens a prefix expands into are only known once it is searched.
+            return UINT32_MAX;
+        }
+
+        auto const comparator = i < a_filter.comparators.size() ? a_filter.comparators[i] : CONTAINS;
+        if (comparator == STARTS_WITH || comparator == ENDS_WITH) {
+            return UINT32_MAX;
+        } else if (comparator == EQUALS && has_facet_values) {
+            count += index->facet_index_v4->facet_val_num_ids(f.name, filter_value);
+            continue;
+        }
+
+        // Tokens of a value get AND, so the shortest posting list bounds the number of matches.
+        Tokenizer tokenizer(filter_value, true, false, f.locale, symbols, separators, f.get_stemmer());
+        std::string str_token;
+        size_t token_index = 0;
+        uint32_t value_count = UINT32_MAX;
+
+        while (tokenizer.next(str_token, token_index)) {
+            if (str_token.size() > 100) {
+                str_token.erase(100);
+            }
+
+            auto const leaf = (art_leaf*) art_search(tree_it->second, (const unsigned char*) str_token.c_str(),
+                                                     str_token.length() + 1);
+            value_count = std::min<uint32_t>(value_count, leaf == nullptr ? 0 : posting_t::num_ids(leaf->values));
+        }
+
+        count += value_count == UINT32_MAX ? 0 : value_count;
+    }
+
+    uint32_t const num_ids = index->seq_ids->num_ids();
+    auto const estimate = (uint32_t) std::min<uint64_t>(count, num_ids);
+
+    return a_filter.apply_not_equals ? num_ids - estimate : estimate;
 }
 
-void filter_result_iterator_t::get_n_ids(const uint32_t& n, filter_result_t*& result, const bool& curation_timeout,
-                                         const bool& is_group_by_first_pass) {
-    if (!is_filter_result_initialized) {
+void filter_result_iterator_t::get_and_operands(filter_node_t* filter_node,
+                                                std::vector<filter_node_t*>& operator_nodes,
+                                                std::vector<filter_node_t*>& operands) {
+    if (!filter_node->isOperator || filter_node->filter_operator != AND || filter_node->is_object_filter_root) {
+        operands.push_back(filter_node);
         return;
     }
 
-    if (!curation_timeout && timeout_info != nullptr) {
+    operator_nodes.push_back(filter_node);
+    get_and_operands(filter_node->left, operator_nodes, operands);
+    get_and_operands(filter_node->right, operator_nodes, operands);
+}
+
+bool filter_result_iterator_t::has_reference_filter(const filter_node_t* filter_node) {
+    if (filter_node == nullptr) {
+        return false;
+    }
+
+    if (filter_node->isOperator) {
+        return has_reference_filter(filter_node->left) || has_reference_filter(filter_node->right);
+    }
+
+    return !filter_node->filter_exp.referenced_collection_name.empty();
+}
+
+void filter_result_iterator_t::reorder_filter_tree(Index const* const index, filter_node_t* const filter_node) {
+    if (index == nullptr || filter_node == nullptr || !filter_node->isOperator || filter_node->is_object_filter_root) {
+        return;
+    }
+
+    if (filter_node->filter_operator == OR) {
+        reorder_filter_tree(index, filter_node->left);
+        reorder_filter_tree(index, filter_node->right);
+        return;
+    }
+
+    std::vector<filter_node_t*> operator_nodes, operands;
+    get_and_operands(filter_node, operator_nodes, operands);
+
+    bool has_reference_operand = false;
+    std::vector<std::pair<uint32_t, filter_node_t*>> estimated_operands;
+    for (auto const& operand: operands) {
+        reorder_filter_tree(index, operand);
+
+        has_reference_operand = has_reference_operand || has_reference_filter(operand);
+        estimated_operands.emplace_back(estimate_filter_ids_length(index, operand), operand);
+    }
+
+    if (has_reference_operand) {
+        return;
+    }
+
+    std::stable_sort(estimated_operands.begin(), estimated_operands.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // The chain is rebuilt left-deep out of its own operator nodes, so that the root stays the root and the operands
+    // are constructed in the sorted order: ((o0 && o1) && o2) && ...
+    auto const num_operands = estimated_operands.size();
+    for (size_t i = 0; i < operator_nodes.size(); i++) {
+        operator_nodes[i]->right = estimated_operands[num_operands - 1 - i].second;
+        operator_nodes[i]->left = (i + 1 < operator_nodes.size()) ? operator_nodes[i + 1] :
+                                                                     estimated_operands[0].second;
+    }
+}
+
+bool filter_result_iterator_t::float_column_range_search(Index const* const index, const filter& a_filter,
+                                                         filter_result_t& result) {
+    auto const column_it = index->float_column_index.find(a_filter.field_name);
+    auto const histogram_it = index->numeric_histogram_index.find(a_filter.field_name);
+    if (column_it == index->float_column_index.end() || histogram_it == index->numeric_histogram_index.end()) {
+        return false;
+    }
+
+    auto const& column = column_it->second;
+    auto const& histogram = histogram_it->second;
+
+    std::vector<std::pair<int64_t, int64_t>> numeric_key_ranges;
+    if (!get_numeric_key_ranges(true, a_filter, numeric_key_ranges)) {
+        return false;
+    }
+
+    // Keys of float values fit in int32.
+    std::vector<std::pair<int32_t, int32_t>> key_ranges;
+    for (const auto& key_range: numeric_key_ranges) {
+        auto const start_key = std::max<int64_t>(key_range.first, INT32_MIN);
+        auto const end_key = std::min<int64_t>(key_range.second, INT32_MAX);
+
+        if (start_key <= end_key) {
+            key_ranges.emplace_back(start_key, end_key);
+        }
+    }
+
+    uint64_t estimate = 0;
+    for (const auto& key_range: key_ranges) {
+        estimate += histogram->approx_range_count(key_range.first, key_range.second);
+    }
+
+    if (key_ranges.empty() || estimate * float_column_scan_ratio < column->size()) {
+        return false;
+    }
+
+    std::vector<uint32_t> ids;
+    for (const auto& key_range: key_ranges) {
+        ids.clear();
+        column->range_search(key_range.first, key_range.second, ids);
+
+        uint32_t* merged = nullptr;
+        result.count = ArrayUtils::or_scalar(result.docs, result.count, ids.data(), ids.size(), &merged);
+
+        delete[] result.docs;
+        result.docs = merged;
+    }
+
+    return true;
+}
+
+bool filter_result_iterator_t::get_numeric_key_ranges(const bool& is_float, const filter& a_filter,
+                                                     std::vector<std::pair<int64_t, int64_t>>& key_ranges) {
+    auto const to_key = [&is_float](const std::string& value) {
+        return is_float ? Index::float_to_int64_t((float) std::atof(value.c_str())) : (int64_t) std::stoll(value);
+    };
+
+    for (size_t fi = 0; fi < a_filter.values.size() && fi < a_filter.comparators.size(); fi++) {
+        int64_t key;
+        try {
+            key = to_key(a_filter.values[fi]);
+        } catch (...) {
+            return false;
+        }
+
+        switch (a_filter.comparators[fi]) {
+            case EQUALS:
+                key_ranges.emplace_back(key, key);
+                break;
+            case GREATER_THAN:
+                if (key != INT64_MAX) {
+                    key_ranges.emplace_back(key + 1, INT64_MAX);
+                }
+                break;
+            case GREATER_THAN_EQUALS:
+                key_ranges.emplace_back(key, INT64_MAX);
+                break;
+            case LESS_THAN:
+                if (key != INT64_MIN) {
+                    key_ranges.emplace_back(INT64_MIN, key - 1);
+                }
+                break;
+            case LESS_THAN_EQUALS:
+                key_ranges.emplace_back(INT64_MIN, key);
+                break;
+            case RANGE_INCLUSIVE:
+                if (fi + 1 < a_filter.values.size()) {
+                    int64_t range_end_key;
+                    try {
+                        range_end_key = to_key(a_filter.values[fi + 1]);
+                    } catch (...) {
+                        return false;
+                    }
+
+                    key_ranges.emplace_back(key, range_end_key);
+                    fi++;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void filter_result_iterator_t::init_min_max_key_ranges(const field& f, const filter& a_filter) {
+    if (is_filter_result_initialized || is_not_equals_iterator || a_filter.apply_not_equals || !f.is_array()) {
+        return;
+    }
+
+    auto const column_it = index->min_max_index.find(a_filter.field_name);
+    if (column_it == index->min_max_index.end() ||
+        !get_numeric_key_ranges(f.is_float(), a_filter, min_max_key_ranges) || min_max_key_ranges.empty()) {
+        min_max_key_ranges.clear();
+        return;
+    }
+
+    min_max_column = column_it->second;
+}
+
+min_max_column_t::range_match_t filter_result_iterator_t::match_min_max(const uint32_t& id) const {
+    auto result = min_max_column_t::no_match;
+
+    for (const auto& key_range: min_max_key_ranges) {
+        auto const range_match = min_max_column->match_range(id, key_range.first, key_range.second);
+
+        if (range_match == min_max_column_t::match) {
+            return min_max_column_t::match;
+        } else if (range_match == min_max_column_t::maybe_match) {
+            result = min_max_column_t::maybe_match;
+        }
+    }
+
+    return result;
+}
+
+bool filter_result_iterator_t::is_lazy_numeric_filter(Index const* const index, const filter_node_t* filter_node) {
+    if (index == nullptr || filter_node == nullptr || filter_node->isOperator) {
+        return false;
+    }
+
+    const filter& a_filter = filter_node->filter_exp;
+    if (a_filter.is_ignored_filter || a_filter.apply_not_equals || !a_filter.referenced_collection_name.empty() ||
+        index->numerical_index.count(a_filter.field_name) == 0) {
+        return false;
+    }
+
+    auto const field_it = index->search_schema.find(a_filter.field_name);
+    if (field_it == index->search_schema.end() || field_it.value().range_index ||
+        !(field_it.value().is_integer() || field_it.value().is_float())) {
+        return false;
+    }
+
+    return std::find(a_filter.comparators.begin(), a_filter.comparators.end(), NOT_EQUALS) == a_filter.comparators.end();
+}
+
+filter_result_iterator_t::filter_result_iterator_t(const std::string& collection_name, const Index *const index,
+                                                   const filter_node_t *const filter_node,
+                                                   const bool& enable_lazy_evaluation, const size_t& max_candidates,
+                                                   uint64_t search_begin, uint64_t search_stop,
+                                                   const bool& validate_field_names,
+                                                   filter_result_cache_t* filter_cache,
+                                                   nlohmann::json* plan,
+                                                   filter_profile_t* profile)  :
+        collection_name(collection_name),
+        index(index),
+        filter_node(filter_node),
+        filter_cache(filter_cache) {
+    if (filter_node == nullptr) {
+        validity = invalid;
+        return;
+    }
+
+    // The sub-nodes of an object filter are validated together against each object, so they are profiled as a whole.
+    if (profile != nullptr && (!filter_node->isOperator || filter_node->is_object_filter_root)) {
+        profile->clauses.emplace_back();
+        profile_clause = &profile->clauses.back();
+        profile_clause->filter = filter_node->filter_query;
+        profile = nullptr;
+    }
+    auto const profile_begin_us = profile_clause == nullptr ? 0 : get_time_us();
+
+    std::vector<std::string> filter_cache_fields;
+    if (filter_cache != nullptr &&
+        get_filter_cache_key(filter_node, filter_cache_key, filter_cache_fields)) {
+        // String values are expanded into a limited number of candidates, so the limit is a part of the key.
+        filter_cache_key = std::to_string(max_candidates) + ":" + filter_cache_key;
+
+        std::shared_ptr<const std::vector<uint32_t>> cached_ids;
+        if (filter_cache->lookup(filter_cache_key, cached_ids)) {
+            filter_cache_key.clear();
+            max_filter_by_candidates = max_candidates;
+
+            filter_result.count = approx_filter_ids_length = cached_ids->size();
+            filter_result.docs = new uint32_t[cached_ids->size()];
+            std::copy(cached_ids->begin(), cached_ids->end(), filter_result.docs);
+            is_filter_result_initialized = true;
+
+            if (filter_result.count == 0) {
+                validity = invalid;
+            } else {
+                seq_id = filter_result.docs[result_index];
+                to_dense_result();
+            }
+
+            if (search_stop != UINT64_MAX) {
+                timeout_info = std::make_unique<filter_result_iterator_timeout_info>(search_begin, search_stop);
+            }
+
+            if (plan != nullptr) {
+                explain(plan, estimate_filter_ids_length(index, filter_node));
+                (*plan)["cached"] = true;
+            }
+
+            if (profile_clause != nullptr) {
+                profile_clause->is_cached = true;
+                update_profile_clause(profile_begin_us);
+            }
+            return;
+        }
+
+        filter_cache_epochs = filter_cache->get_epochs(filter_cache_fields);
+    } else {
+        filter_cache_key.clear();
+    }
+
+    // Only initialize timeout_info in the root node. We won't pass search_begin/search_stop parameters to the sub-nodes.
+    if (search_stop != UINT64_MAX) {
+        timeout_info = std::make_unique<filter_result_iterator_timeout_info>(search_begin, search_stop);
+    }
+
+    // Children of the plan are listed in the order of their evaluation.
+    nlohmann::json* left_plan = nullptr;
+    nlohmann::json* right_plan = nullptr;
+    if (plan != nullptr && filter_node->isOperator) {
+        (*plan)["children"] = nlohmann::json::array({nlohmann::json::object(), nlohmann::json::object()});
+        left_plan = &(*plan)["children"][0];
+        right_plan = &(*plan)["children"][1];
+    }
+
+    // Generate the iterator tree and then initialize each node.
+    if (filter_node->isOperator) {
+        auto left_node = filter_node->left;
+        auto right_node = filter_node->right;
+        bool lazy_right_subtree = enable_lazy_evaluation;
+        bool is_right_subtree_probed = false;
+
+        // Build the more selective subtree of && operator first so that the other subtree can be skipped when it
+        // doesn't match any document. A much broader numeric subtree is evaluated lazily so that it is only probed
+        // with the ids of its sibling instead of being materialized.
+        if (filter_node->filter_operator == AND && !filter_node->is_object_filter_root) {
+            auto left_estimate = estimate_filter_ids_length(index, left_node);
+            auto right_estimate = estimate_filter_ids_length(index, right_node);
+
+            if (right_estimate < left_estimate) {
+                std::swap(left_node, right_node);
+                std::swap(left_estimate, right_estimate);
+            }
+
+            if (right_estimate != UINT32_MAX && right_estimate / filter_probe_selectivity_ratio > left_estimate &&
+                is_lazy_numeric_filter(index, right_node)) {
+                lazy_right_subtree = true;
+                is_right_subtree_probed = true;
+            }
+        }
+
+        left_it = new filter_result_iterator_t(collection_name, index, left_node, enable_lazy_evaluation,
+                                               max_candidates, 0, UINT64_MAX, validate_field_names, filter_cache,
+                                               left_plan, profile);
+        // If left subtree of && operator is invalid, we don't have to evaluate its right subtree.
+        if (filter_node->filter_operator == AND && left_it->validity == invalid) {
+            validity = invalid;
+            is_filter_result_initialized = true;
+            delete left_it;
+            left_it = nullptr;
+            add_to_filter_cache();
+
+            if (plan != nullptr) {
+                (*plan)["children"].erase(1);
+                explain(plan, estimate_filter_ids_length(index, filter_node));
+                (*plan)["short_circuited"] = true;
+            }
+            return;
+        }
+
+        right_it = new filter_result_iterator_t(collection_name, index, right_node, lazy_right_subtree,
+                                                max_candidates, 0, UINT64_MAX, validate_field_names, filter_cache,
+                                                right_plan, profile);
+
+        if (right_plan != nullptr && is_right_subtree_probed && !right_it->is_filter_result_initialized) {
+            (*right_plan)["strategy"] = "probe";
+        }
+    }
+
+    max_filter_by_candidates = max_candidates;
+
+    auto const built_left_it = left_it;
+    init(enable_lazy_evaluation, validate_field_names);
+
+    if (!validity) {
+        this->approx_filter_ids_length = 0;
+    }
+
+    add_to_filter_cache();
+    to_dense_result();
+
+    if (plan != nullptr) {
+        // `init` moves the subtree that is expected to match fewer ids to the left.
+        if (left_it != nullptr && left_it != built_left_it) {
+            std::swap((*plan)["children"][0], (*plan)["children"][1]);
+        }
+
+        explain(plan, estimate_filter_ids_length(index, filter_node));
+    }
+
+    update_profile_clause(profile_begin_us);
+}
+
+void filter_result_iterator_t::init_complement_iterator(std::vector<uint32_t>&& excluded_ids) {
+    is_complement_iterator = true;
+    complement_excluded_ids = std::move(excluded_ids);
+    complement_excluded_index = 0;
+    result_index = 0;
+
+    auto const& num_ids = index->seq_ids->num_ids();
+    approx_filter_ids_length = complement_excluded_ids.size() >= num_ids ? 0 :
+                                    num_ids - complement_excluded_ids.size();
+
+    all_seq_ids_iterator = index->seq_ids->new_iterator();
+    validity = valid;
+    skip_complement_excluded_ids();
+}
+
+void filter_result_iterator_t::skip_complement_excluded_ids() {
+    while (all_seq_ids_iterator.valid()) {
+        auto const id = all_seq_ids_iterator.id();
+        ArrayUtils::skip_index_to_id(complement_excluded_index, complement_excluded_ids.data(),
+                                     complement_excluded_ids.size(), id);
+
+        if (complement_excluded_index < complement_excluded_ids.size() &&
+            complement_excluded_ids[complement_excluded_index] == id) {
+            all_seq_ids_iterator.next();
+            continue;
+        }
+
+        seq_id = equals_iterator_id = id;
+
+        reference.clear();
+        if (filter_result.coll_to_references != nullptr) {
+            ArrayUtils::skip_index_to_id(result_index, filter_result.docs, filter_result.count, id);
+            if (result_index < filter_result.count && filter_result.docs[result_index] == id) {
+                auto& ref = filter_result.coll_to_references[result_index];
+                reference.insert(ref.begin(), ref.end());
+            }
+        }
+        return;
+    }
+
+    validity = invalid;
+}
+
+void filter_result_iterator_t::compute_complement_result() {
+    uint32_t* included_ids = nullptr;
+    auto const all_ids = index->seq_ids->uncompress();
+    auto const included_ids_length = ArrayUtils::exclude_scalar(all_ids, index->seq_ids->num_ids(),
+                                                                complement_excluded_ids.data(),
+                                                                complement_excluded_ids.size(), &included_ids);
+    delete [] all_ids;
+
+    auto complement_result = filter_result_t(included_ids_length, included_ids);
+    if (filter_result.coll_to_references != nullptr) {
+        filter_result_t final_result;
+        filter_result_t::or_filter_results(complement_result, filter_result, final_result);
+        filter_result = std::move(final_result);
+    } else {
+        filter_result = std::move(complement_result);
+    }
+
+    is_complement_iterator = false;
+    std::vector<uint32_t>().swap(complement_excluded_ids);
+    is_filter_result_initialized = true;
+
+    if (filter_result.count == 0) {
+        validity = invalid;
+        return;
+    }
+
+    validity = valid;
+    result_index = 0;
+    seq_id = filter_result.docs[result_index];
+    approx_filter_ids_length = filter_result.count;
+
+    reference.clear();
+    if (filter_result.coll_to_references != nullptr) {
+        auto& ref = filter_result.coll_to_references[result_index];
+        reference.insert(ref.begin(), ref.end());
+    }
+}
+
+void filter_result_iterator_t::update_profile_clause(const uint64_t& begin_us) {
+    if (profile_clause == nullptr) {
+        return;
+    }
+
+    profile_clause->time_us += get_time_us() - begin_us;
+    profile_clause->is_materialized = is_filter_result_initialized;
+    profile_clause->num_ids = is_filter_result_initialized ? filter_result.count : approx_filter_ids_length;
+    profile_clause->search_cutoff = profile_clause->search_cutoff || validity == timed_out;
+}
+
+void filter_result_iterator_t::explain(nlohmann::json* plan, const uint32_t& estimate) const {
+    if (filter_node->isOperator && !filter_node->is_object_filter_root) {
+        (*plan)["operator"] = filter_node->filter_operator == AND ? "&&" : "||";
+    } else {
+        (*plan)["filter"] = filter_node->filter_query;
+    }
+
+    if (estimate != UINT32_MAX) {
+        (*plan)["estimated_ids"] = estimate;
+    }
+
+    // A node that is not materialized is either iterated on its own or, when its sibling is much more selective,
+    // probed with the ids of its sibling.
+    if (is_filter_result_initialized) {
+        (*plan)["strategy"] = "materialize";
+    } else if (!plan->contains("strategy")) {
+        (*plan)["strategy"] = "iterate";
+    }
+
+    (*plan)["approx_ids"] = approx_filter_ids_length;
+}
+
+bool filter_result_iterator_t::get_filter_cache_key(const filter_node_t* filter_node, std::string& key,
+                                                    std::vector<std::string>& field_names) {
+    // An object filter is validated against the stored documents, and a reference filter against another collection.
+    if (filter_node->is_object_filter_root) {
+        return false;
+    }
+
+    if (filter_node->isOperator) {
+        std::string left_key, right_key;
+        if (!get_filter_cache_key(filter_node->left, left_key, field_names) ||
+            !get_filter_cache_key(filter_node->right, right_key, field_names)) {
+            return false;
+        }
+
+        // Operands are ordered so that `a && b` and `b && a` share an entry.
+        if (right_key < left_key) {
+            std::swap(left_key, right_key);
+        }
+
+        key = "(" + left_key + (filter_node->filter_operator == AND ? "&&" : "||") + right_key + ")";
+        return true;
+    }
+
+    const filter& a_filter = filter_node->filter_exp;
+    if (!a_filter.referenced_collection_name.empty() || a_filter.is_ignored_filter) {
+        return false;
+    }
+
+    key = a_filter.field_name;
+    key += a_filter.apply_not_equals ? ":!" : ":";
+
+    bool is_negated = a_filter.apply_not_equals;
+    for (size_t i = 0; i < a_filter.values.size(); i++) {
+        const auto comparator = (i < a_filter.comparators.size()) ? a_filter.comparators[i] : EQUALS;
+        is_negated = is_negated || comparator == NOT_EQUALS;
+
+        // values are prefixed with their length, so that no value can be mistaken for a separator
+        key += "[" + std::to_string(comparator) + "," + std::to_string(a_filter.values[i].size()) + "]" +
+               a_filter.values[i];
+    }
+
+    for (const auto& param: a_filter.params) {
+        key += param.dump();
+    }
+
+    field_names.push_back(a_filter.field_name);
+
+    // Negations and `id` filters match documents by their absence from the index of the field, so they also change
+    // whenever a document is added or removed.
+    if (is_negated || a_filter.field_name == "id") {
+        field_names.emplace_back("id");
+    }
+
+    return true;
+}
+
+void filter_result_iterator_t::add_to_filter_cache() {
+    if (filter_cache_key.empty() || !is_filter_result_initialized || validity == timed_out ||
+        filter_result.coll_to_references != nullptr) {
+        return;
+    }
+
+    std::vector<uint32_t> ids;
+    if (dense_result != nullptr) {
+        ids.reserve(filter_result.count);
+        dense_result->to_ids(0, filter_result.count, ids);
+    } else {
+        ids.assign(filter_result.docs, filter_result.docs + filter_result.count);
+    }
+
+    filter_cache->insert(filter_cache_key, std::move(filter_cache_epochs), std::move(ids));
+    filter_cache_key.clear();
+}
+
+void filter_result_iterator_t::to_dense_result() {
+    if (!is_filter_result_initialized || dense_result != nullptr || filter_result.count == 0 ||
+        filter_result.coll_to_references != nullptr || filter_node == nullptr || filter_node->is_object_filter_root ||
+        !id_bitset_t::is_dense(filter_result.count, filter_result.docs[filter_result.count - 1],
+                               dense_filter_result_min_ids, dense_filter_result_ratio)) {
+        return;
+    }
+
+    dense_result = std::make_unique<id_bitset_t>(filter_result.docs, filter_result.count);
+    delete[] filter_result.docs;
+    filter_result.docs = nullptr;
+}
+
+void filter_result_iterator_t::to_sparse_result() {
+    if (dense_result == nullptr) {
+        return;
+    }
+
+    filter_result.count = dense_result->to_ids(filter_result.docs);
+    dense_result.reset();
+
+    result_index = std::lower_bound(filter_result.docs, filter_result.docs + filter_result.count, seq_id) -
+                   filter_result.docs;
+}
+
+filter_result_iterator_t::~filter_result_iterator_t() {
+    // In case the filter was on string field.
+    for(auto expanded_plist: expanded_plists) {
+        delete expanded_plist;
+    }
+
+    // In case the filter was on int/float field.
+    for (auto item: expanded_id_lists) {
+        delete item;
+    }
+
+    if (delete_filter_node) {
+        delete filter_node;
+    }
+
+    delete left_it;
+    delete right_it;
+}
+
+filter_result_iterator_t& filter_result_iterator_t::operator=(filter_result_iterator_t&& obj) noexcept {
+    if (&obj == this) {
+        return *this;
+    }
+
+    // In case the filter was on string field.
+    for(auto expanded_plist: expanded_plists) {
+        delete expanded_plist;
+    }
+
+    delete left_it;
+    delete right_it;
+
+    collection_name = obj.collection_name;
+    index = obj.index;
+    filter_node = obj.filter_node;
+    left_it = obj.left_it;
+    right_it = obj.right_it;
+
+    obj.left_it = nullptr;
+    obj.right_it = nullptr;
+
+    result_index = obj.result_index;
+
+    filter_result = std::move(obj.filter_result);
+    dense_result = std::move(obj.dense_result);
+    object_filter = std::move(obj.object_filter);
+
+    all_seq_ids_iterator = std::move(obj.all_seq_ids_iterator);
+    is_complement_iterator = obj.is_complement_iterator;
+    complement_excluded_ids = std::move(obj.complement_excluded_ids);
+    complement_excluded_index = obj.complement_excluded_index;
+
+    posting_list_iterators = std::move(obj.posting_list_iterators);
+    expanded_plists = std::move(obj.expanded_plists);
+
+    validity = obj.validity;
+
+    seq_id = obj.seq_id;
+    reference = std::move(obj.reference);
+    status = std::move(obj.status);
+    is_filter_result_initialized = obj.is_filter_result_initialized;
+
+    approx_filter_ids_length = obj.approx_filter_ids_length;
+
+    filter_cache = obj.filter_cache;
+    filter_cache_key = std::move(obj.filter_cache_key);
+    profile_clause = obj.profile_clause;
+    filter_cache_epochs = std::move(obj.filter_cache_epochs);
+
+    return *this;
+}
+
+void filter_result_iterator_t::get_n_ids(const uint32_t& n, filter_result_t*& result, const bool& curation_timeout,
+                                         const bool& is_group_by_first_pass) {
+    if (!is_filter_result_initialized) {
+        return;
+    }
+
+    if (!curation_timeout && timeout_info != nullptr) {
         // In Index::search_wildcard number of calls to get_n_ids will be min(number of threads, filter match ids).
         // Therefore, `timeout_info->function_call_counter` won't reach `function_call_modulo` if only incremented on
         // function call.
@@ -2667,6 +3704,11 @@ void filter_result_iterator_t::get_n_ids(const uint32_t& n, filter_result_t*& re
         }
     }
 
+    if (dense_result != nullptr) {
+        uint32_t excluded_result_index = 0;
+        return get_n_dense_ids(n, excluded_result_index, nullptr, 0, result);
+    }
+
     auto result_length = result->count = std::min(n, filter_result.count - result_index);
     result->docs = new uint32_t[result_length];
     if (filter_result.coll_to_references != nullptr) {
@@ -2710,6 +3752,10 @@ void filter_result_iterator_t::get_n_ids(const uint32_t& n,
         }
     }
 
+    if (dense_result != nullptr) {
+        return get_n_dense_ids(n, excluded_result_index, excluded_result_ids, excluded_result_ids_size, result);
+    }
+
     std::vector<uint32_t> match_indexes;
     for (uint32_t count = 0; count < n && result_index < filter_result.count; result_index++) {
         auto id = filter_result.docs[result_index];
@@ -2740,6 +3786,32 @@ void filter_result_iterator_t::get_n_ids(const uint32_t& n,
     validity = result_index < filter_result.count ? valid : invalid;
 }
 
+void filter_result_iterator_t::get_n_dense_ids(const uint32_t& n, uint32_t& excluded_result_index,
+                                               uint32_t const* const excluded_result_ids,
+                                               const size_t& excluded_result_ids_size, filter_result_t*& result) {
+    std::vector<uint32_t> ids;
+    auto id = validity == invalid ? UINT32_MAX : seq_id;
+
+    while (ids.size() < n && id != UINT32_MAX) {
+        if (excluded_result_ids == nullptr ||
+            !ArrayUtils::skip_index_to_id(excluded_result_index, excluded_result_ids, excluded_result_ids_size, id)) {
+            ids.push_back(id);
+        }
+
+        id = dense_result->next(id + 1);
+    }
+
+    result->count = ids.size();
+    result->docs = new uint32_t[ids.size()];
+    std::copy(ids.begin(), ids.end(), result->docs);
+
+    if (id == UINT32_MAX) {
+        validity = invalid;
+    } else {
+        seq_id = id;
+    }
+}
+
 filter_result_iterator_t::filter_result_iterator_t(uint32_t approx_filter_ids_length) :
         approx_filter_ids_length(approx_filter_ids_length) {
     filter_node = new filter_node_t(AND, nullptr, nullptr);
@@ -2782,6 +3854,16 @@ void filter_result_iterator_t::add_phrase_ids(filter_result_iterator_t*& fit,
 }
 
 void filter_result_iterator_t::compute_iterators() {
+    auto const profile_begin_us = profile_clause == nullptr ? 0 : get_time_us();
+
+    compute_filter_result();
+    add_to_filter_cache();
+    to_dense_result();
+
+    update_profile_clause(profile_begin_us);
+}
+
+void filter_result_iterator_t::compute_filter_result() {
     if (filter_node == nullptr) {
         validity = invalid;
         is_filter_result_initialized = false;
@@ -2800,13 +3882,62 @@ void filter_result_iterator_t::compute_iterators() {
             left_it->timeout_info = std::make_unique<filter_result_iterator_timeout_info>(*timeout_info);
             right_it->timeout_info = std::make_unique<filter_result_iterator_timeout_info>(*timeout_info);
         }
-        left_it->compute_iterators();
-        right_it->compute_iterators();
 
-        if (filter_node->filter_operator == AND) {
-            filter_result_t::and_filter_results(left_it->filter_result, right_it->filter_result, filter_result);
+        auto selective_it = left_it;
+        auto broad_it = right_it;
+        if (selective_it->approx_filter_ids_length > broad_it->approx_filter_ids_length) {
+            std::swap(selective_it, broad_it);
+        }
+
+        // Instead of materializing a broad leaf of && operator, only the ids of its selective sibling are probed.
+        bool probe_broad_it = filter_node->filter_operator == AND && !broad_it->is_filter_result_initialized &&
+                              !broad_it->filter_node->isOperator &&
+                              broad_it->filter_node->filter_exp.referenced_collection_name.empty() &&
+                              broad_it->approx_filter_ids_length / filter_probe_selectivity_ratio >
+                                    selective_it->approx_filter_ids_length;
+        if (probe_broad_it) {
+            selective_it->compute_iterators();
+            selective_it->to_sparse_result();
+            probe_broad_it = selective_it->filter_result.coll_to_references == nullptr;
+        }
+
+        if (probe_broad_it) {
+            auto const profile_begin_us = broad_it->profile_clause == nullptr ? 0 : get_time_us();
+            broad_it->reset();
+            broad_it->and_scalar(selective_it->filter_result.docs, selective_it->filter_result.count, filter_result);
+            broad_it->update_profile_clause(profile_begin_us);
         } else {
-            filter_result_t::or_filter_results(left_it->filter_result, right_it->filter_result, filter_result);
+            left_it->compute_iterators();
+            right_it->compute_iterators();
+
+            if (left_it->dense_result != nullptr && right_it->dense_result != nullptr &&
+                !filter_node->is_object_filter_root) {
+                // Two dense results are combined a word at a time. The result is only kept as a bitset while it's dense.
+                dense_result = std::make_unique<id_bitset_t>();
+                if (filter_node->filter_operator == AND) {
+                    id_bitset_t::and_bitsets(*left_it->dense_result, *right_it->dense_result, *dense_result);
+                } else {
+                    id_bitset_t::or_bitsets(*left_it->dense_result, *right_it->dense_result, *dense_result);
+                }
+
+                filter_result.count = dense_result->size();
+                if (filter_result.count == 0) {
+                    dense_result.reset();
+                } else if (!id_bitset_t::is_dense(filter_result.count, dense_result->last_id(),
+                                                  dense_filter_result_min_ids, dense_filter_result_ratio)) {
+                    dense_result->to_ids(filter_result.docs);
+                    dense_result.reset();
+                }
+            } else {
+                left_it->to_sparse_result();
+                right_it->to_sparse_result();
+
+                if (filter_node->filter_operator == AND) {
+                    filter_result_t::and_filter_results(left_it->filter_result, right_it->filter_result, filter_result);
+                } else {
+                    filter_result_t::or_filter_results(left_it->filter_result, right_it->filter_result, filter_result);
+                }
+            }
         }
 
         if (left_it->validity == timed_out || right_it->validity == timed_out ||
@@ -2824,6 +3955,9 @@ void filter_result_iterator_t::compute_iterators() {
         // at least one document. If the full expression doesn't match any document, we return early in the search.
         if (filter_result.count == 0 && validity != timed_out) {
             validity = invalid;
+        } else if (dense_result != nullptr) {
+            seq_id = dense_result->next(0);
+            approx_filter_ids_length = filter_result.count;
         } else if (filter_result.count > 0) {
             result_index = 0;
             seq_id = filter_result.docs[result_index];
@@ -2844,6 +3978,11 @@ void filter_result_iterator_t::compute_iterators() {
         return;
     }
 
+    if (is_complement_iterator) {
+        compute_complement_result();
+        return;
+    }
+
     const filter a_filter = filter_node->filter_exp;
 
     if (a_filter.field_name == "id") {
@@ -2882,8 +4021,10 @@ void filter_result_iterator_t::compute_iterators() {
         uint32_t* filter_ids = nullptr;
         size_t filter_ids_len = 0;
 
-        // aggregates IDs to reduce excessive ORing
-        std::vector<uint32_t> f_id_buff;
+        // The ids of each list are sorted, so the lists are aggregated and merged with a k-way merge to reduce
+        // excessive ORing.
+        std::vector<std::vector<uint32_t>> list_ids;
+        size_t list_ids_len = 0;
 
         for (uint32_t i = 0; i < id_lists.size(); i++) {
             auto const& lists = id_lists[i];
@@ -2891,13 +4032,17 @@ void filter_result_iterator_t::compute_iterators() {
 
             if (lists.empty() && is_not_equals_comparator) {
                 auto all_ids = index->seq_ids->uncompress();
-                std::copy(all_ids, all_ids + index->seq_ids->num_ids(), std::back_inserter(f_id_buff));
+                list_ids.emplace_back(all_ids, all_ids + index->seq_ids->num_ids());
+                list_ids_len += list_ids.back().size();
                 delete[] all_ids;
 
                 continue;
             }
 
             for (const auto& list: lists) {
+                list_ids.emplace_back();
+                auto& f_id_buff = list_ids.back();
+
                 if (is_not_equals_comparator) {
                     std::vector<uint32_t> equals_ids;
                     list->uncompress(equals_ids);
@@ -2912,16 +4057,10 @@ void filter_result_iterator_t::compute_iterators() {
                     list->uncompress(f_id_buff);
                 }
 
-                if (f_id_buff.size() >= 100'000) {
-                    gfx::timsort(f_id_buff.begin(), f_id_buff.end());
-                    f_id_buff.erase(std::unique( f_id_buff.begin(), f_id_buff.end() ), f_id_buff.end());
-
-                    uint32_t* out = nullptr;
-                    filter_ids_len = ArrayUtils::or_scalar(filter_ids, filter_ids_len, f_id_buff.data(), f_id_buff.size(),
-                                                           &out);
-                    delete[] filter_ids;
-                    filter_ids = out;
-                    std::vector<uint32_t>().swap(f_id_buff);  // clears out memory
+                list_ids_len += f_id_buff.size();
+                if (list_ids_len >= 100'000) {
+                    or_sorted_runs(list_ids, filter_ids, filter_ids_len);
+                    list_ids_len = 0;
 
                     if (timeout_info != nullptr && is_timed_out(true)) {
                         goto compute_done;
@@ -2932,17 +4071,7 @@ void filter_result_iterator_t::compute_iterators() {
 
         compute_done:
 
-        if (!f_id_buff.empty()) {
-            gfx::timsort(f_id_buff.begin(), f_id_buff.end());
-            f_id_buff.erase(std::unique( f_id_buff.begin(), f_id_buff.end() ), f_id_buff.end());
-
-            uint32_t* out = nullptr;
-            filter_ids_len = ArrayUtils::or_scalar(filter_ids, filter_ids_len, f_id_buff.data(), f_id_buff.size(),
-                                                   &out);
-            delete[] filter_ids;
-            filter_ids = out;
-            std::vector<uint32_t>().swap(f_id_buff);  // clears out memory
-        }
+        or_sorted_runs(list_ids, filter_ids, filter_ids_len);
 
         filter_result.docs = filter_ids;
         filter_result.count = filter_ids_len;
@@ -2979,11 +4108,14 @@ void filter_result_iterator_t::compute_iterators() {
         uint32_t* or_ids = nullptr;
         size_t or_ids_size = 0;
 
-        // aggregates IDs across array of filter values and reduces excessive ORing
-        std::vector<uint32_t> f_id_buff;
+        // aggregates the sorted IDs of each filter value and merges them with a k-way merge to reduce excessive ORing
+        std::vector<std::vector<uint32_t>> value_ids;
+        size_t value_ids_len = 0;
 
         for (uint32_t i = 0; i < posting_lists.size(); i++) {
             auto& p_list = posting_lists[i];
+            std::vector<uint32_t> f_id_buff;
+
             if (string_prefix_filter_index.count(i) != 0 &&
                     (a_filter.comparators[0] == EQUALS || a_filter.comparators[0] == NOT_EQUALS)) {
                 // Exact prefix match, needs intersection + prefix matching
@@ -3067,15 +4199,12 @@ void filter_result_iterator_t::compute_iterators() {
                 }
             }
 
-            if (f_id_buff.size() > 100000 || a_filter.values.size() == 1) {
-                gfx::timsort(f_id_buff.begin(), f_id_buff.end());
-                f_id_buff.erase(std::unique( f_id_buff.begin(), f_id_buff.end() ), f_id_buff.end());
+            value_ids_len += f_id_buff.size();
+            value_ids.push_back(std::move(f_id_buff));
 
-                uint32_t* out = nullptr;
-                or_ids_size = ArrayUtils::or_scalar(or_ids, or_ids_size, f_id_buff.data(), f_id_buff.size(), &out);
-                delete[] or_ids;
-                or_ids = out;
-                std::vector<uint32_t>().swap(f_id_buff);  // clears out memory
+            if (value_ids_len > 100000) {
+                or_sorted_runs(value_ids, or_ids, or_ids_size);
+                value_ids_len = 0;
 
                 if (timeout_info != nullptr && is_timed_out(true)) {
                     break;
@@ -3083,16 +4212,7 @@ void filter_result_iterator_t::compute_iterators() {
             }
         }
 
-        if (!f_id_buff.empty()) {
-            gfx::timsort(f_id_buff.begin(), f_id_buff.end());
-            f_id_buff.erase(std::unique( f_id_buff.begin(), f_id_buff.end() ), f_id_buff.end());
-
-            uint32_t* out = nullptr;
-            or_ids_size = ArrayUtils::or_scalar(or_ids, or_ids_size, f_id_buff.data(), f_id_buff.size(), &out);
-            delete[] or_ids;
-            or_ids = out;
-            std::vector<uint32_t>().swap(f_id_buff);  // clears out memory
-        }
+        or_sorted_runs(value_ids, or_ids, or_ids_size);
 
         filter_result.docs = or_ids;
         filter_result.count = or_ids_size;
@@ -3136,121 +4256,29 @@ filter_result_iterator_timeout_info::filter_result_iterator_timeout_info(uint64_
                                                                          search_stop_us(search_stop) {}
 
 
-bool filter_result_iterator_t::validate_object_filter_helper(Index const* const index, const nlohmann::json& doc,
-                                                             const filter_node_t* filter_node) {
-    if(filter_node->isOperator) {
-        if(filter_node->filter_operator == AND) {
-            return validate_object_filter_helper(index, doc, filter_node->left) &&
-                   validate_object_filter_helper(index, doc, filter_node->right);
-        } else {
-            return validate_object_filter_helper(index, doc, filter_node->left) ||
-                   validate_object_filter_helper(index, doc, filter_node->right);
-        }
-    } else {
-        const auto& filter_exp = filter_node->filter_exp;
-        auto pos = filter_exp.field_name.rfind(".");
-
-        const auto& nested_field = filter_exp.field_name.substr(pos+1, filter_exp.field_name.size() - (pos+1));
-        field f = index->search_schema.at(filter_exp.field_name);
-
-        using fieldType = std::variant<int64_t, float, bool, std::string>;
-        fieldType doc_val, filter_val;
-
-        bool match_found = false;
-
-        for(auto i = 0; i < filter_exp.values.size(); ++i) {
-            if(match_found) {
-                break;
-            }
-
-            auto val = filter_exp.values[i];
-            auto comparator = filter_exp.comparators.size() < filter_exp.values.size() && f.is_string() ?
-                                filter_exp.comparators[0] : filter_exp.comparators[i];
-
-            if (f.is_string()) {
-                if(val.at(val.size() - 1) == '*' && comparator == CONTAINS) {//prefix match
-                    val.pop_back();
-                }
-
-                filter_val = val;
-                doc_val = doc[nested_field].get<std::string>();
-
-            } else if (f.is_float()) {
-                filter_val = std::stof(val);
-                doc_val = doc[nested_field].get<float>();
-            } else if (f.is_bool()) {
-                filter_val = val == "1" ? true : false;
-                doc_val = doc[nested_field].get<bool>();
-            } else if (f.is_integer()) {
-                filter_val = std::stoll(val);
-                doc_val = doc[nested_field].get<int64_t>();
-            }
-
-            if (comparator == EQUALS) {
-                match_found = (doc_val == filter_val);
-            } else if (comparator == NOT_EQUALS) {
-                match_found = (doc_val != filter_val);
-            } else if(comparator == CONTAINS) {
-                if(std::holds_alternative<std::string>(doc_val) && std::holds_alternative<std::string>(filter_val)) {
-                    match_found = (std::get<std::string>(doc_val).find(std::get<std::string>(filter_val)) != std::string::npos);
-                }
-            } else if (comparator == LESS_THAN) { //further comparators for only float and integers
-                if(std::holds_alternative<int64_t>(doc_val) && std::holds_alternative<int64_t>(filter_val)) {
-                    match_found = (std::get<int64_t>(doc_val) < std::get<int64_t>(filter_val));
-                } else if(std::holds_alternative<float>(doc_val) && std::holds_alternative<float>(filter_val)) {
-                    match_found = (std::get<float>(doc_val) < std::get<float>(filter_val));
-                }
-            } else if(comparator == LESS_THAN_EQUALS) {
-                if(std::holds_alternative<int64_t>(doc_val) && std::holds_alternative<int64_t>(filter_val)) {
-                    match_found = (std::get<int64_t>(doc_val) <= std::get<int64_t>(filter_val));
-                } else if(std::holds_alternative<float>(doc_val) && std::holds_alternative<float>(filter_val)) {
-                    match_found = (std::get<float>(doc_val) <= std::get<float>(filter_val));
-                }
-            } else if(comparator == GREATER_THAN) {
-                if(std::holds_alternative<int64_t>(doc_val) && std::holds_alternative<int64_t>(filter_val)) {
-                    match_found = (std::get<int64_t>(doc_val) > std::get<int64_t>(filter_val));
-                } else if(std::holds_alternative<float>(doc_val) && std::holds_alternative<float>(filter_val)) {
-                    match_found = (std::get<float>(doc_val) > std::get<float>(filter_val));
-                }
-            } else if(comparator == GREATER_THAN_EQUALS) {
-                if(std::holds_alternative<int64_t>(doc_val) && std::holds_alternative<int64_t>(filter_val)) {
-                    match_found = (std::get<int64_t>(doc_val) >= std::get<int64_t>(filter_val));
-                } else if(std::holds_alternative<float>(doc_val) && std::holds_alternative<float>(filter_val)) {
-                    match_found = (std::get<float>(doc_val) >= std::get<float>(filter_val));
-                }
-            } else if(comparator == RANGE_INCLUSIVE) {
-                auto range_end = filter_exp.values[++i];
-
-                if(std::holds_alternative<int64_t>(doc_val) && std::holds_alternative<int64_t>(filter_val)) {
-                    auto range_end_val = std::stoll(range_end);
-                    match_found = (std::get<int64_t>(doc_val) >= std::get<int64_t>(filter_val) && std::get<int64_t>(doc_val) <= range_end_val);
-                } else if(std::holds_alternative<float>(doc_val) && std::holds_alternative<float>(filter_val)) {
-                    auto range_end_val = std::stof(range_end);
-                    match_found = (std::get<float>(doc_val) >= std::get<float>(filter_val) && std::get<float>(doc_val) <= range_end_val);
-                }
-            }
-        }
-        return match_found;
+bool filter_result_iterator_t::validate_object_filter() {
+    auto collection = CollectionManager::get_instance().get_collection(collection_name);
+    if (collection.get() == nullptr) {
+        return false;
     }
-}
 
-bool filter_result_iterator_t::validate_object_filter() {
-    auto get_nested_field_doc = [&] (const std::string& object_field_name, const nlohmann::json& document) -> nlohmann::json {
-        std::vector<std::string> results;
-        StringUtils::split(object_field_name, results, ".");
+    if (!object_filter.is_compiled()) {
+        return false;
+    }
 
-        nlohmann::json return_doc = document;
-        for(auto i = 0; i < results.size(); ++i) {
-            return_doc = return_doc[results[i]];
+    auto matches_object_filter = [&](const nlohmann::json& document) {
+        const auto object_array = object_filter_t::get_path(document, filter_node->object_field_name);
+        if (object_array == nullptr) {
+            return false;
         }
 
-        return return_doc;
-    };
-
-    auto collection = CollectionManager::get_instance().get_collection(collection_name);
-    if (collection.get() == nullptr) {
+        for (const auto& nested_object: *object_array) {
+            if (object_filter.matches(nested_object)) {
+                return true;
+            }
+        }
         return false;
-    }
+    };
 
     // `compute_iterators()` has been called.
     if (is_filter_result_initialized) {
@@ -3267,12 +4295,8 @@ bool filter_result_iterator_t::validate_object_filter() {
                 continue;
             }
 
-            const auto& doc = get_nested_field_doc(filter_node->object_field_name, document);
-            for (const auto& nested_object: doc) {
-                if (validate_object_filter_helper(index, nested_object, filter_node)) {
-                    filter_result.docs[result_count++] = id;
-                    break;
-                }
+            if (matches_object_filter(document)) {
+                filter_result.docs[result_count++] = id;
             }
         }
 
@@ -3290,12 +4314,7 @@ bool filter_result_iterator_t::validate_object_filter() {
         return false;
     }
 
-    for (const auto& nested_object: document[filter_node->object_field_name]) {
-        if (validate_object_filter_helper(index, nested_object, filter_node)) {
-            return true;
-        }
-    }
-    return false;
+    return matches_object_filter(document);
 }
 
 filter_result_iterator_t::filter_result_iterator_t(FILTER_OPERATOR filter_operator,
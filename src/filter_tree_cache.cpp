@@ -0,0 +1,94 @@
+#include "filter_tree_cache.h"
+
+bool filter_tree_cache_t::is_cacheable(const filter_node_t* filter_node, bool& has_id_filter) {
+    if (filter_node == nullptr) {
+        return true;
+    }
+
+    if (filter_node->isOperator || filter_node->is_object_filter_root) {
+        return is_cacheable(filter_node->left, has_id_filter) && is_cacheable(filter_node->right, has_id_filter);
+    }
+
+    // A reference filter is only checked for the existence of its collection while parsing.
+    if (!filter_node->filter_exp.referenced_collection_name.empty()) {
+        return false;
+    }
+
+    has_id_filter = has_id_filter || filter_node->filter_exp.field_name == "id";
+    return true;
+}
+
+void filter_tree_cache_t::set_max_entries(const size_t max_entries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->max_entries = max_entries;
+
+    if (max_entries == 0) {
+        entries.clear();
+    } else {
+        entries.capacity(max_entries);
+    }
+}
+
+void filter_tree_cache_t::bump_schema_version() {
+    schema_version++;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+void filter_tree_cache_t::bump_doc_ids_epoch() {
+    doc_ids_epoch++;
+}
+
+Option<bool> filter_tree_cache_t::parse_filter_query(const std::string& filter_query,
+                                                     const tsl::htrie_map<char, field>& search_schema,
+                                                     const Store* store,
+                                                     const std::string& doc_id_prefix,
+                                                     filter_node_t*& root,
+                                                     const bool& validate_field_names) {
+    if (max_entries == 0) {
+        return filter::parse_filter_query(filter_query, search_schema, store, doc_id_prefix, root,
+                                          validate_field_names);
+    }
+
+    // Unknown fields are either an error or ignored, which yields different trees.
+    const std::string key = (validate_field_names ? "1:" : "0:") + filter_query;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto entry_it = entries.find(key);
+        if (entry_it != entries.end()) {
+            const auto& entry = entry_it.value();
+            if (entry.schema_version == schema_version &&
+                (!entry.has_id_filter || entry.doc_ids_epoch == doc_ids_epoch)) {
+                root = new filter_node_t(*entry.root);
+                return Option<bool>(true);
+            }
+
+            entries.erase(key);
+        }
+    }
+
+    // read before parsing, so that a tree that misses a concurrent write is stale as soon as it is added
+    entry_t entry;
+    entry.schema_version = schema_version;
+    entry.doc_ids_epoch = doc_ids_epoch;
+
+    auto parse_op = filter::parse_filter_query(filter_query, search_schema, store, doc_id_prefix, root,
+                                               validate_field_names);
+    if (!parse_op.ok() || root == nullptr || !is_cacheable(root, entry.has_id_filter)) {
+        return parse_op;
+    }
+
+    entry.root = std::make_shared<const filter_node_t>(*root);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.insert(key, entry);
+
+    return parse_op;
+}
+
+size_t filter_tree_cache_t::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
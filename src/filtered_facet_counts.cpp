@@ -0,0 +1,113 @@
+#include "filtered_facet_counts.h"
+
+bool filtered_facet_counts_t::add(const uint32_t seq_id) {
+    if (seq_id / BLOCK_SIZE >= ids.size()) {
+        ids.resize((seq_id / BLOCK_SIZE) + 1, 0);
+    }
+
+    const uint64_t bit = uint64_t(1) << (seq_id % BLOCK_SIZE);
+    if ((ids[seq_id / BLOCK_SIZE] & bit) != 0) {
+        return false;
+    }
+
+    ids[seq_id / BLOCK_SIZE] |= bit;
+    num_ids++;
+    return true;
+}
+
+bool filtered_facet_counts_t::remove(const uint32_t seq_id) {
+    if (!contains(seq_id)) {
+        return false;
+    }
+
+    ids[seq_id / BLOCK_SIZE] &= ~(uint64_t(1) << (seq_id % BLOCK_SIZE));
+    num_ids--;
+    return true;
+}
+
+bool filtered_facet_counts_t::contains(const uint32_t seq_id) const {
+    return seq_id / BLOCK_SIZE < ids.size() && (ids[seq_id / BLOCK_SIZE] >> (seq_id % BLOCK_SIZE)) & 1;
+}
+
+void filtered_facet_counts_t::update_count(field_counts_t& counts, const uint32_t facet_id,
+                                           const uint32_t old_count, const uint32_t new_count) {
+    if (old_count != 0) {
+        counts.ordered_counts.erase({old_count, facet_id});
+    }
+
+    if (new_count == 0) {
+        counts.facet_id_counts.erase(facet_id);
+        return;
+    }
+
+    counts.facet_id_counts[facet_id] = new_count;
+    counts.ordered_counts.emplace(new_count, facet_id);
+}
+
+void filtered_facet_counts_t::add_facet_ids(const std::string& field_name, const uint32_t* facet_ids,
+                                            const size_t num_facet_ids) {
+    if (num_facet_ids == 0) {
+        return;
+    }
+
+    auto& counts = field_counts[field_name];
+
+    for (size_t i = 0; i < num_facet_ids; i++) {
+        const auto it = counts.facet_id_counts.find(facet_ids[i]);
+        const uint32_t old_count = (it == counts.facet_id_counts.end()) ? 0 : it->second;
+        update_count(counts, facet_ids[i], old_count, old_count + 1);
+    }
+}
+
+void filtered_facet_counts_t::remove_facet_ids(const std::string& field_name, const uint32_t* facet_ids,
+                                               const size_t num_facet_ids) {
+    const auto field_counts_it = field_counts.find(field_name);
+    if (field_counts_it == field_counts.end()) {
+        return;
+    }
+
+    auto& counts = field_counts_it->second;
+
+    for (size_t i = 0; i < num_facet_ids; i++) {
+        const auto it = counts.facet_id_counts.find(facet_ids[i]);
+        if (it == counts.facet_id_counts.end()) {
+            continue;
+        }
+
+        update_count(counts, facet_ids[i], it->second, it->second - 1);
+    }
+}
+
+void filtered_facet_counts_t::get_top_counts(const std::string& field_name, const size_t k,
+                                             std::vector<std::pair<uint32_t, uint32_t>>& facet_id_counts) const {
+    const auto field_counts_it = field_counts.find(field_name);
+    if (field_counts_it == field_counts.end()) {
+        return;
+    }
+
+    const auto& ordered_counts = field_counts_it->second.ordered_counts;
+    size_t num_added = 0;
+
+    for (auto it = ordered_counts.begin(); it != ordered_counts.end() && num_added < k; it++, num_added++) {
+        facet_id_counts.emplace_back(it->second, it->first);
+    }
+}
+
+uint32_t filtered_facet_counts_t::get_count(const std::string& field_name, const uint32_t facet_id) const {
+    const auto field_counts_it = field_counts.find(field_name);
+    if (field_counts_it == field_counts.end()) {
+        return 0;
+    }
+
+    const auto it = field_counts_it->second.facet_id_counts.find(facet_id);
+    return (it == field_counts_it->second.facet_id_counts.end()) ? 0 : it->second;
+}
+
+size_t filtered_facet_counts_t::num_values(const std::string& field_name) const {
+    const auto field_counts_it = field_counts.find(field_name);
+    return (field_counts_it == field_counts.end()) ? 0 : field_counts_it->second.facet_id_counts.size();
+}
+
+void filtered_facet_counts_t::erase_field(const std::string& field_name) {
+    field_counts.erase(field_name);
+}
@@ -0,0 +1,203 @@
+#include "float_column.h"
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <sse2neon.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+int32_t float_column_t::to_key(const float value) {
+    int32_t i;
+    memcpy(&i, &value, sizeof i);
+
+    // flips the magnitude bits of negative values so that they are ordered in reverse
+    return i ^ ((i >> 31) & INT32_MAX);
+}
+
+float float_column_t::from_key(const int32_t key) {
+    const int32_t i = key ^ ((key >> 31) & INT32_MAX);
+
+    float f;
+    memcpy(&f, &i, sizeof f);
+    return f;
+}
+
+void float_column_t::set(const uint32_t seq_id, const float value) {
+    if (seq_id >= values.size()) {
+        const size_t num_blocks = (size_t(seq_id) / BLOCK_SIZE) + 1;
+        values.resize(num_blocks * BLOCK_SIZE, 0);
+        present.resize(num_blocks, 0);
+    }
+
+    const uint64_t bit = uint64_t(1) << (seq_id % BLOCK_SIZE);
+    if ((present[seq_id / BLOCK_SIZE] & bit) == 0) {
+        present[seq_id / BLOCK_SIZE] |= bit;
+        num_values++;
+    }
+
+    values[seq_id] = value;
+}
+
+void float_column_t::remove(const uint32_t seq_id) {
+    if (!contains(seq_id)) {
+        return;
+    }
+
+    present[seq_id / BLOCK_SIZE] &= ~(uint64_t(1) << (seq_id % BLOCK_SIZE));
+    values[seq_id] = 0;
+    num_values--;
+}
+
+bool float_column_t::contains(const uint32_t seq_id) const {
+    return seq_id < values.size() && (present[seq_id / BLOCK_SIZE] >> (seq_id % BLOCK_SIZE)) & 1;
+}
+
+bool float_column_t::get(const uint32_t seq_id, float& value) const {
+    if (!contains(seq_id)) {
+        return false;
+    }
+
+    value = values[seq_id];
+    return true;
+}
+
+void float_column_t::range_search(const int32_t start_key, const int32_t end_key, std::vector<uint32_t>& ids) const {
+    if (start_key > end_key) {
+        return;
+    }
+
+    const __m128i start_vec = _mm_set1_epi32(start_key);
+    const __m128i end_vec = _mm_set1_epi32(end_key);
+    const __m128i magnitude_mask = _mm_set1_epi32(INT32_MAX);
+
+    for (size_t block = 0; block < present.size(); block++) {
+        const uint64_t block_present = present[block];
+        if (block_present == 0) {
+            continue;
+        }
+
+        const size_t block_offset = block * BLOCK_SIZE;
+
+        for (size_t i = 0; i < BLOCK_SIZE; i += 4) {
+            const uint32_t lanes_present = (block_present >> i) & 0xF;
+            if (lanes_present == 0) {
+                continue;
+            }
+
+            const __m128i bits = _mm_loadu_si128((const __m128i*) (values.data() + block_offset + i));
+            const __m128i keys = _mm_xor_si128(bits, _mm_and_si128(_mm_srai_epi32(bits, 31), magnitude_mask));
+
+            const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(keys, start_vec), _mm_cmpgt_epi32(keys, end_vec));
+            uint32_t matches = ~uint32_t(_mm_movemask_ps(_mm_castsi128_ps(outside))) & lanes_present;
+
+            while (matches != 0) {
+                ids.push_back(block_offset + i + __builtin_ctz(matches));
+                matches &= matches - 1;
+            }
+        }
+    }
+}
+
+bool float_column_t::get_min_max(const uint32_t* ids, const size_t ids_len, float& min, float& max) const {
+    int32_t min_key = INT32_MAX, max_key = INT32_MIN;
+    bool found = false;
+
+    for (size_t i = 0; i < ids_len; i++) {
+        if (!contains(ids[i])) {
+            continue;
+        }
+
+        const int32_t key = to_key(values[ids[i]]);
+        min_key = std::min(min_key, key);
+        max_key = std::max(max_key, key);
+        found = true;
+    }
+
+    if (found) {
+        min = from_key(min_key);
+        max = from_key(max_key);
+    }
+
+    return found;
+}
+
+bool float_column_t::get_stats(const uint32_t* ids, const size_t ids_len, float& min, float& max, double& sum,
+                               size_t& count) const {
+    const __m128i magnitude_mask = _mm_set1_epi32(INT32_MAX);
+    const __m128i max_key_vec = _mm_set1_epi32(INT32_MAX);
+    const __m128i min_key_vec = _mm_set1_epi32(INT32_MIN);
+
+    __m128i min_keys = max_key_vec, max_keys = min_key_vec;
+    __m128d sums_lo = _mm_setzero_pd(), sums_hi = _mm_setzero_pd();
+    size_t num_found = 0;
+
+    size_t i = 0;
+    for (; i + 4 <= ids_len; i += 4) {
+        alignas(16) float lane_values[4];
+        alignas(16) int32_t lane_present[4];
+
+        for (size_t lane = 0; lane < 4; lane++) {
+            const bool is_present = contains(ids[i + lane]);
+            lane_present[lane] = -int32_t(is_present);
+            lane_values[lane] = is_present ? values[ids[i + lane]] : 0.0f;
+            num_found += is_present;
+        }
+
+        const __m128 vals = _mm_load_ps(lane_values);
+        const __m128i present_mask = _mm_load_si128((const __m128i*) lane_present);
+
+        const __m128i bits = _mm_castps_si128(vals);
+        const __m128i keys = _mm_xor_si128(bits, _mm_and_si128(_mm_srai_epi32(bits, 31), magnitude_mask));
+
+        // lanes without a value take the identity of each reduction
+        const __m128i lane_min_keys = _mm_or_si128(_mm_and_si128(present_mask, keys),
+                                                   _mm_andnot_si128(present_mask, max_key_vec));
+        const __m128i lane_max_keys = _mm_or_si128(_mm_and_si128(present_mask, keys),
+                                                   _mm_andnot_si128(present_mask, min_key_vec));
+
+        const __m128i is_less = _mm_cmplt_epi32(lane_min_keys, min_keys);
+        min_keys = _mm_or_si128(_mm_and_si128(is_less, lane_min_keys), _mm_andnot_si128(is_less, min_keys));
+
+        const __m128i is_greater = _mm_cmpgt_epi32(lane_max_keys, max_keys);
+        max_keys = _mm_or_si128(_mm_and_si128(is_greater, lane_max_keys), _mm_andnot_si128(is_greater, max_keys));
+
+        sums_lo = _mm_add_pd(sums_lo, _mm_cvtps_pd(vals));
+        sums_hi = _mm_add_pd(sums_hi, _mm_cvtps_pd(_mm_movehl_ps(vals, vals)));
+    }
+
+    alignas(16) int32_t min_lanes[4], max_lanes[4];
+    alignas(16) double sum_lanes[4];
+    _mm_store_si128((__m128i*) min_lanes, min_keys);
+    _mm_store_si128((__m128i*) max_lanes, max_keys);
+    _mm_store_pd(sum_lanes, sums_lo);
+    _mm_store_pd(sum_lanes + 2, sums_hi);
+
+    int32_t min_key = std::min(std::min(min_lanes[0], min_lanes[1]), std::min(min_lanes[2], min_lanes[3]));
+    int32_t max_key = std::max(std::max(max_lanes[0], max_lanes[1]), std::max(max_lanes[2], max_lanes[3]));
+    double values_sum = (sum_lanes[0] + sum_lanes[1]) + (sum_lanes[2] + sum_lanes[3]);
+
+    for (; i < ids_len; i++) {
+        if (!contains(ids[i])) {
+            continue;
+        }
+
+        const float value = values[ids[i]];
+        min_key = std::min(min_key, to_key(value));
+        max_key = std::max(max_key, to_key(value));
+        values_sum += value;
+        num_found++;
+    }
+
+    if (num_found == 0) {
+        return false;
+    }
+
+    min = from_key(min_key);
+    max = from_key(max_key);
+    sum = values_sum;
+    count = num_found;
+    return true;
+}
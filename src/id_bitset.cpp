@@ -0,0 +1,171 @@
+#include "id_bitset.h"
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <sse2neon.h>
+#endif
+
+#include <algorithm>
+
+id_bitset_t::id_bitset_t(const uint32_t* ids, const uint32_t ids_length) {
+    if (ids_length == 0) {
+        return;
+    }
+
+    words.resize((ids[ids_length - 1] >> 6) + 1, 0);
+    for (uint32_t i = 0; i < ids_length; i++) {
+        words[ids[i] >> 6] |= uint64_t(1) << (ids[i] & 63);
+    }
+
+    num_ids = ids_length;
+}
+
+bool id_bitset_t::is_dense(const uint32_t ids_length, const uint32_t max_id, const uint32_t min_ids_length,
+                           const uint32_t ratio) {
+    if (ids_length < min_ids_length) {
+        return false;
+    }
+
+    // a bitset takes (max_id + 1) / 8 bytes against the 4 bytes per id of an array
+    const uint64_t bitset_bytes = (uint64_t(max_id >> 6) + 1) * sizeof(uint64_t);
+    return bitset_bytes * ratio <= uint64_t(ids_length) * sizeof(uint32_t);
+}
+
+uint32_t id_bitset_t::next(const uint32_t id) const {
+    size_t word_index = id >> 6;
+    if (word_index >= words.size()) {
+        return UINT32_MAX;
+    }
+
+    uint64_t word = words[word_index] & (~uint64_t(0) << (id & 63));
+    while (word == 0) {
+        if (++word_index == words.size()) {
+            return UINT32_MAX;
+        }
+
+        word = words[word_index];
+    }
+
+    return (word_index << 6) + __builtin_ctzll(word);
+}
+
+uint32_t id_bitset_t::to_ids(uint32_t*& ids) const {
+    ids = new uint32_t[num_ids];
+
+    uint32_t count = 0;
+    for (size_t word_index = 0; word_index < words.size(); word_index++) {
+        uint64_t word = words[word_index];
+        while (word != 0) {
+            ids[count++] = (word_index << 6) + __builtin_ctzll(word);
+            word &= word - 1;
+        }
+    }
+
+    return count;
+}
+
+uint32_t id_bitset_t::to_ids(const uint32_t id, const uint32_t n, std::vector<uint32_t>& ids) const {
+    size_t word_index = id >> 6;
+    if (word_index >= words.size() || n == 0) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    uint64_t word = words[word_index] & (~uint64_t(0) << (id & 63));
+
+    while (true) {
+        while (word != 0) {
+            ids.push_back((word_index << 6) + __builtin_ctzll(word));
+            word &= word - 1;
+
+            if (++count == n) {
+                return count;
+            }
+        }
+
+        if (++word_index == words.size()) {
+            return count;
+        }
+
+        word = words[word_index];
+    }
+}
+
+uint32_t id_bitset_t::and_scalar(const uint32_t* A, const uint32_t lenA, uint32_t*& results) const {
+    std::vector<uint32_t> matches;
+    for (uint32_t i = 0; i < lenA; i++) {
+        if (contains(A[i])) {
+            matches.push_back(A[i]);
+        }
+    }
+
+    if (matches.empty()) {
+        return 0;
+    }
+
+    results = new uint32_t[matches.size()];
+    std::copy(matches.begin(), matches.end(), results);
+    return matches.size();
+}
+
+void id_bitset_t::and_bitsets(const id_bitset_t& a, const id_bitset_t& b, id_bitset_t& result) {
+    const size_t num_words = std::min(a.words.size(), b.words.size());
+    std::vector<uint64_t> words(num_words);
+
+    size_t i = 0;
+    for (; i + 2 <= num_words; i += 2) {
+        const __m128i a_words = _mm_loadu_si128((const __m128i*) (a.words.data() + i));
+        const __m128i b_words = _mm_loadu_si128((const __m128i*) (b.words.data() + i));
+        _mm_storeu_si128((__m128i*) (words.data() + i), _mm_and_si128(a_words, b_words));
+    }
+
+    for (; i < num_words; i++) {
+        words[i] = a.words[i] & b.words[i];
+    }
+
+    // trailing empty words are dropped, so that the last word always holds the largest id
+    while (!words.empty() && words.back() == 0) {
+        words.pop_back();
+    }
+
+    result.words = std::move(words);
+    result.num_ids = 0;
+    for (const auto word: result.words) {
+        result.num_ids += __builtin_popcountll(word);
+    }
+}
+
+void id_bitset_t::or_bitsets(const id_bitset_t& a, const id_bitset_t& b, id_bitset_t& result) {
+    const auto& longer = a.words.size() >= b.words.size() ? a.words : b.words;
+    const auto& shorter = a.words.size() >= b.words.size() ? b.words : a.words;
+
+    std::vector<uint64_t> words(longer.size());
+
+    size_t i = 0;
+    for (; i + 2 <= shorter.size(); i += 2) {
+        const __m128i a_words = _mm_loadu_si128((const __m128i*) (longer.data() + i));
+        const __m128i b_words = _mm_loadu_si128((const __m128i*) (shorter.data() + i));
+        _mm_storeu_si128((__m128i*) (words.data() + i), _mm_or_si128(a_words, b_words));
+    }
+
+    for (; i < shorter.size(); i++) {
+        words[i] = longer[i] | shorter[i];
+    }
+
+    std::copy(longer.begin() + i, longer.end(), words.begin() + i);
+
+    result.words = std::move(words);
+    result.num_ids = 0;
+    for (const auto word: result.words) {
+        result.num_ids += __builtin_popcountll(word);
+    }
+}
+
+uint32_t id_bitset_t::last_id() const {
+    if (words.empty()) {
+        return 0;
+    }
+
+    return ((words.size() - 1) << 6) + 63 - __builtin_clzll(words.back());
+}
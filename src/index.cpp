@@ -47,6 +47,7 @@ spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::group_found_sentinel_va
 spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::eval_sentinel_value;
 spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::geo_sentinel_value;
 spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::str_sentinel_value;
+spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::num_array_sentinel_value;
 spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::vector_distance_sentinel_value;
 spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::vector_query_sentinel_value;
 spp::sparse_hash_map<uint32_t, int64_t, Hasher32> Index::union_search_index_sentinel_value;
@@ -60,6 +61,7 @@ Index::Index(const std::string& name, const uint32_t collection_id, const Store*
         seq_ids(new id_list_t(256)), symbols_to_index(symbols_to_index), token_separators(token_separators) {
 
     facet_index_v4 = new facet_index_t();
+    filter_result_cache.set_max_bytes(size_t(Config::get_instance().get_filter_cache_size_mb()) * 1024 * 1024);
 
     for(const auto& a_field: search_schema) {
         if(!a_field.index) {
@@ -94,12 +96,24 @@ Index::Index(const std::string& name, const uint32_t collection_id, const Store*
                 num_tree_t* num_tree = new num_tree_t;
                 numerical_index.emplace(a_field.name, num_tree);
             }
+
+            if(a_field.is_integer() || a_field.is_float()) {
+                numeric_histogram_index.emplace(a_field.name, new numeric_histogram_t());
+            }
+
+            if(a_field.type == field_types::FLOAT) {
+                float_column_index.emplace(a_field.name, new float_column_t());
+            }
+
+            if(a_field.is_array() && (a_field.is_integer() || a_field.is_float()) && !a_field.is_reference_helper) {
+                min_max_index.emplace(a_field.name, new min_max_column_t());
+            }
         }
 
         if(a_field.sort) {
             if(a_field.type == field_types::STRING) {
-                adi_tree_t* tree = new adi_tree_t();
-                str_sort_index.emplace(a_field.name, tree);
+                auto column = new string_sort_column_t();
+                str_sort_index.emplace(a_field.name, column);
             } else if(a_field.type != field_types::GEOPOINT_ARRAY) {
                 auto doc_to_score = new spp::sparse_hash_map<uint32_t, int64_t, Hasher32>();
                 sort_index.emplace(a_field.name, doc_to_score);
@@ -190,6 +204,27 @@ Index::~Index() {
 
     range_index.clear();
 
+    for(auto & name_histogram: numeric_histogram_index) {
+        delete name_histogram.second;
+        name_histogram.second = nullptr;
+    }
+
+    numeric_histogram_index.clear();
+
+    for(auto & name_column: float_column_index) {
+        delete name_column.second;
+        name_column.second = nullptr;
+    }
+
+    float_column_index.clear();
+
+    for(auto & name_column: min_max_index) {
+        delete name_column.second;
+        name_column.second = nullptr;
+    }
+
+    min_max_index.clear();
+
     for(auto & name_map: sort_index) {
         delete name_map.second;
         name_map.second = nullptr;
@@ -214,6 +249,12 @@ Index::~Index() {
     str_sort_index.clear();
 
     delete facet_index_v4;
+
+    for(auto& filter_counts: facet_count_filters) {
+        delete filter_counts.second;
+    }
+
+    facet_count_filters.clear();
     
     delete seq_ids;
 
@@ -467,6 +508,14 @@ void Index::validate_and_preprocess(Index *index,
     // runs in a partitioned thread
     std::vector<index_record*> records_to_embed;
 
+    std::vector<std::pair<std::string, sort_by>> derived_fields;
+    for(const auto& a_field: search_schema) {
+        sort_by decay_function("", "");
+        if(a_field.is_derived() && field::parse_derived_expression(a_field.expression, decay_function).ok()) {
+            derived_fields.emplace_back(a_field.name, decay_function);
+        }
+    }
+
     for(size_t i = 0; i < batch_size; i++) {
         index_record& index_rec = iter_batch[batch_start_index + i];
 
@@ -498,6 +547,10 @@ void Index::validate_and_preprocess(Index *index,
                 }
             }
 
+            if(!derived_fields.empty()) {
+                compute_derived_fields(derived_fields, index_rec);
+            }
+
             if(index_rec.is_update) {
                 // scrub string fields to reduce delete ops
                 get_doc_changes(index_rec.operation, search_schema, embedding_fields,
@@ -631,6 +684,16 @@ size_t Index::batch_memory_index(Index *index,
         cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
     }
 
+    {
+        // documents of the batch are counted again for the facet count filters once they have been indexed
+        std::unique_lock lock(index->mutex);
+        for(const auto& index_rec: iter_batch) {
+            if(index_rec.indexed.ok()) {
+                index->remove_from_facet_count_filters(index_rec.seq_id);
+            }
+        }
+    }
+
     std::unordered_set<std::string> found_fields;
 
     for(size_t i = 0; i < iter_batch.size(); i++) {
@@ -683,6 +746,9 @@ size_t Index::batch_memory_index(Index *index,
                 }
             }
 
+            // bumped only once the values are visible, so that a filter computed before then is never cached as fresh
+            index->filter_result_cache.bump_epoch(field_name);
+
             std::unique_lock<std::mutex> lock(m_process);
             num_processed++;
             cv_process.notify_one();
@@ -694,6 +760,8 @@ size_t Index::batch_memory_index(Index *index,
         cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
     }
 
+    index->add_to_facet_count_filters(iter_batch);
+
     return num_indexed;
 }
 
@@ -840,6 +908,10 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                         seq_id_to_fvalues[seq_id].push_back(facet_value_id);
                     }
                 }
+
+                if(afield.is_hierarchical()) {
+                    add_hierarchy_ancestors(afield, seq_id, fvalue_to_seq_ids, seq_id_to_fvalues);
+                }
             }
 
             if(record.points > max_score) {
@@ -882,7 +954,8 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
         if (afield.type == field_types::INT32) {
             auto num_tree = afield.range_index ? nullptr : numerical_index.at(afield.name);
             auto trie = afield.range_index ? range_index.at(afield.name) : nullptr;
-            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie]
+            auto histogram = numeric_histogram_index.at(afield.name);
+            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie, histogram]
                     (const index_record& record, uint32_t seq_id) {
                 int32_t value = record.doc[afield.name].get<int32_t>();
                 if (afield.range_index) {
@@ -890,13 +963,15 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                 } else {
                     num_tree->insert(value, seq_id);
                 }
+                histogram->insert(value);
             });
         }
 
         else if(afield.type == field_types::INT64) {
             auto num_tree = afield.range_index ? nullptr : numerical_index.at(afield.name);
             auto trie = afield.range_index ? range_index.at(afield.name) : nullptr;
-            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie]
+            auto histogram = numeric_histogram_index.at(afield.name);
+            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie, histogram]
                     (const index_record& record, uint32_t seq_id) {
                 int64_t value = record.doc[afield.name].get<int64_t>();
                 if (afield.range_index) {
@@ -904,13 +979,16 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                 } else {
                     num_tree->insert(value, seq_id);
                 }
+                histogram->insert(value);
             });
         }
 
         else if(afield.type == field_types::FLOAT) {
             auto num_tree = afield.range_index ? nullptr : numerical_index.at(afield.name);
             auto trie = afield.range_index ? range_index.at(afield.name) : nullptr;
-            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie]
+            auto histogram = numeric_histogram_index.at(afield.name);
+            auto column = float_column_index.at(afield.name);
+            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie, histogram, column]
                     (const index_record& record, uint32_t seq_id) {
                 float fvalue = record.doc[afield.name].get<float>();
                 int64_t value = float_to_int64_t(fvalue);
@@ -919,6 +997,8 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                 } else {
                     num_tree->insert(value, seq_id);
                 }
+                histogram->insert(value);
+                column->set(seq_id, fvalue);
             });
         } else if(afield.type == field_types::BOOL) {
             auto num_tree = afield.range_index ? nullptr : numerical_index.at(afield.name);
@@ -1080,7 +1160,11 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
             auto reference = reference_index.count(afield.name) != 0 ? reference_index.at(afield.name) : nullptr;
             auto object_array_reference = object_array_reference_index.count(afield.name) != 0 ?
                                                                 object_array_reference_index.at(afield.name) : nullptr;
-            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie, reference, object_array_reference]
+            auto histogram = numeric_histogram_index.count(afield.name) != 0 ?
+                                                                numeric_histogram_index.at(afield.name) : nullptr;
+            auto min_max = min_max_index.count(afield.name) != 0 ? min_max_index.at(afield.name) : nullptr;
+            iterate_and_index_numerical_field(iter_batch, afield, [&afield, num_tree, trie, reference, object_array_reference,
+                                                                   histogram, min_max]
                     (const index_record& record, uint32_t seq_id) {
                 for(size_t arr_i = 0; arr_i < record.doc[afield.name].size(); arr_i++) {
                     const auto& arr_value = record.doc[afield.name][arr_i];
@@ -1092,6 +1176,10 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                         } else {
                             num_tree->insert(value, seq_id);
                         }
+                        histogram->insert(value);
+                        if (min_max != nullptr) {
+                            min_max->insert(seq_id, value);
+                        }
                     }
 
                     else if(afield.type == field_types::INT64_ARRAY) {
@@ -1107,6 +1195,10 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                         } else {
                             num_tree->insert(value, seq_id);
                         }
+                        histogram->insert(value);
+                        if (min_max != nullptr) {
+                            min_max->insert(seq_id, value);
+                        }
                         if (reference != nullptr) {
                             reference->insert(seq_id, value);
                         }
@@ -1123,6 +1215,10 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
                         } else {
                             num_tree->insert(value, seq_id);
                         }
+                        histogram->insert(value);
+                        if (min_max != nullptr) {
+                            min_max->insert(seq_id, value);
+                        }
                     }
 
                     else if(afield.type == field_types::BOOL_ARRAY) {
@@ -1173,7 +1269,7 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
             }
         }
     } else if(afield.is_str_sortable()) {
-        adi_tree_t* str_tree = str_sort_index.at(afield.name);
+        string_sort_column_t* str_column = str_sort_index.at(afield.name);
 
         for(const auto& record: iter_batch) {
             if(!record.indexed.ok()) {
@@ -1192,7 +1288,7 @@ void Index::index_field_in_memory(const std::string& collection_name, const fiel
             str_tokenizer.tokenize(raw_str);
 
             if(!raw_str.empty()) {
-                str_tree->index(seq_id, raw_str.substr(0, 2000));
+                str_column->index(seq_id, raw_str.substr(0, 2000));
             }
         }
     }
@@ -1396,6 +1492,44 @@ void Index::tokenize_string_array(const std::vector<std::string>& strings,
 
 void Index::initialize_facet_indexes(const field& facet_field) {
     facet_index_v4->initialize(facet_field.name);
+
+    const auto& field_symbols_to_index = facet_field.symbols_to_index.empty() ? symbols_to_index :
+                                         facet_field.symbols_to_index;
+    const auto& field_token_separators = facet_field.token_separators.empty() ? token_separators :
+                                         facet_field.token_separators;
+    facet_index_v4->initialize_token_index(facet_field.name, facet_field.is_string(), facet_field.locale,
+                                           field_symbols_to_index, field_token_separators);
+}
+
+void Index::add_hierarchy_ancestors(const field& afield, const uint32_t seq_id,
+                                    std::unordered_map<facet_value_id_t, std::vector<uint32_t>,
+                                                       facet_value_id_t::Hash>& fvalue_to_seq_ids,
+                                    std::unordered_map<uint32_t, std::vector<facet_value_id_t>>& seq_id_to_fvalues) {
+    auto& doc_fvalues = seq_id_to_fvalues[seq_id];
+
+    // the ancestors follow the document's own values, so that array positions still refer to the document's values
+    std::set<std::string> doc_values;
+    for(const auto& fvalue: doc_fvalues) {
+        doc_values.insert(fvalue.facet_value);
+    }
+
+    std::vector<std::string> ancestors;
+    const size_t num_doc_values = doc_fvalues.size();
+
+    for(size_t i = 0; i < num_doc_values; i++) {
+        ancestors.clear();
+        afield.get_hierarchy_ancestors(doc_fvalues[i].facet_value, ancestors);
+
+        for(auto& ancestor: ancestors) {
+            if(!doc_values.insert(ancestor).second) {
+                continue;
+            }
+
+            facet_value_id_t facet_value_id(ancestor);
+            fvalue_to_seq_ids[facet_value_id].push_back(seq_id);
+            doc_fvalues.push_back(facet_value_id);
+        }
+    }
 }
 
 void Index::compute_facet_stats(facet &a_facet, const std::string& raw_value, const std::string & field_type,
@@ -1515,6 +1649,144 @@ Option<bool> Index::do_facets_with_lock(std::vector<facet>& facets, facet_query_
                      is_group_by_first_pass, group_by_missing_value_ids, collection, nullptr);
 }
 
+bool Index::compute_float_facet_stats(facet& a_facet, const std::string& field_name,
+                                      const uint32_t* result_ids, const size_t results_size) const {
+    const auto float_column_it = float_column_index.find(field_name);
+    if(float_column_it == float_column_index.end()) {
+        return false;
+    }
+
+    float fmin, fmax;
+    double sum;
+    size_t count;
+
+    if(float_column_it->second->get_stats(result_ids, results_size, fmin, fmax, sum, count)) {
+        a_facet.stats.fvmin = std::min<double>(a_facet.stats.fvmin, fmin);
+        a_facet.stats.fvmax = std::max<double>(a_facet.stats.fvmax, fmax);
+        a_facet.stats.fvsum += sum;
+        a_facet.stats.fvcount += count;
+    }
+
+    return true;
+}
+
+bool Index::compute_range_facet_counts(facet& a_facet, const field& facet_field, const bool should_compute_stats,
+                                       const uint32_t* result_ids, const size_t results_size) const {
+    std::pair<int64_t, std::string> range_pair;
+    const auto float_column_it = float_column_index.find(facet_field.name);
+
+    if(float_column_it != float_column_index.end()) {
+        // histogram of the column values of the results: the column key is the same key the ranges are defined on
+        const float_column_t* column = float_column_it->second;
+        float value;
+
+        for(size_t i = 0; i < results_size; i++) {
+            if(column->get(result_ids[i], value) && a_facet.get_range(float_column_t::to_key(value), range_pair)) {
+                a_facet.result_map[range_pair.first].count++;
+            }
+
+            if(((i + 1) % 16384) == 0) {
+                BREAK_CIRCUIT_BREAKER
+            }
+        }
+
+        if(should_compute_stats) {
+            compute_float_facet_stats(a_facet, facet_field.name, result_ids, results_size);
+        }
+
+        return true;
+    }
+
+    const auto numerical_index_it = numerical_index.find(facet_field.name);
+    if(facet_field.is_float() || numerical_index_it == numerical_index.end() ||
+       numerical_index_it->second->size() * RANGE_FACET_MIN_RESULTS_PER_VALUE > results_size) {
+        return false;
+    }
+
+    // the count of each distinct value is a single intersection of its id list with the results
+    std::vector<std::pair<int64_t, size_t>> value_counts;
+    numerical_index_it->second->get_value_counts(result_ids, results_size, value_counts);
+
+    for(const auto& value_count: value_counts) {
+        if(a_facet.get_range(value_count.first, range_pair)) {
+            a_facet.result_map[range_pair.first].count += value_count.second;
+        }
+
+        if(should_compute_stats) {
+            a_facet.stats.fvmin = std::min<double>(a_facet.stats.fvmin, value_count.first);
+            a_facet.stats.fvmax = std::max<double>(a_facet.stats.fvmax, value_count.first);
+            a_facet.stats.fvsum += double(value_count.first) * value_count.second;
+            a_facet.stats.fvcount += value_count.second;
+        }
+    }
+
+    return true;
+}
+
+void Index::fill_dense_facet_counts(facet& a_facet, const facet_info_t& facet_info,
+                                    const facet_forward_index_t* forward_index, const std::vector<uint32_t>& counts,
+                                    const uint32_t* result_ids, const size_t results_size, const size_t stride) const {
+    const bool use_facet_query = facet_info.use_facet_query;
+    const auto& fquery_hashes = facet_info.hashes;
+    auto facet_sort_index_it = sort_index.find(a_facet.sort_field);
+
+    const size_t num_codes = counts.size();
+    const uint32_t* facet_codes = nullptr;
+    const uint32_t* facet_code_positions = nullptr;
+
+    // Each counted value needs a document to read the value from: the last counted document having it,
+    // as in the per document path. It is found by walking the sampled results backwards.
+    std::vector<uint32_t> code_doc_ids(num_codes, UINT32_MAX);
+    std::vector<uint32_t> code_array_pos(num_codes, 0);
+    size_t num_unresolved = 0;
+
+    for(size_t code = 0; code < num_codes; code++) {
+        num_unresolved += (counts[code] != 0);
+    }
+
+    for(size_t i = ((results_size - 1) / stride) * stride; num_unresolved != 0; i -= stride) {
+        const auto num_doc_codes = forward_index->get(result_ids[i], facet_codes, facet_code_positions);
+
+        for(size_t j = 0; j < num_doc_codes; j++) {
+            const auto code = facet_codes[j];
+            if(counts[code] != 0 && code_doc_ids[code] == UINT32_MAX) {
+                code_doc_ids[code] = result_ids[i];
+                code_array_pos[code] = (facet_code_positions == nullptr) ? 0 : facet_code_positions[j];
+                num_unresolved--;
+            }
+        }
+
+        if(i < stride) {
+            break;
+        }
+    }
+
+    for(size_t code = 0; code < num_codes; code++) {
+        if(counts[code] == 0) {
+            continue;
+        }
+
+        const uint32_t fhash = forward_index->get_facet_id(code);
+        if(use_facet_query && fquery_hashes.find(fhash) == fquery_hashes.end()) {
+            continue;
+        }
+
+        facet_count_t& facet_count = a_facet.result_map[fhash];
+        facet_count.count += counts[code];
+        facet_count.doc_id = code_doc_ids[code];
+        facet_count.array_pos = code_array_pos[code];
+
+        if(use_facet_query) {
+            a_facet.hash_tokens[fhash] = fquery_hashes.at(fhash);
+        }
+
+        if(!a_facet.sort_field.empty()) {
+            facet_count.sort_field_val = get_doc_val_from_sort_index(facet_sort_index_it,
+                                                                     facet_count.doc_id);
+        }
+    }
+}
+
 Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_query,
                               bool estimate_facets, size_t facet_sample_percent,
                               const std::vector<facet_info_t>& facet_infos,
@@ -1593,6 +1865,11 @@ Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_
             continue;
         }
 
+        if(a_facet.is_range_query && group_limit == 0 && !estimate_facets && !facet_field.is_array() &&
+           compute_range_facet_counts(a_facet, facet_field, should_compute_stats, result_ids, results_size)) {
+            continue;
+        }
+
         if(use_value_index) {
             // LOG(INFO) << "Using intersection to find facets";
             a_facet.is_intersected = true;
@@ -1637,7 +1914,16 @@ Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_
 
             if(should_compute_stats) {
                 auto numerical_index_it = numerical_index.find(a_facet.field_name);
-                if(numerical_index_it != numerical_index.end()) {
+                auto float_column_it = float_column_index.find(a_facet.field_name);
+
+                if(numerical_index_it != numerical_index.end() && float_column_it != float_column_index.end()) {
+                    // raw values are read straight off the column instead of probing every distinct value
+                    float fmin, fmax;
+                    if(float_column_it->second->get_min_max(result_ids, results_size, fmin, fmax)) {
+                        a_facet.stats.fvmin = fmin;
+                        a_facet.stats.fvmax = fmax;
+                    }
+                } else if(numerical_index_it != numerical_index.end()) {
                     auto min_max_pair = numerical_index_it->second->get_min_max(result_ids,
                                                                                 results_size);
                     if(facet_field.is_float()) {
@@ -1658,12 +1944,77 @@ Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_
 
             const auto& fhash_int64_map = facet_index_v4->get_fhash_int64_map(a_facet.field_name);
 
-            const auto facet_field_is_array = facet_field.is_array();
             const auto facet_field_is_int64 = facet_field.is_int64();
 
-            const auto& facet_index = facet_index_v4->get_facet_hash_index(facet_field.name);
-            posting_list_t::iterator_t facet_index_it = facet_index->new_iterator();
-            std::vector<uint32_t> facet_hashes(1);
+            // facet hashes of a document are already deduplicated in the forward index
+            const auto forward_index = facet_index_v4->get_facet_forward_index(facet_field.name);
+            const uint32_t* facet_codes = nullptr;
+            const uint32_t* facet_code_positions = nullptr;
+
+            // Stats of a float field are computed off its column in one pass, so that its values are counted like any
+            // other field's.
+            bool compute_stats_per_doc = should_compute_stats;
+            if(should_compute_stats && !estimate_facets &&
+               compute_float_facet_stats(a_facet, facet_field.name, result_ids, results_size)) {
+                compute_stats_per_doc = false;
+            }
+
+            // Low cardinality fields are counted into a flat array indexed by the field's dense facet codes, as long as
+            // the array is not much larger than the result set.
+            const bool use_dense_counts = a_facet.use_dense_counts && group_limit == 0 && !a_facet.is_range_query &&
+                                          !compute_stats_per_doc &&
+                                          forward_index->num_facet_ids() <= facet_forward_index_t::MAX_DENSE_COUNT_IDS &&
+                                          forward_index->num_codes() <= 8 * results_size;
+
+            if(use_dense_counts) {
+                // sketched facets are not sampled: their dense counts are exact
+                const size_t stride = (estimate_facets && a_facet.sketch_capacity == 0) ? facet_sample_mod_value : 1;
+                const size_t num_codes = forward_index->num_codes();
+                std::vector<uint32_t> counts(num_codes, 0);
+
+                // chunks are a multiple of the stride so that the same results are sampled as in the per document path
+                const size_t chunk_size = 16384 * stride;
+                for(size_t offset = 0; offset < results_size; offset += chunk_size) {
+                    forward_index->count(result_ids + offset, std::min(chunk_size, results_size - offset), stride,
+                                         counts.data());
+                    BREAK_CIRCUIT_BREAKER
+                }
+
+                if(a_facet.defer_code_counts) {
+                    // summed with the counts of the other result partitions before the results are filled in
+                    a_facet.code_counts = std::move(counts);
+                    continue;
+                }
+
+                fill_dense_facet_counts(a_facet, facet_infos[findex], forward_index, counts, result_ids, results_size,
+                                        stride);
+                continue;
+            }
+
+            if(a_facet.sketch_capacity != 0) {
+                // every result is streamed into a bounded number of counters, which are merged across partitions
+                space_saving_sketch_t value_sketch(a_facet.sketch_capacity);
+
+                for(size_t i = 0; i < results_size; i++) {
+                    const uint32_t doc_seq_id = result_ids[i];
+                    const size_t num_facet_codes = forward_index->get(doc_seq_id, facet_codes, facet_code_positions);
+
+                    for(size_t j = 0; j < num_facet_codes; j++) {
+                        const uint32_t fhash = forward_index->get_facet_id(facet_codes[j]);
+                        if(!use_facet_query || fquery_hashes.find(fhash) != fquery_hashes.end()) {
+                            value_sketch.update(fhash, doc_seq_id,
+                                                (facet_code_positions == nullptr) ? 0 : facet_code_positions[j]);
+                        }
+                    }
+
+                    if(((i + 1) % 16384) == 0) {
+                        RETURN_CIRCUIT_BREAKER_OP
+                    }
+                }
+
+                a_facet.value_sketch = std::move(value_sketch);
+                continue;
+            }
 
             if (group_limit != 0) {
                 group_by_field_it_vec = get_group_by_field_iterators(group_by_fields);
@@ -1678,23 +2029,12 @@ Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_
                 }
 
                 uint32_t doc_seq_id = result_ids[i];
-                facet_index_it.skip_to(doc_seq_id);
+                const size_t num_facet_codes = forward_index->get(doc_seq_id, facet_codes, facet_code_positions);
 
-                if(!facet_index_it.valid()) {
-                    break;
-                }
-
-                if(facet_index_it.id() != doc_seq_id) {
+                if(num_facet_codes == 0) {
                     continue;
                 }
 
-                facet_hashes.clear();
-                if(facet_field_is_array) {
-                    posting_list_t::get_offsets(facet_index_it, facet_hashes);
-                } else {
-                    facet_hashes.push_back(facet_index_it.offset());
-                }
-
                 uint64_t distinct_id = 0;
                 if(group_limit) {
                     distinct_id = 1;
@@ -1708,21 +2048,10 @@ Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_
                     RETURN_CIRCUIT_BREAKER_OP
                 }
 
-                std::set<uint32_t> unique_facet_hashes;
-
-                for(size_t j = 0; j < facet_hashes.size(); j++) {
-                    const auto& fhash = facet_hashes[j];
-
-                    // explicitly check for value of facet_hashes to avoid set lookup/insert for non-array faceting
-                    if(facet_hashes.size() > 1) {
-                        if(unique_facet_hashes.count(fhash) != 0) {
-                            continue;
-                        } else {
-                            unique_facet_hashes.insert(fhash);
-                        }
-                    }
+                for(size_t j = 0; j < num_facet_codes; j++) {
+                    const uint32_t fhash = forward_index->get_facet_id(facet_codes[j]);
 
-                    if(should_compute_stats) {
+                    if(compute_stats_per_doc) {
                         int64_t val = fhash;
                         if(facet_field_is_int64) {
                             if(fhash_int64_map.find(fhash) != fhash_int64_map.end()) {
@@ -1752,7 +2081,7 @@ Option<bool> Index::do_facets(std::vector<facet>& facets, facet_query_t & facet_
                         facet_count_t& facet_count = a_facet.result_map[fhash];
                         //LOG(INFO) << "field: " << a_facet.field_name << ", doc id: " << doc_seq_id << ", hash: " <<  fhash;
                         facet_count.doc_id = doc_seq_id;
-                        facet_count.array_pos = j;
+                        facet_count.array_pos = (facet_code_positions == nullptr) ? 0 : facet_code_positions[j];
                         if(group_limit) {
                             a_facet.hash_groups[fhash].emplace(distinct_id);
                         } else {
@@ -2485,6 +2814,288 @@ Option<filter_result_t> Index::do_filtering_with_reference_ids(const std::string
     return Option<filter_result_t>(filter_result);
 }
 
+void Index::get_filter_and_clauses(const filter_node_t* filter_node, std::vector<const filter_node_t*>& clauses) {
+    if (filter_node->isOperator && filter_node->filter_operator == AND && !filter_node->is_object_filter_root) {
+        get_filter_and_clauses(filter_node->left, clauses);
+        get_filter_and_clauses(filter_node->right, clauses);
+        return;
+    }
+
+    clauses.push_back(filter_node);
+}
+
+std::string Index::get_filter_clause_field(const filter_node_t* filter_node) {
+    if (filter_node->is_object_filter_root) {
+        return "";
+    }
+
+    if (!filter_node->isOperator) {
+        return filter_node->filter_exp.referenced_collection_name.empty() ? filter_node->filter_exp.field_name : "";
+    }
+
+    const auto left_field = get_filter_clause_field(filter_node->left);
+    return (left_field == get_filter_clause_field(filter_node->right)) ? left_field : "";
+}
+
+Option<bool> Index::compute_disjunctive_facet_ids(search_args* search_params, const filter_node_t* filter_root) const {
+    auto& facets = search_params->facets;
+    std::set<std::string> disjunctive_fields;
+
+    for (const auto& a_facet: facets) {
+        if (a_facet.is_disjunctive && !a_facet.is_top_k && a_facet.reference_collection_name.empty()) {
+            disjunctive_fields.insert(a_facet.field_name);
+        }
+    }
+
+    if (filter_root == nullptr || disjunctive_fields.empty()) {
+        return Option<bool>(true);
+    }
+
+    std::vector<const filter_node_t*> clauses;
+    get_filter_and_clauses(filter_root, clauses);
+
+    // Evaluates a clause on its own, or only against the candidate ids when they are given, in which case the clause
+    // is evaluated lazily and probed with the candidates instead of being materialized. Returns false when the clause
+    // has references or could not be evaluated in time.
+    auto get_clause_ids = [&](const filter_node_t* clause, const std::vector<uint32_t>* candidate_ids,
+                              std::vector<uint32_t>& ids) -> Option<bool> {
+        filter_result_iterator_t clause_it(get_collection_name(), this, clause, candidate_ids != nullptr,
+                                           search_params->max_filter_by_candidates,
+                                           search_begin_us, search_stop_us, search_params->validate_field_names,
+                                           &filter_result_cache);
+        auto init_op = clause_it.init_status();
+        if (!init_op.ok()) {
+            return init_op;
+        }
+
+        if (candidate_ids != nullptr) {
+            filter_result_t probe_result;
+            clause_it.and_scalar(candidate_ids->data(), candidate_ids->size(), probe_result);
+            if (clause_it.validity == filter_result_iterator_t::timed_out ||
+                probe_result.coll_to_references != nullptr) {
+                return Option<bool>(false);
+            }
+
+            ids.assign(probe_result.docs, probe_result.docs + probe_result.count);
+            return Option<bool>(true);
+        }
+
+        clause_it.compute_iterators();
+        if (clause_it.validity == filter_result_iterator_t::timed_out || clause_it.result_has_references()) {
+            return Option<bool>(false);
+        }
+
+        uint32_t* clause_ids = nullptr;
+        const auto clause_ids_len = clause_it.to_filter_id_array(clause_ids);
+        ids.assign(clause_ids, clause_ids + clause_ids_len);
+        delete [] clause_ids;
+
+        return Option<bool>(true);
+    };
+
+    auto intersect = [](const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        std::vector<uint32_t> ids;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(ids));
+        return ids;
+    };
+
+    // facet field => ids matched by the clauses on that field
+    std::map<std::string, std::vector<uint32_t>> own_clause_ids;
+    std::vector<const filter_node_t*> shared_clauses;
+
+    for (const auto clause: clauses) {
+        const auto clause_field = get_filter_clause_field(clause);
+        if (disjunctive_fields.count(clause_field) == 0) {
+            shared_clauses.push_back(clause);
+            continue;
+        }
+
+        auto own_it = own_clause_ids.find(clause_field);
+        std::vector<uint32_t> clause_ids;
+        auto clause_op = get_clause_ids(clause, own_it == own_clause_ids.end() ? nullptr : &own_it->second,
+                                        clause_ids);
+        if (!clause_op.ok() || !clause_op.get()) {
+            return clause_op.ok() ? Option<bool>(true) : clause_op;
+        }
+
+        if (own_it == own_clause_ids.end()) {
+            own_clause_ids.emplace(clause_field, std::move(clause_ids));
+        } else {
+            own_it->second = std::move(clause_ids);
+        }
+    }
+
+    if (own_clause_ids.empty()) {
+        return Option<bool>(true);
+    }
+
+    // Only the first shared clause is materialized, the others are probed with the ids matched so far.
+    std::vector<uint32_t> shared_ids;
+    for (size_t i = 0; i < shared_clauses.size(); i++) {
+        if (i != 0 && shared_ids.empty()) {
+            break;
+        }
+
+        std::vector<uint32_t> clause_ids;
+        auto clause_op = get_clause_ids(shared_clauses[i], i == 0 ? nullptr : &shared_ids, clause_ids);
+        if (!clause_op.ok() || !clause_op.get()) {
+            return clause_op.ok() ? Option<bool>(true) : clause_op;
+        }
+
+        shared_ids = std::move(clause_ids);
+    }
+
+    const auto& field_query_tokens = search_params->field_query_tokens;
+    const bool is_wildcard_non_phrase_query = !field_query_tokens[0].q_include_tokens.empty() &&
+                                              field_query_tokens[0].q_include_tokens[0].value == "*" &&
+                                              field_query_tokens[0].q_phrases.empty();
+
+    // The results of the query with only the shared clauses applied, which every facet narrows down further.
+    std::vector<uint32_t> base_ids;
+
+    if (is_wildcard_non_phrase_query && search_params->vector_query.field_name.empty()) {
+        if (!shared_clauses.empty()) {
+            base_ids = std::move(shared_ids);
+        } else {
+            std::shared_lock lock(mutex);
+            seq_ids->uncompress(base_ids);
+        }
+    } else if (shared_clauses.empty() || !shared_ids.empty()) {
+        filter_result_iterator_t* base_filter_it;
+        if (shared_clauses.empty()) {
+            base_filter_it = new filter_result_iterator_t(get_collection_name(), this, nullptr, false,
+                                                          search_params->max_filter_by_candidates,
+                                                          search_begin_us, search_stop_us,
+                                                          search_params->validate_field_names);
+        } else {
+            auto filter_ids = new uint32_t[shared_ids.size()];
+            std::copy(shared_ids.begin(), shared_ids.end(), filter_ids);
+            base_filter_it = new filter_result_iterator_t(filter_ids, shared_ids.size(),
+                                                          search_params->max_filter_by_candidates,
+                                                          search_begin_us, search_stop_us);
+        }
+        std::unique_ptr<filter_result_iterator_t> base_filter_guard(base_filter_it);
+
+        auto base_field_query_tokens = field_query_tokens;
+        auto base_sort_fields_std = search_params->sort_fields_std;
+        std::vector<facet> base_facets;
+        Topster<KV>* base_topster = nullptr;
+        Topster<KV>* base_curated_topster = nullptr;
+        size_t base_all_result_ids_len = 0;
+        spp::sparse_hash_map<uint64_t, uint32_t> base_groups_processed;
+        std::vector<std::vector<art_leaf*>> base_searched_queries;
+        tsl::htrie_map<char, token_leaf> base_qtoken_set;
+        std::vector<std::vector<KV*>> base_raw_result_kvs, base_curation_result_kvs;
+        std::set<uint32_t> base_group_by_missing_value_ids;
+
+        auto base_op = search(base_field_query_tokens,
+                              search_params->search_fields,
+                              search_params->match_type,
+                              base_filter_it, base_facets, search_params->facet_query,
+                              search_params->max_facet_values,
+                              search_params->included_ids, search_params->excluded_ids,
+                              base_sort_fields_std, search_params->num_typos,
+                              base_topster, base_curated_topster,
+                              search_params->fetch_size,
+                              search_params->per_page, search_params->offset, search_params->token_order,
+                              search_params->prefixes, search_params->drop_tokens_threshold,
+                              base_all_result_ids_len, base_groups_processed,
+                              base_searched_queries,
+                              base_qtoken_set,
+                              base_raw_result_kvs, base_curation_result_kvs,
+                              search_params->typo_tokens_threshold,
+                              search_params->group_limit,
+                              search_params->group_by_fields,
+                              search_params->group_missing_values,
+                              search_params->default_sorting_field,
+                              search_params->prioritize_exact_match,
+                              search_params->prioritize_token_position,
+                              search_params->prioritize_num_matching_fields,
+                              search_params->exhaustive_search,
+                              search_params->concurrency,
+                              search_params->search_cutoff_ms,
+                              search_params->min_len_1typo,
+                              search_params->min_len_2typo,
+                              search_params->max_candidates,
+                              search_params->infixes,
+                              search_params->max_extra_prefix,
+                              search_params->max_extra_suffix,
+                              search_params->facet_query_num_typos,
+                              search_params->filter_curated_hits,
+                              search_params->split_join_tokens,
+                              search_params->vector_query,
+                              search_params->facet_sample_percent,
+                              search_params->facet_sample_threshold,
+                              search_params->drop_tokens_mode,
+                              search_params->facet_index_types,
+                              search_params->enable_typos_for_numerical_tokens,
+                              search_params->enable_synonyms,
+                              search_params->demote_synonym_match,
+                              search_params->synonym_prefix,
+                              search_params->synonym_num_typos,
+                              search_params->enable_lazy_filter,
+                              search_params->enable_typos_for_alpha_numerical_tokens,
+                              search_params->max_filter_by_candidates,
+                              search_params->rerank_hybrid_matches,
+                              search_params->validate_field_names,
+                              false,
+                              base_group_by_missing_value_ids,
+                              search_params->collection,
+                              search_params->synonym_sets,
+                              search_params->diversity,
+                              &base_ids);
+
+        // The filter iterator can be updated in places like `Index::do_phrase_search`.
+        base_filter_guard.release();
+        base_filter_guard.reset(base_filter_it);
+
+        delete base_topster;
+        delete base_curated_topster;
+
+        if (!base_op.ok()) {
+            return base_op;
+        }
+    }
+
+    // Each facet is counted against the base results narrowed by the clauses of all the other facets, which are
+    // intersected as prefixes and suffixes instead of once for every facet.
+    std::vector<const std::vector<uint32_t>*> field_ids;
+    for (const auto& own_kv: own_clause_ids) {
+        field_ids.push_back(&own_kv.second);
+    }
+
+    const size_t num_fields = field_ids.size();
+    std::vector<std::vector<uint32_t>> suffix_ids(num_fields + 1);
+    suffix_ids[num_fields] = std::move(base_ids);
+    for (size_t i = num_fields; i-- > 0;) {
+        suffix_ids[i] = intersect(*field_ids[i], suffix_ids[i + 1]);
+    }
+
+    std::map<std::string, std::vector<uint32_t>> facet_result_ids;
+    std::vector<uint32_t> prefix_ids;
+    size_t i = 0;
+
+    for (const auto& own_kv: own_clause_ids) {
+        facet_result_ids[own_kv.first] = (i == 0) ? suffix_ids[1] : intersect(prefix_ids, suffix_ids[i + 1]);
+        prefix_ids = (i == 0) ? own_kv.second : intersect(prefix_ids, own_kv.second);
+        i++;
+    }
+
+    for (auto& a_facet: facets) {
+        if (!a_facet.is_disjunctive || a_facet.is_top_k || !a_facet.reference_collection_name.empty()) {
+            continue;
+        }
+
+        const auto result_ids_it = facet_result_ids.find(a_facet.field_name);
+        if (result_ids_it != facet_result_ids.end()) {
+            a_facet.disjunctive_result_ids = result_ids_it->second;
+            a_facet.has_disjunctive_result_ids = true;
+        }
+    }
+
+    return Option<bool>(true);
+}
+
 Option<bool> Index::run_search(search_args* search_params) {
     auto& filter_root = search_params->filter_tree_root_guard;
     std::set<uint32_t> group_by_missing_value_ids;
@@ -2500,11 +3111,18 @@ Option<bool> Index::run_search(search_args* search_params) {
         return Option<bool>(true);
     }
 
+    filter_result_iterator_t::reorder_filter_tree(this, filter_root.get());
+
     auto filter_result_iterator = new filter_result_iterator_t(get_collection_name(), this, filter_root.get(),
                                                                search_params->enable_lazy_filter,
                                                                search_params->max_filter_by_candidates,
                                                                search_begin_us, search_stop_us,
-                                                               search_params->validate_field_names);
+                                                               search_params->validate_field_names,
+                                                               &filter_result_cache,
+                                                               search_params->explain ? &search_params->filter_plan :
+                                                                                        nullptr,
+                                                               search_params->profile_filter_by ?
+                                                                    &search_params->filter_profile : nullptr);
     std::unique_ptr<filter_result_iterator_t> filter_iterator_guard(filter_result_iterator);
 
     auto filter_init_op = filter_result_iterator->init_status();
@@ -2588,6 +3206,7 @@ Option<bool> Index::run_search(search_args* search_params) {
         // The filter iterator can be updated in places like `Index::do_phrase_search`.
         filter_iterator_guard.release();
         filter_iterator_guard.reset(filter_result_iterator);
+        search_params->filter_search_cutoff = filter_result_iterator->validity == filter_result_iterator_t::timed_out;
 
         if (!res.ok()) {
             return res;
@@ -2700,6 +3319,11 @@ Option<bool> Index::run_search(search_args* search_params) {
         search_params->groups_processed.clear();
         search_params->all_result_ids_len = 0;
         group_by_missing_value_ids.clear();
+    } else {
+        auto disjunctive_op = compute_disjunctive_facet_ids(search_params, filter_root.get());
+        if (!disjunctive_op.ok()) {
+            return disjunctive_op;
+        }
     }
 
     auto res = search(search_params->field_query_tokens,
@@ -2762,6 +3386,8 @@ Option<bool> Index::run_search(search_args* search_params) {
     // The filter iterator can be updated in places like `Index::do_phrase_search`.
     filter_iterator_guard.release();
     filter_iterator_guard.reset(filter_result_iterator);
+    search_params->filter_search_cutoff = search_params->filter_search_cutoff ||
+                                          filter_result_iterator->validity == filter_result_iterator_t::timed_out;
 
     if (search_params->group_limit) {
         // Doing std::max since in case of group_by, loglog_counter returns an approximate count of the number of distinct
@@ -3484,7 +4110,8 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                    bool rerank_hybrid_matches, const bool& validate_field_names, bool is_group_by_first_pass,
                    std::set<uint32_t>& group_by_missing_value_ids, Collection const *const collection,
                    const std::vector<std::string>& synonym_sets,
-                   const diversity_t& diversity) const {
+                   const diversity_t& diversity,
+                   std::vector<uint32_t>* result_ids) const {
     std::shared_lock lock(mutex);
 
     group_found_params_t group_found_params{};
@@ -3533,8 +4160,28 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
     bool const& filter_by_provided = filter_result_iterator->is_filter_provided();
     bool const& no_filter_by_matches = filter_by_provided && filter_result_iterator->approx_filter_ids_length == 0;
 
+    const size_t num_search_fields = std::min(the_fields.size(), (size_t) FIELD_LIMIT_NUM);
+
+    // handle exclusion of tokens/phrases
+    uint32_t* exclude_token_ids = nullptr;
+    size_t exclude_token_ids_size = 0;
+    handle_exclusion(num_search_fields, field_query_tokens, the_fields, exclude_token_ids, exclude_token_ids_size);
+
+    // Prepare excluded document IDs that we can later remove from the result set
+    uint32_t* excluded_result_ids = nullptr;
+    size_t excluded_result_ids_size = ArrayUtils::or_scalar(exclude_token_ids, exclude_token_ids_size,
+                                                            &curated_ids_sorted[0], curated_ids_sorted.size(),
+                                                            &excluded_result_ids);
+
     // If curation is not involved and there are no filter matches, return early.
     if (curated_ids_sorted.empty() && no_filter_by_matches) {
+        // disjunctive facets can still have values once their own filter clauses are left out
+        do_disjunctive_facets(facets, facet_query, facet_query_num_typos, false, facet_sample_percent,
+                              group_limit, group_by_fields, group_missing_values, max_facet_values, max_candidates,
+                              facet_index_types, is_group_by_first_pass, group_by_missing_value_ids, collection,
+                              *filter_result_iterator, excluded_result_ids, excluded_result_ids_size);
+        delete [] exclude_token_ids;
+        delete [] excluded_result_ids;
         return Option(true);
     }
 
@@ -3542,28 +4189,17 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
     // auto begin = std::chrono::high_resolution_clock::now();
     uint32_t* all_result_ids = nullptr;
 
-    const size_t num_search_fields = std::min(the_fields.size(), (size_t) FIELD_LIMIT_NUM);
-
-    // handle exclusion of tokens/phrases
-    uint32_t* exclude_token_ids = nullptr;
-    size_t exclude_token_ids_size = 0;
-    handle_exclusion(num_search_fields, field_query_tokens, the_fields, exclude_token_ids, exclude_token_ids_size);
-
     int sort_order[3];  // 1 or -1 based on DESC or ASC respectively
     std::array<spp::sparse_hash_map<uint32_t, int64_t, Hasher32>*, 3> field_values;
     std::vector<size_t> geopoint_indices;
     auto populate_op = populate_sort_mapping(sort_order, geopoint_indices, sort_fields_std, field_values,
                                              validate_field_names);
     if (!populate_op.ok()) {
+        delete [] exclude_token_ids;
+        delete [] excluded_result_ids;
         return populate_op;
     }
 
-    // Prepare excluded document IDs that we can later remove from the result set
-    uint32_t* excluded_result_ids = nullptr;
-    size_t excluded_result_ids_size = ArrayUtils::or_scalar(exclude_token_ids, exclude_token_ids_size,
-                                                            &curated_ids_sorted[0], curated_ids_sorted.size(),
-                                                            &excluded_result_ids);
-
     const auto is_wildcard_query = !field_query_tokens.empty() && !field_query_tokens[0].q_include_tokens.empty() &&
                                         field_query_tokens[0].q_include_tokens[0].value == "*";
 
@@ -3657,7 +4293,14 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
 
             std::vector<std::pair<float, single_filter_result_t>> dist_results;
 
-            filter_result_iterator->compute_iterators();
+            // The approximate count of a lazy filter is only an upper bound, e.g. an AND takes the smallest count of
+            // its children, so a filter estimated near the cutoff is computed to decide on a flat search. A broader
+            // filter is only probed by HNSW through the filter functor, so its ids are never materialized.
+            const bool is_filter_computed = filter_result_iterator->approx_filter_ids_length <
+                                            FLAT_SEARCH_ESTIMATE_FACTOR * vector_query.flat_search_cutoff;
+            if (is_filter_computed) {
+                filter_result_iterator->compute_iterators();
+            }
 
             uint32_t filter_id_count = filter_result_iterator->approx_filter_ids_length;
 
@@ -3667,6 +4310,16 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                 (filter_id_count >= vector_query.flat_search_cutoff && filter_result_iterator->validity == filter_result_iterator_t::valid)) {
                 dist_results.clear();
                 process_results_hnsw_index(filter_result_iterator, vector_query, field_vector_index, filterFunctor, k, dist_results, true);
+
+                // An estimated filter can still be selective enough for HNSW to run out of candidates, in which case
+                // the filter's ids are searched exhaustively.
+                if (filter_by_provided && vector_query.flat_search_cutoff != 0 && !is_filter_computed &&
+                    dist_results.size() < k &&
+                    filter_result_iterator->validity != filter_result_iterator_t::timed_out) {
+                    dist_results.clear();
+                    filter_result_iterator->reset();
+                    process_results_bruteforce(filter_result_iterator, vector_query, field_vector_index, dist_results);
+                }
             }
 
             search_cutoff = search_cutoff || filter_result_iterator->validity == filter_result_iterator_t::timed_out;
@@ -4251,18 +4904,20 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
     std::vector<uint32_t> top_k_result_ids, top_k_curated_result_ids;
     std::vector<facet> top_k_facets;
 
-    delete [] exclude_token_ids;
-    delete [] excluded_result_ids;
-
     bool estimate_facets = (facet_sample_percent > 0 && facet_sample_percent < 100 &&
                             all_result_ids_len > facet_sample_threshold);
     bool is_wildcard_no_filter_query = is_wildcard_non_phrase_query && !filter_by_provided && vector_query.field_name.empty();
 
+    do_disjunctive_facets(facets, facet_query, facet_query_num_typos, estimate_facets, facet_sample_percent,
+                          group_limit, group_by_fields, group_missing_values, max_facet_values, max_candidates,
+                          facet_index_types, is_group_by_first_pass, group_by_missing_value_ids, collection,
+                          *filter_result_iterator, excluded_result_ids, excluded_result_ids_size);
+
+    delete [] exclude_token_ids;
+    delete [] excluded_result_ids;
+
     if(!facets.empty()) {
         const size_t num_threads = std::min(concurrency, all_result_ids_len);
-
-        const size_t window_size = (num_threads == 0) ? 0 :
-                                   (all_result_ids_len + num_threads - 1) / num_threads;  // rounds up
         size_t num_processed = 0;
         std::mutex m_process;
         std::condition_variable cv_process;
@@ -4274,7 +4929,27 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                             max_candidates, facet_infos, facet_index_types, is_group_by_first_pass,
                             group_by_missing_value_ids, collection, *filter_result_iterator, reference_facet_ids);
 
-        std::vector<std::vector<facet>> facet_batches(num_threads);
+        // Hash based facets are counted in parallel over partitions of the results. A partition is not made smaller
+        // than the configured minimum, since the cost of queueing a thread outweighs counting a few results.
+        // Referenced ids are batched alongside the partitions, so reference facets keep one partition per thread.
+        const size_t min_partition_size = std::max<size_t>(1, Config::get_instance().get_facet_min_partition_size());
+        const size_t num_partitions = !reference_facet_ids.empty() ? num_threads :
+                                      std::min(num_threads, (all_result_ids_len + min_partition_size - 1) /
+                                                            min_partition_size);
+
+        const size_t window_size = (num_partitions == 0) ? 0 :
+                                   (all_result_ids_len + num_partitions - 1) / num_partitions;  // rounds up
+
+        // When the results are exactly the documents of a registered facet count filter, the top values of a field
+        // are read off its maintained counts instead of being counted. Hierarchical facets are truncated per level,
+        // so they are counted. Curated results can have as many documents as the filter but not the same ones.
+        const facet_count_filter_t* count_filter = nullptr;
+        if(is_wildcard_non_phrase_query && vector_query.field_name.empty() && group_limit == 0 && !estimate_facets &&
+           excluded_result_ids_size == 0 && included_ids.empty()) {
+            count_filter = get_facet_count_filter(filter_result_iterator, all_result_ids_len);
+        }
+
+        std::vector<std::vector<facet>> facet_batches(num_partitions);
         std::vector<std::vector<facet>> value_facets(concurrency);
         std::vector<std::unordered_map<std::string, reference_filter_result_t>> batch_reference_facet_ids;
 
@@ -4282,6 +4957,11 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
 
         for(size_t i = 0; i < facets.size(); i++) {
             const auto& this_facet = facets[i];
+            // disjunctive facets have already been counted against their own results
+            if(this_facet.has_disjunctive_result_ids) {
+                continue;
+            }
+
             //process facets separately which has top_k set to true
             if(this_facet.is_top_k) {
                 top_k_facets.emplace_back(this_facet.field_name, this_facet.orig_index, this_facet.is_top_k, this_facet.facet_range_map,
@@ -4289,6 +4969,21 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                 continue;
             }
 
+            if(count_filter != nullptr && !facet_infos[i].use_facet_query && !facet_infos[i].should_compute_stats &&
+               !this_facet.is_range_query && !this_facet.is_sort_by_alpha && this_facet.sort_field.empty() &&
+               this_facet.reference_collection_name.empty() && !facet_infos[i].facet_field.nested &&
+               !facet_infos[i].facet_field.is_hierarchical()) {
+                std::vector<std::pair<uint32_t, uint32_t>> facet_id_counts;
+                count_filter->counts.get_top_counts(this_facet.field_name, max_facet_values, facet_id_counts);
+
+                for(const auto& facet_id_count: facet_id_counts) {
+                    facets[i].result_map[facet_id_count.first].count = facet_id_count.second;
+                }
+                facets[i].num_filter_values = count_filter->counts.num_values(this_facet.field_name);
+
+                continue;
+            }
+
             if(facet_infos[i].use_value_index) {
                 // value based faceting on a single thread
                 value_facets[num_value_facets % num_threads].emplace_back(this_facet.field_name, this_facet.orig_index,
@@ -4299,11 +4994,38 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                 continue;
             }
 
-            for(size_t j = 0; j < num_threads; j++) {
+            // Facets with the `sketch` strategy are estimated over all the results with a bounded number of counters
+            // instead of being counted over a sample of them. Grouped, range, stats, sorted and hierarchical facets
+            // are counted.
+            size_t sketch_capacity = 0;
+            if(facet_index_types[this_facet.orig_index] == sketch && group_limit == 0 &&
+               !this_facet.is_range_query && !facet_infos[i].should_compute_stats && !this_facet.is_sort_by_alpha &&
+               this_facet.sort_field.empty() && this_facet.reference_collection_name.empty() &&
+               !facet_infos[i].facet_field.is_hierarchical()) {
+                sketch_capacity = std::max<size_t>(FACET_SKETCH_MIN_COUNTERS,
+                                                   FACET_SKETCH_COUNTERS_PER_VALUE * max_facet_values);
+                facets[i].sketch_capacity = sketch_capacity;
+            }
+
+            // Whether the codes are counted densely depends on the size of the partition, so a sketched facet is
+            // decided once on the smallest partition: either every partition counts it densely or none does.
+            bool use_dense_counts = true;
+            if(sketch_capacity != 0 && num_partitions > 1) {
+                const auto forward_index = facet_index_v4->get_facet_forward_index(facet_infos[i].facet_field.name);
+                const size_t min_partition_len = (all_result_ids_len % window_size == 0) ? window_size :
+                                                 all_result_ids_len % window_size;
+                use_dense_counts = forward_index != nullptr && forward_index->num_codes() <= 8 * min_partition_len;
+            }
+
+            for(size_t j = 0; j < num_partitions; j++) {
                 facet_batches[j].emplace_back(this_facet.field_name, this_facet.orig_index, this_facet.is_top_k,
                                               this_facet.facet_range_map, this_facet.is_range_query,
                                               this_facet.is_sort_by_alpha, this_facet.sort_order, this_facet.sort_field,
                                               this_facet.reference_collection_name);
+                facet_batches[j].back().defer_code_counts = num_partitions > 1 &&
+                                                            this_facet.reference_collection_name.empty();
+                facet_batches[j].back().sketch_capacity = sketch_capacity;
+                facet_batches[j].back().use_dense_counts = use_dense_counts;
             }
         }
 
@@ -4352,7 +5074,7 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
             }
         }
 
-        for(size_t thread_id = 0; thread_id < num_threads && (result_index < all_result_ids_len || is_one_valid); thread_id++) {
+        for(size_t thread_id = 0; thread_id < num_partitions && (result_index < all_result_ids_len || is_one_valid); thread_id++) {
             size_t batch_res_len = window_size;
 
             if(result_index + window_size > all_result_ids_len) {
@@ -4451,20 +5173,73 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
         cv_process.wait(lock_process, [&](){ return num_processed == num_queued; });
         search_cutoff = parent_search_cutoff;
 
+        // Each partition counted the dense facet codes into its own array, so they are summed here without locking.
+        for(size_t k = 0; num_partitions > 1 && k < facet_batches[0].size(); k++) {
+            std::vector<uint32_t> code_counts;
+
+            for(auto& facet_batch: facet_batches) {
+                const auto& partition_code_counts = facet_batch[k].code_counts;
+                if(code_counts.size() < partition_code_counts.size()) {
+                    code_counts.resize(partition_code_counts.size(), 0);
+                }
+
+                for(size_t code = 0; code < partition_code_counts.size(); code++) {
+                    code_counts[code] += partition_code_counts[code];
+                }
+            }
+
+            if(code_counts.empty()) {
+                continue;
+            }
+
+            const auto orig_index = facet_batches[0][k].orig_index;
+            const auto forward_index = facet_index_v4->get_facet_forward_index(facet_infos[orig_index].facet_field.name);
+            fill_dense_facet_counts(facets[orig_index], facet_infos[orig_index], forward_index, code_counts,
+                                    all_result_ids, all_result_ids_len, 1);
+        }
+
+        for(auto& acc_facet: facets) {
+            if(acc_facet.value_sketch.capacity() == 0) {
+                continue;
+            }
+
+            const auto& facet_info = facet_infos[acc_facet.orig_index];
+
+            for(const auto& counter: acc_facet.value_sketch.get_counters()) {
+                facet_count_t& facet_count = acc_facet.result_map[counter.item];
+                facet_count.count = counter.count;
+                facet_count.count_error = counter.error;
+                facet_count.doc_id = counter.doc_id;
+                facet_count.array_pos = counter.array_pos;
+
+                if(facet_info.use_facet_query) {
+                    acc_facet.hash_tokens[counter.item] = facet_info.hashes.at(counter.item);
+                }
+            }
+
+            acc_facet.sketched = true;
+            acc_facet.count_error_bound = acc_facet.value_sketch.max_unmonitored_count();
+            acc_facet.value_sketch = space_saving_sketch_t();
+        }
+
         for(auto & acc_facet: facets) {
+            // facets with the `sketch` strategy are counted over all the results, densely or with a sketch, so their
+            // counts are not scaled
+            const bool is_sampled = estimate_facets && acc_facet.sketch_capacity == 0;
+
             for(auto& facet_kv: acc_facet.result_map) {
                 if(group_limit) {
                     facet_kv.second.count = acc_facet.hash_groups[facet_kv.first].size();
                 }
 
-                if(estimate_facets) {
+                if(is_sampled) {
                     facet_kv.second.count = size_t(double(facet_kv.second.count) * (100.0f / facet_sample_percent));
                 }
             }
 
             // value_result_map already contains the scaled counts
 
-            if(estimate_facets) {
+            if(is_sampled) {
                 acc_facet.sampled = true;
             }
         }
@@ -4496,6 +5271,10 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
                   facet_index_types, is_group_by_first_pass, group_by_missing_value_ids, collection, &reference_facet_ids);
     }
 
+    if(result_ids != nullptr) {
+        result_ids->assign(all_result_ids, all_result_ids + all_result_ids_len);
+    }
+
     all_result_ids_len += (is_group_by_first_pass ? 0 : curated_topster->size);
 
     if(!included_ids_map.empty() && group_limit != 0) {
@@ -4530,6 +5309,56 @@ Option<bool> Index::search(std::vector<query_tokens_t>& field_query_tokens, cons
     return Option(true);
 }
 
+void Index::do_disjunctive_facets(std::vector<facet>& facets, const facet_query_t& facet_query,
+                                  const size_t facet_query_num_typos, const bool estimate_facets,
+                                  const size_t facet_sample_percent, const size_t group_limit,
+                                  const std::vector<std::string>& group_by_fields, const bool group_missing_values,
+                                  const int max_facet_values, const size_t max_candidates,
+                                  const std::vector<facet_index_type_t>& facet_index_types,
+                                  const bool is_group_by_first_pass, std::set<uint32_t>& group_by_missing_value_ids,
+                                  Collection const *const collection, filter_result_iterator_t& filter_result_iterator,
+                                  const uint32_t* excluded_result_ids, const size_t excluded_result_ids_size) const {
+    std::vector<facet_info_t> facet_infos;
+
+    for(auto& acc_facet: facets) {
+        if(!acc_facet.has_disjunctive_result_ids) {
+            continue;
+        }
+
+        uint32_t* facet_result_ids = nullptr;
+        const size_t facet_result_ids_len = ArrayUtils::exclude_scalar(acc_facet.disjunctive_result_ids.data(),
+                                                                       acc_facet.disjunctive_result_ids.size(),
+                                                                       excluded_result_ids, excluded_result_ids_size,
+                                                                       &facet_result_ids);
+        std::unique_ptr<uint32_t[]> facet_result_ids_guard(facet_result_ids);
+
+        if(facet_infos.size() <= acc_facet.orig_index) {
+            facet_infos.resize(acc_facet.orig_index + 1);
+        }
+
+        std::vector<facet> this_facets;
+        this_facets.emplace_back(acc_facet.field_name, acc_facet.orig_index, acc_facet.is_top_k,
+                                 acc_facet.facet_range_map, acc_facet.is_range_query, acc_facet.is_sort_by_alpha,
+                                 acc_facet.sort_order, acc_facet.sort_field);
+
+        auto fq = facet_query;
+        std::vector<facet_info_t> this_facet_infos(1);
+        std::unordered_map<std::string, reference_filter_result_t> reference_facet_ids;
+        compute_facet_infos(this_facets, fq, facet_query_num_typos, facet_result_ids, facet_result_ids_len,
+                            group_by_fields, group_limit, false, max_candidates, this_facet_infos, facet_index_types,
+                            is_group_by_first_pass, group_by_missing_value_ids, collection, filter_result_iterator,
+                            reference_facet_ids);
+        facet_infos[acc_facet.orig_index] = std::move(this_facet_infos[0]);
+
+        do_facets(this_facets, fq, estimate_facets, facet_sample_percent, facet_infos, group_limit, group_by_fields,
+                  group_missing_values, facet_result_ids, facet_result_ids_len, max_facet_values, false,
+                  facet_index_types, is_group_by_first_pass, group_by_missing_value_ids, collection,
+                  &reference_facet_ids);
+
+        aggregate_facet(group_limit, this_facets[0], acc_facet);
+    }
+}
+
 void Index::get_reference_facet_ids(const uint32_t* all_result_ids, const size_t& all_result_ids_len,
                                     const std::string& collection_name, Collection const *const ref_collection,
                                     filter_result_iterator_t& fit,
@@ -4630,6 +5459,10 @@ void Index::aggregate_facet(const size_t group_limit, facet& this_facet, facet&
     acc_facet.sort_order = this_facet.sort_order;
     acc_facet.sort_field = this_facet.sort_field;
 
+    if(this_facet.value_sketch.capacity() != 0) {
+        acc_facet.value_sketch.merge(this_facet.value_sketch);
+    }
+
     for(auto & facet_kv: this_facet.result_map) {
         uint32_t fhash = 0;
         if(group_limit) {
@@ -5734,7 +6567,7 @@ Option<bool> Index::compute_sort_scores(const std::vector<sort_by>& sort_fields,
             if (!is_reference_sort) {
                 scores[i] = str_sort_index.at(sort_fields[i].name)->rank(seq_id);
             } else if (ref_seq_ids.empty()) {
-                scores[i] = adi_tree_t::NOT_FOUND;
+                scores[i] = string_sort_column_t::NOT_FOUND;
             } else {
                 auto& cm = CollectionManager::get_instance();
                 auto ref_collection = cm.get_collection(sort_fields[i].reference_collection_name);
@@ -5747,7 +6580,7 @@ Option<bool> Index::compute_sort_scores(const std::vector<sort_by>& sort_fields,
                                                                         sort_order[i] == -1);
             }
 
-            if(scores[i] == adi_tree_t::NOT_FOUND) {
+            if(scores[i] == string_sort_column_t::NOT_FOUND) {
                 if(sort_fields[i].order == sort_field_const::asc &&
                    sort_fields[i].missing_values == sort_by::missing_values_t::first) {
                     scores[i] = -scores[i];
@@ -5861,6 +6694,14 @@ Option<bool> Index::compute_sort_scores(const std::vector<sort_by>& sort_fields,
                     return Option<bool>(400, "Error computing decay function score.");
                 }
                 scores[i] = float_to_int64_t(score);
+            } else if (field_values[i] == &num_array_sentinel_value) {
+                // arrays are ordered by their smallest value when ascending and by their largest value when descending
+                int64_t min, max;
+                if (!is_reference_sort && min_max_index.at(sort_fields[i].name)->get(seq_id, min, max)) {
+                    scores[i] = (sort_order[i] == -1) ? min : max;
+                } else {
+                    scores[i] = default_score;
+                }
             } else if (!is_reference_sort) {
                 auto it = field_values[i]->find(seq_id);
                 scores[i] = (it == field_values[i]->end()) ? default_score : it->second;
@@ -6419,7 +7260,9 @@ Option<bool> Index::compute_facet_infos(const std::vector<facet>& facets, facet_
         bool facet_value_index_exists = facet_index_v4->has_value_index(facet_field.name);
 
         //as we use sort index for range facets with hash based index, sort index should be present
-        if(facet_index_type == exhaustive || group_limit != 0) {
+        // the tree of a hierarchical facet is built from the counts of all of its values
+        if(facet_index_type == exhaustive || facet_index_type == sketch || group_limit != 0 ||
+           facet_field.is_hierarchical()) {
             facet_infos[findex].use_value_index = false;
         }
         else if(facet_value_index_exists) {
@@ -6899,6 +7742,8 @@ Option<bool> Index::populate_sort_mapping(int* sort_order, std::vector<size_t>&
                 field_values[i] = nullptr; // GEOPOINT_ARRAY uses a multi-valued index
             } else if(search_schema.at(sort_fields_std[i].name).type == field_types::STRING) {
                 field_values[i] = &str_sentinel_value;
+            } else if(min_max_index.count(sort_fields_std[i].name) != 0) {
+                field_values[i] = &num_array_sentinel_value;
             } else {
                 field_values[i] = sort_index.at(sort_fields_std[i].name);
 
@@ -7361,6 +8206,7 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
         const std::vector<int32_t>& values = search_field.is_single_integer() ?
                                              std::vector<int32_t>{document[field_name].get<int32_t>()} :
                                              document[field_name].get<std::vector<int32_t>>();
+        auto histogram = numeric_histogram_index.at(field_name);
         for(int32_t value: values) {
             if (search_field.range_index) {
                 auto trie = range_index.at(field_name);
@@ -7370,10 +8216,17 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
                 num_tree->remove(value, seq_id);
             }
 
+            histogram->remove(value);
+
             if(search_field.facet) {
                 remove_facet_token(search_field, search_index, std::to_string(value), seq_id);
             }
         }
+
+        auto min_max_it = min_max_index.find(field_name);
+        if(min_max_it != min_max_index.end()) {
+            min_max_it->second->remove(seq_id);
+        }
     } else if(search_field.is_int64()) {
         std::vector<int64_t> values;
         std::vector<std::pair<uint32_t, uint32_t>> object_array_reference_values;
@@ -7396,6 +8249,7 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
                      document[field_name].get<std::vector<int64_t>>();
         }
 
+        auto histogram = numeric_histogram_index.at(field_name);
         for(int64_t value: values) {
             if (search_field.range_index) {
                 auto trie = range_index.at(field_name);
@@ -7405,6 +8259,8 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
                 num_tree->remove(value, seq_id);
             }
 
+            histogram->remove(value);
+
             if(search_field.facet) {
                 remove_facet_token(search_field, search_index, std::to_string(value), seq_id);
             }
@@ -7417,6 +8273,11 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
         for (auto const& pair: object_array_reference_values) {
             object_array_reference_index[field_name]->erase(pair);
         }
+
+        auto min_max_it = min_max_index.find(field_name);
+        if(min_max_it != min_max_index.end()) {
+            min_max_it->second->remove(seq_id);
+        }
     } else if(search_field.num_dim) {
         if(!is_update) {
             // since vector index supports upsert natively, we should not attempt to delete for update
@@ -7427,6 +8288,7 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
                                            std::vector<float>{document[field_name].get<float>()} :
                                            document[field_name].get<std::vector<float>>();
 
+        auto histogram = numeric_histogram_index.at(field_name);
         for(float value: values) {
             int64_t fintval = float_to_int64_t(value);
 
@@ -7438,10 +8300,22 @@ void Index::remove_field(uint32_t seq_id, nlohmann::json& document, const std::s
                 num_tree->remove(fintval, seq_id);
             }
 
+            histogram->remove(fintval);
+
             if(search_field.facet) {
                 remove_facet_token(search_field, search_index, StringUtils::float_to_str(value), seq_id);
             }
         }
+
+        auto float_column_it = float_column_index.find(field_name);
+        if(float_column_it != float_column_index.end()) {
+            float_column_it->second->remove(seq_id);
+        }
+
+        auto min_max_it = min_max_index.find(field_name);
+        if(min_max_it != min_max_index.end()) {
+            min_max_it->second->remove(seq_id);
+        }
     } else if(search_field.is_bool()) {
 
         const std::vector<bool>& values = search_field.is_single_bool() ?
@@ -7512,6 +8386,11 @@ Option<uint32_t> Index::remove(const uint32_t seq_id, nlohmann::json & document,
                                const std::vector<field>& del_fields, const bool is_update) {
     std::unique_lock lock(mutex);
 
+    if(!is_update) {
+        // updated documents are counted again once they are indexed
+        remove_from_facet_count_filters(seq_id);
+    }
+
     // The exception during removal is mostly because of an edge case with auto schema detection:
     // Value indexed as Type T but later if field is dropped and reindexed in another type X,
     // the on-disk data will differ from the newly detected type on schema. We've to log the error,
@@ -7530,6 +8409,8 @@ Option<uint32_t> Index::remove(const uint32_t seq_id, nlohmann::json & document,
                 LOG(WARNING) << "Error while removing field `" << the_field.name << "` from document, message: "
                              << e.what();
             }
+
+            filter_result_cache.bump_epoch(the_field.name);
         }
     } else {
         for(auto it = document.begin(); it != document.end(); ++it) {
@@ -7540,16 +8421,164 @@ Option<uint32_t> Index::remove(const uint32_t seq_id, nlohmann::json & document,
                 LOG(WARNING) << "Error while removing field `" << field_name << "` from document, message: "
                              << e.what();
             }
+
+            filter_result_cache.bump_epoch(field_name);
         }
     }
 
     if(!is_update) {
         seq_ids->erase(seq_id);
+        filter_result_cache.bump_epoch("id");
     }
 
     return Option<uint32_t>(seq_id);
 }
 
+void Index::count_facet_values(filtered_facet_counts_t& counts, const uint32_t seq_id, const bool is_removal) const {
+    const uint32_t* facet_codes = nullptr;
+    const uint32_t* facet_code_positions = nullptr;
+    std::vector<uint32_t> facet_ids;
+
+    for(const auto& a_field: search_schema) {
+        if(!a_field.facet) {
+            continue;
+        }
+
+        const auto forward_index = facet_index_v4->get_facet_forward_index(a_field.name);
+        if(forward_index == nullptr) {
+            continue;
+        }
+
+        const auto num_facet_codes = forward_index->get(seq_id, facet_codes, facet_code_positions);
+
+        facet_ids.clear();
+        for(size_t i = 0; i < num_facet_codes; i++) {
+            facet_ids.push_back(forward_index->get_facet_id(facet_codes[i]));
+        }
+
+        if(is_removal) {
+            counts.remove_facet_ids(a_field.name, facet_ids.data(), facet_ids.size());
+        } else {
+            counts.add_facet_ids(a_field.name, facet_ids.data(), facet_ids.size());
+        }
+    }
+}
+
+void Index::add_to_facet_count_filters(const std::vector<index_record>& iter_batch) {
+    if(facet_count_filters.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> batch_seq_ids;
+    for(const auto& index_rec: iter_batch) {
+        if(index_rec.indexed.ok()) {
+            batch_seq_ids.push_back(index_rec.seq_id);
+        }
+    }
+
+    std::sort(batch_seq_ids.begin(), batch_seq_ids.end());
+    batch_seq_ids.erase(std::unique(batch_seq_ids.begin(), batch_seq_ids.end()), batch_seq_ids.end());
+
+    for(auto& filter_counts: facet_count_filters) {
+        auto& count_filter = *filter_counts.second;
+
+        // documents are probed against the filter instead of computing all of its matches
+        auto filter_result_iterator = filter_result_iterator_t(get_collection_name(), this,
+                                                               count_filter.filter_tree_root.get(), true);
+        if(!filter_result_iterator.init_status().ok()) {
+            // could be a filter on a field that has since been dropped
+            continue;
+        }
+
+        uint32_t* match_ids = nullptr;
+        const auto num_match_ids = filter_result_iterator.and_scalar(batch_seq_ids.data(), batch_seq_ids.size(),
+                                                                     match_ids);
+        std::unique_ptr<uint32_t[]> match_ids_guard(match_ids);
+
+        for(size_t i = 0; i < num_match_ids; i++) {
+            if(count_filter.counts.add(match_ids[i])) {
+                count_facet_values(count_filter.counts, match_ids[i], false);
+            }
+        }
+    }
+}
+
+void Index::remove_from_facet_count_filters(const uint32_t seq_id) {
+    for(auto& filter_counts: facet_count_filters) {
+        auto& counts = filter_counts.second->counts;
+        if(counts.remove(seq_id)) {
+            count_facet_values(counts, seq_id, true);
+        }
+    }
+}
+
+const facet_count_filter_t* Index::get_facet_count_filter(const filter_result_iterator_t* filter_result_iterator,
+                                                          const size_t num_result_ids) const {
+    const auto filter_node = filter_result_iterator->get_filter_node();
+    if(filter_node == nullptr || facet_count_filters.empty()) {
+        return nullptr;
+    }
+
+    auto filter_query = filter_node->filter_query;
+    StringUtils::trim(filter_query);
+
+    const auto it = facet_count_filters.find(filter_query);
+
+    // the results are the documents of the filter only when none of its documents were excluded from them
+    if(it == facet_count_filters.end() || it->second->counts.size() != num_result_ids) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+Option<bool> Index::add_facet_count_filter(const std::string& filter_query, filter_node_t* filter_tree_root) {
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+    std::unique_lock lock(mutex);
+
+    if(facet_count_filters.count(filter_query) != 0) {
+        return Option<bool>(true);
+    }
+
+    auto filter_result_iterator = filter_result_iterator_t(get_collection_name(), this, filter_tree_root);
+    auto filter_init_op = filter_result_iterator.init_status();
+    if(!filter_init_op.ok()) {
+        return filter_init_op;
+    }
+
+    filter_result_iterator.compute_iterators();
+
+    uint32_t* filter_ids = nullptr;
+    uint32_t filter_ids_length = 0;
+    if(filter_result_iterator.approx_filter_ids_length != 0) {
+        filter_ids_length = filter_result_iterator.to_filter_id_array(filter_ids);
+    }
+    std::unique_ptr<uint32_t[]> filter_ids_guard(filter_ids);
+
+    auto count_filter = new facet_count_filter_t();
+    count_filter->filter_tree_root = std::move(filter_tree_root_guard);
+
+    for(size_t i = 0; i < filter_ids_length; i++) {
+        count_filter->counts.add(filter_ids[i]);
+        count_facet_values(count_filter->counts, filter_ids[i], false);
+    }
+
+    facet_count_filters.emplace(filter_query, count_filter);
+    return Option<bool>(true);
+}
+
+void Index::remove_facet_count_filter(const std::string& filter_query) {
+    std::unique_lock lock(mutex);
+
+    auto it = facet_count_filters.find(filter_query);
+    if(it == facet_count_filters.end()) {
+        return;
+    }
+
+    delete it->second;
+    facet_count_filters.erase(it);
+}
+
 void Index::tokenize_string_field(const nlohmann::json& document, const field& search_field,
                                   std::vector<std::string>& tokens, const std::string& locale,
                                   const std::vector<char>& symbols_to_index,
@@ -7590,6 +8619,10 @@ const spp::sparse_hash_map<std::string, NumericTrie*>& Index::_get_range_index()
     return range_index;
 }
 
+const spp::sparse_hash_map<std::string, numeric_histogram_t*>& Index::_get_numeric_histogram_index() const {
+    return numeric_histogram_index;
+}
+
 const spp::sparse_hash_map<std::string, array_mapped_infix_t>& Index::_get_infix_index() const {
     return infix_index;
 };
@@ -7623,7 +8656,7 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
                 auto doc_to_score = new spp::sparse_hash_map<uint32_t, int64_t, Hasher32>();
                 sort_index.emplace(new_field.name, doc_to_score);
             } else if(new_field.is_str_sortable()) {
-                str_sort_index.emplace(new_field.name, new adi_tree_t);
+                str_sort_index.emplace(new_field.name, new string_sort_column_t);
             }
         }
 
@@ -7647,6 +8680,19 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
                     num_tree_t* num_tree = new num_tree_t;
                     numerical_index.emplace(new_field.name, num_tree);
                 }
+
+                if(new_field.is_integer() || new_field.is_float()) {
+                    numeric_histogram_index.emplace(new_field.name, new numeric_histogram_t());
+                }
+
+                if(new_field.type == field_types::FLOAT) {
+                    float_column_index.emplace(new_field.name, new float_column_t());
+                }
+
+                if(new_field.is_array() && (new_field.is_integer() || new_field.is_float()) &&
+                   !new_field.is_reference_helper) {
+                    min_max_index.emplace(new_field.name, new min_max_column_t());
+                }
             }
         }
 
@@ -7708,6 +8754,21 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
                 delete numerical_index[del_field.name];
                 numerical_index.erase(del_field.name);
             }
+
+            if(numeric_histogram_index.count(del_field.name) != 0) {
+                delete numeric_histogram_index[del_field.name];
+                numeric_histogram_index.erase(del_field.name);
+            }
+
+            if(float_column_index.count(del_field.name) != 0) {
+                delete float_column_index[del_field.name];
+                float_column_index.erase(del_field.name);
+            }
+
+            if(min_max_index.count(del_field.name) != 0) {
+                delete min_max_index[del_field.name];
+                min_max_index.erase(del_field.name);
+            }
         }
 
         if(del_field.is_sortable()) {
@@ -7723,6 +8784,10 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
         if(del_field.is_facet()) {
             facet_index_v4->erase(del_field.name);
 
+            for(auto& filter_counts: facet_count_filters) {
+                filter_counts.second->counts.erase_field(del_field.name);
+            }
+
             if(!del_field.is_string()) {
                 art_tree_destroy(search_index[del_field.faceted_name()]);
                 delete search_index[del_field.faceted_name()];
@@ -7745,6 +8810,16 @@ void Index::refresh_schemas(const std::vector<field>& new_fields, const std::vec
             vector_index.erase(del_field.name);
         }
     }
+
+    for(const auto& new_field: new_fields) {
+        filter_result_cache.bump_epoch(new_field.name);
+    }
+
+    for(const auto& del_field: del_fields) {
+        filter_result_cache.bump_epoch(del_field.name);
+    }
+
+    filter_result_cache.clear();
 }
 
 void Index::handle_doc_ops(const tsl::htrie_map<char, field>& search_schema,
@@ -8134,6 +9209,38 @@ bool Index::common_results_exist(std::vector<art_leaf*>& leaves, bool must_match
 }
 
 
+void Index::compute_derived_fields(const std::vector<std::pair<std::string, sort_by>>& derived_fields,
+                                   index_record& record) {
+    for(const auto& derived_field: derived_fields) {
+        const auto& field_name = derived_field.first;
+        const auto& decay_function = derived_field.second;
+
+        // values sent by the client are never indexed: they would go stale with the source field
+        record.doc.erase(field_name);
+
+        auto source_it = record.doc.find(decay_function.name);
+        if(source_it == record.doc.end()) {
+            // on update, the derived value of the old document remains valid
+            continue;
+        }
+
+        if(source_it->is_null()) {
+            // removal of an optional source field during update
+            record.doc[field_name] = nullptr;
+            continue;
+        }
+
+        if(!source_it->is_number_integer()) {
+            continue;
+        }
+
+        const float value = decay_function_score(decay_function, source_it->get<int64_t>());
+        if(std::isfinite(value)) {
+            record.doc[field_name] = value;
+        }
+    }
+}
+
 void Index::batch_embed_fields(std::vector<index_record*>& records, 
                                const tsl::htrie_map<char, field>& embedding_fields,
                                const tsl::htrie_map<char, field> & search_schema, const size_t remote_embedding_batch_size,
@@ -8374,7 +9481,7 @@ void Index::repair_hnsw_index() {
 int64_t Index::reference_string_sort_score(const string &field_name,  const std::vector<uint32_t>& seq_ids_vec,
                                            const bool& is_asc) const {
     std::shared_lock lock(mutex);
-    size_t score = is_asc ? INT64_MAX : 0;
+    int64_t score = is_asc ? INT64_MAX : 0;
     for (const auto& seq_id: seq_ids_vec) {
         if (is_asc) {
             score = std::min(score, str_sort_index.at(field_name)->rank(seq_id));
@@ -8923,10 +10030,6 @@ void Index::compute_aux_scores(Topster<KV>* topster, const std::vector<search_fi
 }
 
 float Index::compute_decay_function_score(const sort_by& sort_field, uint32_t seq_id) const {
-    float res;
-    int64_t origin_distance_with_offset;
-    double variance;
-
     auto sort_index_it = sort_index.find(sort_field.name);
     auto val = get_doc_val_from_sort_index(sort_index_it, seq_id);
 
@@ -8934,6 +10037,14 @@ float Index::compute_decay_function_score(const sort_by& sort_field, uint32_t se
         return INT64_MAX;
     }
 
+    return decay_function_score(sort_field, val);
+}
+
+float Index::decay_function_score(const sort_by& sort_field, const int64_t val) {
+    float res;
+    int64_t origin_distance_with_offset;
+    double variance;
+
     origin_distance_with_offset = std::abs(sort_field.origin_val - val) - sort_field.offset;
 
     switch(sort_field.sort_by_param) {
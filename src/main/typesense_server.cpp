@@ -44,6 +44,7 @@ void master_server_routes() {
     server->get("/collections", get_collections);
     server->del("/collections/:collection", del_drop_collection);
     server->get("/collections/:collection", get_collection_summary);
+    server->get("/collections/:collection/filter_continuations/:id", get_filter_continuation);
 
     server->get("/aliases", get_aliases);
     server->get("/aliases/:alias", get_alias);
@@ -0,0 +1,60 @@
+#include "min_max_column.h"
+#include <algorithm>
+
+void min_max_column_t::insert(const uint32_t seq_id, const int64_t value) {
+    if (seq_id >= mins.size()) {
+        mins.resize(seq_id + 1, INT64_MAX);
+        maxs.resize(seq_id + 1, INT64_MIN);
+    }
+
+    if (mins[seq_id] > maxs[seq_id]) {
+        num_values++;
+    }
+
+    mins[seq_id] = std::min(mins[seq_id], value);
+    maxs[seq_id] = std::max(maxs[seq_id], value);
+}
+
+void min_max_column_t::remove(const uint32_t seq_id) {
+    if (!contains(seq_id)) {
+        return;
+    }
+
+    mins[seq_id] = INT64_MAX;
+    maxs[seq_id] = INT64_MIN;
+    num_values--;
+}
+
+bool min_max_column_t::contains(const uint32_t seq_id) const {
+    return seq_id < mins.size() && mins[seq_id] <= maxs[seq_id];
+}
+
+bool min_max_column_t::get(const uint32_t seq_id, int64_t& min, int64_t& max) const {
+    if (!contains(seq_id)) {
+        return false;
+    }
+
+    min = mins[seq_id];
+    max = maxs[seq_id];
+    return true;
+}
+
+min_max_column_t::range_match_t min_max_column_t::match_range(const uint32_t seq_id, const int64_t start,
+                                                              const int64_t end) const {
+    if (seq_id >= mins.size() || start > end) {
+        return no_match;
+    }
+
+    const int64_t min = mins[seq_id], max = maxs[seq_id];
+
+    // also rejects documents without a value since their min is greater than their max
+    if (max < start || min > end || min > max) {
+        return no_match;
+    }
+
+    if (min >= start || max <= end) {
+        return match;
+    }
+
+    return maybe_match;
+}
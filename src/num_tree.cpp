@@ -420,6 +420,16 @@ std::pair<int64_t, int64_t> num_tree_t::get_min_max(const uint32_t* result_ids,
     return std::make_pair(min, max);
 }
 
+void num_tree_t::get_value_counts(const uint32_t* result_ids, size_t result_ids_len,
+                                  std::vector<std::pair<int64_t, size_t>>& value_counts) {
+    for(auto& kv: int64map) {
+        const size_t count = ids_t::intersect_count(kv.second, result_ids, result_ids_len);
+        if(count != 0) {
+            value_counts.emplace_back(kv.first, count);
+        }
+    }
+}
+
 size_t num_tree_t::size() {
     return int64map.size();
 }
@@ -0,0 +1,161 @@
+#include "numeric_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+numeric_histogram_t::numeric_histogram_t(size_t max_buckets): max_buckets(std::max<size_t>(max_buckets, 2)) {
+
+}
+
+size_t numeric_histogram_t::find_bucket(const int64_t& value) const {
+    auto it = std::lower_bound(buckets.begin(), buckets.end(), value,
+                               [](const bucket_t& bucket, const int64_t& val) {
+        return bucket.upper < val;
+    });
+
+    return it - buckets.begin();
+}
+
+uint32_t numeric_histogram_t::target_depth() const {
+    return std::max<uint32_t>(MIN_BUCKET_DEPTH, total / max_buckets);
+}
+
+void numeric_histogram_t::split_bucket(const size_t& index) {
+    bucket_t& bucket = buckets[index];
+
+    // midpoint computed in unsigned space to avoid overflow at the edges of the int64 domain
+    const int64_t mid = bucket.lower + int64_t((uint64_t(bucket.upper) - uint64_t(bucket.lower)) / 2);
+
+    const long double width = (long double) bucket.upper - (long double) bucket.lower + 1;
+    const long double left_width = (long double) mid - (long double) bucket.lower + 1;
+    const auto left_count = uint32_t(std::llround(bucket.count * (left_width / width)));
+
+    bucket_t right{mid + 1, bucket.upper, bucket.count - left_count};
+    bucket.upper = mid;
+    bucket.count = left_count;
+
+    buckets.insert(buckets.begin() + index + 1, right);
+}
+
+void numeric_histogram_t::merge_smallest_pair() {
+    size_t merge_index = 0;
+    uint64_t min_count = UINT64_MAX;
+
+    for (size_t i = 0; i + 1 < buckets.size(); i++) {
+        uint64_t pair_count = uint64_t(buckets[i].count) + buckets[i + 1].count;
+        if (pair_count < min_count) {
+            min_count = pair_count;
+            merge_index = i;
+        }
+    }
+
+    buckets[merge_index].upper = buckets[merge_index + 1].upper;
+    buckets[merge_index].count += buckets[merge_index + 1].count;
+    buckets.erase(buckets.begin() + merge_index + 1);
+}
+
+void numeric_histogram_t::insert(const int64_t& value) {
+    total++;
+
+    if (buckets.empty()) {
+        buckets.push_back(bucket_t{value, value, 1});
+        return;
+    }
+
+    size_t index = find_bucket(value);
+
+    if (index == buckets.size() || value < buckets[index].lower) {
+        // Value lies outside of every bucket: either widen a neighbour or, when the neighbours are already full, open a
+        // new bucket so that a dense neighbour (e.g. a single hot value) is not smeared over the widened range.
+        const bool has_left = index != 0;
+        const bool has_right = index != buckets.size();
+
+        const bool widen_left = has_left && (!has_right || buckets[index - 1].count < buckets[index].count);
+        const size_t neighbour = widen_left ? index - 1 : index;
+
+        if (buckets[neighbour].count >= target_depth()) {
+            buckets.insert(buckets.begin() + index, bucket_t{value, value, 1});
+            if (buckets.size() > max_buckets) {
+                merge_smallest_pair();
+            }
+            return;
+        }
+
+        index = neighbour;
+        if (widen_left) {
+            buckets[index].upper = value;
+        } else {
+            buckets[index].lower = value;
+        }
+    }
+
+    buckets[index].count++;
+
+    if (buckets[index].count > 2 * target_depth() && buckets[index].lower < buckets[index].upper) {
+        split_bucket(index);
+        if (buckets.size() > max_buckets) {
+            merge_smallest_pair();
+        }
+    }
+}
+
+void numeric_histogram_t::remove(const int64_t& value) {
+    if (total == 0) {
+        return;
+    }
+
+    size_t index = std::min(find_bucket(value), buckets.size() - 1);
+
+    // Counts of split buckets are only estimates, so the bucket covering the value could already be empty. In that
+    // case, the count is taken from the closest non-empty bucket to keep the total consistent.
+    if (buckets[index].count == 0) {
+        size_t distance = 1;
+        while (true) {
+            if (index + distance < buckets.size() && buckets[index + distance].count != 0) {
+                index += distance;
+                break;
+            }
+
+            if (distance <= index && buckets[index - distance].count != 0) {
+                index -= distance;
+                break;
+            }
+
+            distance++;
+        }
+    }
+
+    buckets[index].count--;
+    total--;
+
+    if (buckets[index].count == 0) {
+        buckets.erase(buckets.begin() + index);
+    }
+}
+
+uint32_t numeric_histogram_t::approx_range_count(const int64_t& start, const int64_t& end) const {
+    if (start > end || buckets.empty() || end < buckets.front().lower || start > buckets.back().upper) {
+        return 0;
+    }
+
+    long double count = 0;
+
+    for (size_t i = find_bucket(start); i < buckets.size() && buckets[i].lower <= end; i++) {
+        const bucket_t& bucket = buckets[i];
+
+        if (start <= bucket.lower && bucket.upper <= end) {
+            count += bucket.count;
+            continue;
+        }
+
+        const int64_t overlap_start = std::max(start, bucket.lower);
+        const int64_t overlap_end = std::min(end, bucket.upper);
+
+        const long double width = (long double) bucket.upper - (long double) bucket.lower + 1;
+        const long double overlap_width = (long double) overlap_end - (long double) overlap_start + 1;
+
+        count += bucket.count * (overlap_width / width);
+    }
+
+    // Any overlap with a populated bucket could match, so we round up.
+    return uint32_t(std::min<long double>(std::ceil(count), total));
+}
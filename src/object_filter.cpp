@@ -0,0 +1,268 @@
+#include "object_filter.h"
+#include <type_traits>
+#include "field.h"
+#include "filter.h"
+#include "string_utils.h"
+
+namespace {
+    template <typename T>
+    struct condition_t {
+        NUM_COMPARATOR comparator;
+        T value;
+        T range_end;
+    };
+
+    template <typename T>
+    bool compare(const T& doc_value, const condition_t<T>& condition) {
+        switch (condition.comparator) {
+            case EQUALS:
+                return doc_value == condition.value;
+            case NOT_EQUALS:
+                return doc_value != condition.value;
+            default:
+                break;
+        }
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            switch (condition.comparator) {
+                case CONTAINS:
+                    return doc_value.find(condition.value) != std::string::npos;
+                default:
+                    return false;
+            }
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return false;
+        } else {
+            switch (condition.comparator) {
+                case LESS_THAN:
+                    return doc_value < condition.value;
+                case LESS_THAN_EQUALS:
+                    return doc_value <= condition.value;
+                case GREATER_THAN:
+                    return doc_value > condition.value;
+                case GREATER_THAN_EQUALS:
+                    return doc_value >= condition.value;
+                case RANGE_INCLUSIVE:
+                    return doc_value >= condition.value && doc_value <= condition.range_end;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    /// Returns false when the JSON value is not of the type of the field.
+    template <typename T>
+    bool compare_json(const nlohmann::json& json_value, const condition_t<T>& condition, bool& result) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (!json_value.is_string()) {
+                return false;
+            }
+            result = compare(json_value.get_ref<const std::string&>(), condition);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (!json_value.is_boolean()) {
+                return false;
+            }
+            result = compare(json_value.get<bool>(), condition);
+        } else {
+            if (!json_value.is_number()) {
+                return false;
+            }
+            result = compare(json_value.get<T>(), condition);
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    bool matches_condition(const nlohmann::json& json_value, const condition_t<T>& condition) {
+        bool result = false;
+
+        if (!json_value.is_array()) {
+            return compare_json(json_value, condition, result) && result;
+        }
+
+        // An array holds the value unless the comparator is `!=`, in which case none of its elements may be equal.
+        const bool is_not_equals = condition.comparator == NOT_EQUALS;
+        for (const auto& element: json_value) {
+            if (compare_json(element, condition, result) && result != is_not_equals) {
+                return !is_not_equals;
+            }
+        }
+
+        return is_not_equals;
+    }
+
+    template <typename T>
+    object_filter_t::predicate_t make_leaf(const std::string& key, std::vector<condition_t<T>>&& conditions) {
+        return [key, conditions = std::move(conditions)] (const nlohmann::json& object) {
+            const auto it = object.find(key);
+            if (it == object.end()) {
+                return false;
+            }
+
+            for (const auto& condition: conditions) {
+                if (matches_condition(*it, condition)) {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+    }
+
+    template <typename T>
+    Option<bool> parse_value(const field& f, const std::string& raw_value, T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            value = raw_value == "1";
+        } else if constexpr (std::is_same_v<T, float>) {
+            if (!StringUtils::is_float(raw_value)) {
+                return Option<bool>(400, "Error with filter field `" + f.name + "`: Not a float.");
+            }
+            value = std::stof(raw_value);
+        } else {
+            if (!StringUtils::is_int64_t(raw_value)) {
+                return Option<bool>(400, "Error with filter field `" + f.name + "`: Not an int64.");
+            }
+            value = std::stoll(raw_value);
+        }
+
+        return Option<bool>(true);
+    }
+
+    template <typename T>
+    Option<object_filter_t::predicate_t> compile_conditions(const field& f, const std::string& key,
+                                                            const filter& filter_exp) {
+        std::vector<condition_t<T>> conditions;
+
+        for (size_t i = 0; i < filter_exp.values.size(); i++) {
+            const auto& comparator = filter_exp.comparators.size() < filter_exp.values.size() && f.is_string() ?
+                                     filter_exp.comparators[0] : filter_exp.comparators[i];
+            condition_t<T> condition{comparator, T(), T()};
+
+            if constexpr (std::is_same_v<T, std::string>) {
+                // Prefixes and suffixes match the normalized tokens of the index, not the raw values of the objects.
+                if (comparator == STARTS_WITH || comparator == ENDS_WITH) {
+                    return Option<object_filter_t::predicate_t>(400, "Error with filter field `" + f.name +
+                                                                     "`: Prefix and suffix filters are not supported "
+                                                                     "within object filters.");
+                }
+
+                condition.value = filter_exp.values[i];
+                if (comparator == CONTAINS && !condition.value.empty() && condition.value.back() == '*') {
+                    condition.value.pop_back();
+                }
+            } else {
+                auto parse_op = parse_value(f, filter_exp.values[i], condition.value);
+                if (!parse_op.ok()) {
+                    return Option<object_filter_t::predicate_t>(parse_op.code(), parse_op.error());
+                }
+
+                if (comparator == RANGE_INCLUSIVE && i + 1 < filter_exp.values.size()) {
+                    parse_op = parse_value(f, filter_exp.values[++i], condition.range_end);
+                    if (!parse_op.ok()) {
+                        return Option<object_filter_t::predicate_t>(parse_op.code(), parse_op.error());
+                    }
+                }
+            }
+
+            conditions.push_back(std::move(condition));
+        }
+
+        return Option<object_filter_t::predicate_t>(make_leaf<T>(key, std::move(conditions)));
+    }
+}
+
+Option<object_filter_t::predicate_t> object_filter_t::compile_leaf(const tsl::htrie_map<char, field>& search_schema,
+                                                                   const filter_node_t* filter_node) {
+    const auto& filter_exp = filter_node->filter_exp;
+    const auto field_it = search_schema.find(filter_exp.field_name);
+    if (field_it == search_schema.end()) {
+        return Option<predicate_t>(400, "Could not find a filter field named `" + filter_exp.field_name +
+                                        "` in the schema.");
+    }
+
+    const auto& f = field_it.value();
+    const auto pos = filter_exp.field_name.rfind('.');
+    const auto key = filter_exp.field_name.substr(pos + 1);
+
+    if (f.is_string()) {
+        return compile_conditions<std::string>(f, key, filter_exp);
+    } else if (f.is_float()) {
+        return compile_conditions<float>(f, key, filter_exp);
+    } else if (f.is_bool()) {
+        return compile_conditions<bool>(f, key, filter_exp);
+    } else if (f.is_integer()) {
+        return compile_conditions<int64_t>(f, key, filter_exp);
+    }
+
+    return Option<predicate_t>(predicate_t([] (const nlohmann::json& object) { return false; }));
+}
+
+Option<object_filter_t::predicate_t> object_filter_t::compile_node(const tsl::htrie_map<char, field>& search_schema,
+                                                                   const filter_node_t* filter_node) {
+    if (!filter_node->isOperator) {
+        return compile_leaf(search_schema, filter_node);
+    }
+
+    auto left_op = compile_node(search_schema, filter_node->left);
+    if (!left_op.ok()) {
+        return left_op;
+    }
+
+    auto right_op = compile_node(search_schema, filter_node->right);
+    if (!right_op.ok()) {
+        return right_op;
+    }
+
+    auto left = left_op.get();
+    auto right = right_op.get();
+
+    if (filter_node->filter_operator == AND) {
+        return Option<predicate_t>(predicate_t([left = std::move(left), right = std::move(right)]
+                                                       (const nlohmann::json& object) {
+            return left(object) && right(object);
+        }));
+    }
+
+    return Option<predicate_t>(predicate_t([left = std::move(left), right = std::move(right)]
+                                                   (const nlohmann::json& object) {
+        return left(object) || right(object);
+    }));
+}
+
+Option<bool> object_filter_t::compile(const tsl::htrie_map<char, field>& search_schema,
+                                      const filter_node_t* filter_node, object_filter_t& object_filter) {
+    auto compile_op = compile_node(search_schema, filter_node);
+    if (!compile_op.ok()) {
+        return Option<bool>(compile_op.code(), compile_op.error());
+    }
+
+    object_filter.predicate = compile_op.get();
+    return Option<bool>(true);
+}
+
+const nlohmann::json* object_filter_t::get_path(const nlohmann::json& document, const std::string& path) {
+    const nlohmann::json* value = &document;
+    size_t begin = 0;
+
+    while (begin <= path.size()) {
+        auto end = path.find('.', begin);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+
+        if (!value->is_object()) {
+            return nullptr;
+        }
+
+        const auto it = value->find(path.substr(begin, end - begin));
+        if (it == value->end()) {
+            return nullptr;
+        }
+
+        value = &(*it);
+        begin = end + 1;
+    }
+
+    return value;
+}
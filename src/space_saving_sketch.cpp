@@ -0,0 +1,146 @@
+#include "space_saving_sketch.h"
+#include <algorithm>
+
+void space_saving_sketch_t::swap_counters(const size_t a, const size_t b) {
+    std::swap(counters[a], counters[b]);
+    item_heap_positions[counters[a].item] = a;
+    item_heap_positions[counters[b].item] = b;
+}
+
+void space_saving_sketch_t::sift_down(size_t pos) {
+    while(true) {
+        const size_t left = 2 * pos + 1, right = left + 1;
+        size_t smallest = pos;
+
+        if(left < counters.size() && counters[left].count < counters[smallest].count) {
+            smallest = left;
+        }
+
+        if(right < counters.size() && counters[right].count < counters[smallest].count) {
+            smallest = right;
+        }
+
+        if(smallest == pos) {
+            return;
+        }
+
+        swap_counters(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void space_saving_sketch_t::build_heap() {
+    item_heap_positions.clear();
+    for(size_t i = 0; i < counters.size(); i++) {
+        item_heap_positions[counters[i].item] = i;
+    }
+
+    for(size_t i = counters.size() / 2; i-- > 0;) {
+        sift_down(i);
+    }
+}
+
+void space_saving_sketch_t::update(const uint32_t item, const uint32_t doc_id, const uint32_t array_pos) {
+    if(max_counters == 0) {
+        return;
+    }
+
+    const auto it = item_heap_positions.find(item);
+    if(it != item_heap_positions.end()) {
+        auto& counter = counters[it->second];
+        counter.count++;
+        counter.doc_id = doc_id;
+        counter.array_pos = array_pos;
+        sift_down(it->second);
+        return;
+    }
+
+    if(counters.size() < max_counters) {
+        // a new item has the smallest possible count, so it moves up past every larger parent
+        counters.push_back({item, 1, 0, doc_id, array_pos});
+        size_t pos = counters.size() - 1;
+        item_heap_positions[item] = pos;
+
+        while(pos != 0 && counters[(pos - 1) / 2].count > counters[pos].count) {
+            swap_counters(pos, (pos - 1) / 2);
+            pos = (pos - 1) / 2;
+        }
+
+        return;
+    }
+
+    // the item takes over the counter with the smallest count
+    auto& min_counter = counters[0];
+    item_heap_positions.erase(min_counter.item);
+    min_counter = {item, min_counter.count + 1, min_counter.count, doc_id, array_pos};
+    item_heap_positions[item] = 0;
+    sift_down(0);
+}
+
+uint32_t space_saving_sketch_t::max_unmonitored_count() const {
+    if(!counters.empty() && counters.size() == max_counters) {
+        return std::max(dropped_count_bound, counters[0].count);
+    }
+
+    return dropped_count_bound;
+}
+
+void space_saving_sketch_t::merge(const space_saving_sketch_t& other) {
+    if(other.max_counters == 0) {
+        return;
+    }
+
+    if(max_counters == 0) {
+        max_counters = other.max_counters;
+    }
+
+    // an item missing from a summary occurs in its stream at most as often as that summary's unmonitored bound
+    const uint32_t bound = max_unmonitored_count();
+    const uint32_t other_bound = other.max_unmonitored_count();
+
+    std::vector<counter_t> merged;
+    merged.reserve(counters.size() + other.counters.size());
+
+    for(const auto& counter: counters) {
+        counter_t merged_counter = counter;
+        const auto other_it = other.item_heap_positions.find(counter.item);
+
+        if(other_it != other.item_heap_positions.end()) {
+            merged_counter.count += other.counters[other_it->second].count;
+            merged_counter.error += other.counters[other_it->second].error;
+        } else {
+            merged_counter.count += other_bound;
+            merged_counter.error += other_bound;
+        }
+
+        merged.push_back(merged_counter);
+    }
+
+    for(const auto& counter: other.counters) {
+        if(item_heap_positions.count(counter.item) != 0) {
+            continue;
+        }
+
+        counter_t merged_counter = counter;
+        merged_counter.count += bound;
+        merged_counter.error += bound;
+        merged.push_back(merged_counter);
+    }
+
+    uint32_t merged_dropped_count_bound = bound + other_bound;
+
+    if(merged.size() > max_counters) {
+        std::nth_element(merged.begin(), merged.begin() + max_counters, merged.end(),
+                         [](const counter_t& a, const counter_t& b) { return a.count > b.count; });
+
+        for(size_t i = max_counters; i < merged.size(); i++) {
+            merged_dropped_count_bound = std::max(merged_dropped_count_bound, merged[i].count);
+        }
+
+        merged.resize(max_counters);
+    }
+
+    counters = std::move(merged);
+    dropped_count_bound = merged_dropped_count_bound;
+    build_heap();
+}
@@ -112,6 +112,29 @@ StoreStatus Store::get(const std::string& key, std::string& value) const {
     return StoreStatus::ERROR;
 }
 
+std::vector<StoreStatus> Store::multi_get(const std::vector<std::string>& keys,
+                                          std::vector<std::string>& values) const {
+    std::shared_lock lock(mutex);
+    const std::vector<rocksdb::Slice> key_slices(keys.begin(), keys.end());
+    const std::vector<rocksdb::Status> statuses = db->MultiGet(rocksdb::ReadOptions(), key_slices, &values);
+
+    std::vector<StoreStatus> store_statuses;
+    store_statuses.reserve(statuses.size());
+
+    for(size_t i = 0; i < statuses.size(); i++) {
+        if(statuses[i].ok()) {
+            store_statuses.push_back(StoreStatus::FOUND);
+        } else if(statuses[i].IsNotFound()) {
+            store_statuses.push_back(StoreStatus::NOT_FOUND);
+        } else {
+            LOG(ERROR) << "Error while fetching the key: " << keys[i] << " - status is: " << statuses[i].ToString();
+            store_statuses.push_back(StoreStatus::ERROR);
+        }
+    }
+
+    return store_statuses;
+}
+
 bool Store::remove(const std::string& key) {
     std::shared_lock lock(mutex);
     rocksdb::Status status = db->Delete(write_options, key);
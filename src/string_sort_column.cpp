@@ -0,0 +1,225 @@
+#include "string_sort_column.h"
+#include <algorithm>
+
+bool string_sort_column_t::value_comparator_t::operator()(const std::string& a, const std::string& b) const {
+    const size_t len = std::min(a.size(), b.size());
+
+    for (size_t i = 0; i < len; i++) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i];
+        }
+    }
+
+    if (a.size() == b.size()) {
+        return false;
+    }
+
+    // end of the shorter value is compared as '\0'
+    return a.size() < b.size() ? ('\0' < b[len]) : (a[len] < '\0');
+}
+
+string_sort_column_t::string_sort_column_t() {
+    reset_limits();
+}
+
+void string_sort_column_t::reset_limits() {
+    delta_limit = std::max(MIN_DELTA_LIMIT, dictionary.size() / 16);
+
+    // values appended to either end of a gap are spaced so that a full delta fits without relabelling
+    label_stride = std::max<uint64_t>(1, (LABEL_SPACE / 2) / (delta_limit + 1));
+}
+
+void string_sort_column_t::index(const uint32_t id, const std::string& value) {
+    if (value.empty()) {
+        return;
+    }
+
+    if (id < codes.size() && codes[id] != EMPTY_CODE) {
+        return;
+    }
+
+    if (id >= codes.size()) {
+        codes.resize(id + 1, EMPTY_CODE);
+    }
+
+    const value_comparator_t comparator;
+    auto dictionary_it = std::lower_bound(dictionary.begin(), dictionary.end(), value, comparator);
+    const uint32_t gap = dictionary_it - dictionary.begin();
+
+    if (dictionary_it != dictionary.end() && !comparator(value, *dictionary_it)) {
+        if (dictionary_counts[gap]++ == 0) {
+            num_unused_values--;
+        }
+
+        codes[id] = gap;
+        return;
+    }
+
+    auto delta_it = delta_values.find(value);
+    if (delta_it == delta_values.end()) {
+        delta_it = delta_values.emplace(value, delta_value_t{gap, 0, 0}).first;
+        assign_label(delta_it);
+    }
+
+    delta_it->second.count++;
+    delta_ids.emplace(id, delta_it);
+    codes[id] = DELTA_CODE;
+
+    if (delta_values.size() > delta_limit) {
+        compact();
+    }
+}
+
+void string_sort_column_t::assign_label(const delta_map_t::iterator& it) {
+    const auto gap = it->second.gap;
+
+    const bool has_prev = it != delta_values.begin() && std::prev(it)->second.gap == gap;
+    const bool has_next = std::next(it) != delta_values.end() && std::next(it)->second.gap == gap;
+
+    // labels 0 and LABEL_SPACE belong to the dictionary neighbours of the gap
+    const uint64_t lower = has_prev ? std::prev(it)->second.label : 0;
+    const uint64_t upper = has_next ? std::next(it)->second.label : LABEL_SPACE;
+
+    if (upper - lower < 2) {
+        relabel_gap(it);
+        return;
+    }
+
+    uint64_t label = lower + (upper - lower) / 2;
+
+    if (has_prev && !has_next && lower + label_stride < upper) {
+        label = lower + label_stride;
+    } else if (!has_prev && has_next && upper > label_stride) {
+        label = upper - label_stride;
+    }
+
+    it->second.label = label;
+}
+
+void string_sort_column_t::relabel_gap(const delta_map_t::iterator& it) {
+    const auto gap = it->second.gap;
+
+    auto first = it;
+    while (first != delta_values.begin() && std::prev(first)->second.gap == gap) {
+        first--;
+    }
+
+    size_t num_values = 0;
+    for (auto gap_it = first; gap_it != delta_values.end() && gap_it->second.gap == gap; gap_it++) {
+        num_values++;
+    }
+
+    const uint64_t spacing = LABEL_SPACE / (num_values + 1);
+    uint64_t label = spacing;
+
+    for (auto gap_it = first; gap_it != delta_values.end() && gap_it->second.gap == gap; gap_it++) {
+        gap_it->second.label = label;
+        label += spacing;
+    }
+}
+
+int64_t string_sort_column_t::rank(const uint32_t id) const {
+    if (id >= codes.size()) {
+        return NOT_FOUND;
+    }
+
+    const auto code = codes[id];
+
+    if (code < DELTA_CODE) {
+        return int64_t(code + 1) << LABEL_BITS;
+    }
+
+    if (code == EMPTY_CODE) {
+        return NOT_FOUND;
+    }
+
+    const auto& delta_value = delta_ids.at(id)->second;
+    return (int64_t(delta_value.gap) << LABEL_BITS) + delta_value.label;
+}
+
+void string_sort_column_t::remove(const uint32_t id) {
+    if (id >= codes.size()) {
+        return;
+    }
+
+    const auto code = codes[id];
+
+    if (code == EMPTY_CODE) {
+        return;
+    }
+
+    codes[id] = EMPTY_CODE;
+
+    if (code == DELTA_CODE) {
+        auto delta_ids_it = delta_ids.find(id);
+        auto delta_it = delta_ids_it->second;
+        delta_ids.erase(delta_ids_it);
+
+        if (--delta_it->second.count == 0) {
+            delta_values.erase(delta_it);
+        }
+
+        return;
+    }
+
+    if (--dictionary_counts[code] == 0) {
+        num_unused_values++;
+
+        if (num_unused_values > std::max(MIN_DELTA_LIMIT, dictionary.size() / 4)) {
+            compact();
+        }
+    }
+}
+
+void string_sort_column_t::compact() {
+    const value_comparator_t comparator;
+
+    std::vector<std::string> new_dictionary;
+    std::vector<uint32_t> new_dictionary_counts;
+    new_dictionary.reserve(dictionary.size() - num_unused_values + delta_values.size());
+    new_dictionary_counts.reserve(new_dictionary.capacity());
+
+    std::vector<uint32_t> new_codes(dictionary.size(), EMPTY_CODE);
+
+    size_t i = 0;
+    auto delta_it = delta_values.begin();
+
+    while (i < dictionary.size() || delta_it != delta_values.end()) {
+        if (i < dictionary.size() && dictionary_counts[i] == 0) {
+            i++;
+            continue;
+        }
+
+        if (delta_it == delta_values.end() || (i < dictionary.size() && comparator(dictionary[i], delta_it->first))) {
+            new_codes[i] = new_dictionary.size();
+            new_dictionary.push_back(std::move(dictionary[i]));
+            new_dictionary_counts.push_back(dictionary_counts[i]);
+            i++;
+        } else {
+            // the value's code is stashed in `gap` until the codes of the delta ids are updated below
+            delta_it->second.gap = new_dictionary.size();
+            new_dictionary.push_back(delta_it->first);
+            new_dictionary_counts.push_back(delta_it->second.count);
+            delta_it++;
+        }
+    }
+
+    for (auto& code: codes) {
+        if (code < DELTA_CODE) {
+            code = new_codes[code];
+        }
+    }
+
+    for (const auto& delta_id: delta_ids) {
+        codes[delta_id.first] = delta_id.second->second.gap;
+    }
+
+    dictionary = std::move(new_dictionary);
+    dictionary_counts = std::move(new_dictionary_counts);
+    num_unused_values = 0;
+
+    delta_ids.clear();
+    delta_values.clear();
+
+    reset_limits();
+}
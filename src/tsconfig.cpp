@@ -282,6 +282,22 @@ void Config::load_config_env() {
         this->max_group_limit = std::stoi(get_env("TYPESENSE_MAX_GROUP_LIMIT"));
     }
 
+    if(!get_env("TYPESENSE_FACET_MIN_PARTITION_SIZE").empty()) {
+        this->facet_min_partition_size = std::stoul(get_env("TYPESENSE_FACET_MIN_PARTITION_SIZE"));
+    }
+
+    if(!get_env("TYPESENSE_FILTER_CONTINUATION_TIMEOUT_MS").empty()) {
+        this->filter_continuation_timeout_ms = std::stoul(get_env("TYPESENSE_FILTER_CONTINUATION_TIMEOUT_MS"));
+    }
+
+    if(!get_env("TYPESENSE_FILTER_CACHE_SIZE_MB").empty()) {
+        this->filter_cache_size_mb = std::stoul(get_env("TYPESENSE_FILTER_CACHE_SIZE_MB"));
+    }
+
+    if(!get_env("TYPESENSE_FILTER_TREE_CACHE_NUM_ENTRIES").empty()) {
+        this->filter_tree_cache_num_entries = std::stoul(get_env("TYPESENSE_FILTER_TREE_CACHE_NUM_ENTRIES"));
+    }
+
     if(!get_env("TYPESENSE_ANALYTICS_DIR").empty()) {
         this->analytics_dir = get_env("TYPESENSE_ANALYTICS_DIR");
     }
@@ -533,6 +549,22 @@ void Config::load_config_file(cmdline::parser& options) {
         this->max_group_limit = reader.GetInteger("server", "max-group-limit", 99);
     }
 
+    if(reader.Exists("server", "facet-min-partition-size")) {
+        this->facet_min_partition_size = reader.GetInteger("server", "facet-min-partition-size", 4096);
+    }
+
+    if(reader.Exists("server", "filter-continuation-timeout-ms")) {
+        this->filter_continuation_timeout_ms = reader.GetInteger("server", "filter-continuation-timeout-ms", 0);
+    }
+
+    if(reader.Exists("server", "filter-cache-size-mb")) {
+        this->filter_cache_size_mb = reader.GetInteger("server", "filter-cache-size-mb", 16);
+    }
+
+    if(reader.Exists("server", "filter-tree-cache-num-entries")) {
+        this->filter_tree_cache_num_entries = reader.GetInteger("server", "filter-tree-cache-num-entries", 100);
+    }
+
     if(reader.Exists("server", "filter-by-max-ops")) {
         this->filter_by_max_ops = (uint16_t) reader.GetInteger("server", "filter-by-max-ops", FILTER_BY_DEFAULT_OPERATIONS);
     }
@@ -749,6 +781,22 @@ void Config::load_config_cmd_args(cmdline::parser& options)  {
         this->max_group_limit = options.get<uint32_t>("max-group-limit");
     }
 
+    if(options.exist("facet-min-partition-size")) {
+        this->facet_min_partition_size = options.get<uint32_t>("facet-min-partition-size");
+    }
+
+    if(options.exist("filter-continuation-timeout-ms")) {
+        this->filter_continuation_timeout_ms = options.get<uint32_t>("filter-continuation-timeout-ms");
+    }
+
+    if(options.exist("filter-cache-size-mb")) {
+        this->filter_cache_size_mb = options.get<uint32_t>("filter-cache-size-mb");
+    }
+
+    if(options.exist("filter-tree-cache-num-entries")) {
+        this->filter_tree_cache_num_entries = options.get<uint32_t>("filter-tree-cache-num-entries");
+    }
+
     if(options.exist("filter-by-max-ops")) {
         this->filter_by_max_ops = options.get<uint16_t>("filter-by-max-ops");
     }
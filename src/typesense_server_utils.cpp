@@ -127,6 +127,10 @@ void init_cmdline_options(cmdline::parser & options, int argc, char **argv) {
 
     options.add<int>("max-per-page", '\0', "Max number of hits per page", false, 250);
     options.add<uint32_t>("max-group-limit", '\0', "Max number of results to be returned per group", false, 99);
+    options.add<uint32_t>("facet-min-partition-size", '\0', "Minimum number of results counted by a single thread when faceting.", false, 4096);
+    options.add<uint32_t>("filter-continuation-timeout-ms", '\0', "Budget of evaluating again in the background a filter that was cut off by search_cutoff_ms, during which writes to the collection wait. Continuations are kept in memory on the node that served the search. A value of 0 disables them.", false, 0);
+    options.add<uint32_t>("filter-cache-size-mb", '\0', "Memory in MB for the cached filter results of each collection. A value of 0 disables the cache.", false, 16);
+    options.add<uint32_t>("filter-tree-cache-num-entries", '\0', "Number of parsed filter_by expressions cached by each collection. A value of 0 disables the cache.", false, 100);
 
     //rocksdb options
     options.add<uint32_t>("db-write-buffer-size", '\0', "rocksdb write buffer size.", false);
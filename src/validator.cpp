@@ -652,6 +652,11 @@ Option<uint32_t> validator_t::validate_index_in_memory(nlohmann::json& document,
             continue;
         }
 
+        // derived fields are computed from their source fields once the document is validated
+        if(a_field.is_derived()) {
+            continue;
+        }
+
         if(field_name == "id" || a_field.is_object()) {
             continue;
         }
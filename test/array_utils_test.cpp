@@ -117,6 +117,33 @@ TEST(SortedArrayTest, OrScalarWithEitherArrayAsNull) {
     delete[] arr1;
 }
 
+TEST(SortedArrayTest, OrSortedRunsMergeShouldRemoveDuplicates) {
+    std::vector<std::vector<uint32_t>> runs = {
+        {3, 7, 7, 20},
+        {},
+        {1, 3, 5},
+        {20, 100},
+        {2}
+    };
+
+    uint32_t *results = nullptr;
+    size_t results_size = ArrayUtils::or_sorted_runs(runs, &results);
+
+    std::vector<uint32_t> expected = {1, 2, 3, 5, 7, 20, 100};
+    ASSERT_EQ(expected.size(), results_size);
+    for(size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i], results[i]);
+    }
+
+    delete[] results;
+    results = nullptr;
+
+    runs = {{}, {}};
+    results_size = ArrayUtils::or_sorted_runs(runs, &results);
+    ASSERT_EQ(0, results_size);
+    ASSERT_EQ(nullptr, results);
+}
+
 TEST(SortedArrayTest, FilterArray) {
     const size_t size1 = 9;
     uint32_t *arr1 = new uint32_t[size1];
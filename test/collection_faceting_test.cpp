@@ -3928,6 +3928,570 @@ TEST_F(CollectionFacetingTest, FacetingWithNegativeInt) {
 }
 
 
+TEST_F(CollectionFacetingTest, PartitionedFacetCounts) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "brand", "type": "string", "facet": true},
+                    {"name": "tags", "type": "string[]", "facet": true},
+                    {"name": "points", "type": "int32", "facet": true}
+                ]
+                })"_json;
+
+    auto coll = collectionManager.create_collection(schema).get();
+
+    for(size_t i = 0; i < 100; i++) {
+        nlohmann::json doc;
+        doc["brand"] = "brand" + std::to_string(i % 7);
+        doc["tags"] = {"tag" + std::to_string(i % 3), "tag" + std::to_string(i % 5)};
+        doc["points"] = int32_t(i % 4);
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    auto search = [&]() {
+        return coll->search("*", {}, "points:>0", {"brand", "tags", "points"}, {}, {0}, 10, 1,
+                            FREQUENCY, {false}, 10, spp::sparse_hash_set<std::string>(),
+                            spp::sparse_hash_set<std::string>(), 10).get();
+    };
+
+    // a single partition
+    Config::get_instance().set_facet_min_partition_size(1000);
+    auto results = search();
+
+    // counts of the partitions are summed into the same results
+    Config::get_instance().set_facet_min_partition_size(1);
+    auto partitioned_results = search();
+    Config::get_instance().set_facet_min_partition_size(4096);
+
+    auto get_counts = [](const nlohmann::json& facet_count) {
+        std::map<std::string, size_t> counts;
+        for(const auto& count: facet_count["counts"]) {
+            counts[count["value"].get<std::string>()] = count["count"].get<size_t>();
+        }
+        return counts;
+    };
+
+    ASSERT_EQ(75, results["found"].get<size_t>());
+    ASSERT_EQ(3, partitioned_results["facet_counts"].size());
+
+    for(size_t i = 0; i < 3; i++) {
+        ASSERT_EQ(get_counts(results["facet_counts"][i]), get_counts(partitioned_results["facet_counts"][i]));
+    }
+
+    auto tag_counts = get_counts(partitioned_results["facet_counts"][1]);
+    ASSERT_EQ(5, tag_counts.size());
+    ASSERT_EQ(35, tag_counts["tag0"]);
+    ASSERT_EQ(15, tag_counts["tag3"]);
+}
+
+TEST_F(CollectionFacetingTest, SketchFacetStrategy) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "brand", "type": "string", "facet": true},
+                    {"name": "points", "type": "int32"}
+                ]
+                })"_json;
+
+    auto coll = collectionManager.create_collection(schema).get();
+
+    // 3 popular brands among a long tail of unique brands, so that the results have more values than counters
+    for(size_t i = 0; i < 6000; i++) {
+        nlohmann::json doc;
+        doc["brand"] = (i < 600 && i % 2 == 0) ? "popular" + std::to_string((i / 2) % 3) : "rare" + std::to_string(i);
+        doc["points"] = int32_t(i);
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    auto search = [&](const std::string& facet_strategy) {
+        return coll->search("*", {}, "points:<600", {"brand"}, {}, {0}, 10, 1, FREQUENCY, {false}, 1,
+                            spp::sparse_hash_set<std::string>(), spp::sparse_hash_set<std::string>(), 3, "", 30, 4,
+                            "", 20, {}, {}, {}, 0, "<mark>", "</mark>", {}, 1000, true, false, true, "", false,
+                            6000 * 1000, 4, 7, fallback, 4, {off}, 3, 3, 2, 2, false, "", true, 0, max_score, 100, 0,
+                            0, 4294967295UL, facet_strategy).get();
+    };
+
+    auto results = search("sketch");
+    auto exhaustive_results = search("exhaustive");
+
+    ASSERT_EQ(600, results["found"].get<size_t>());
+    ASSERT_TRUE(results["facet_counts"][0]["sketched"].get<bool>());
+    ASSERT_FALSE(results["facet_counts"][0]["sampled"].get<bool>());
+    ASSERT_EQ(1, results["facet_counts"][0]["count_error_bound"].get<size_t>());
+    ASSERT_EQ(0, exhaustive_results["facet_counts"][0].count("sketched"));
+
+    ASSERT_EQ(3, results["facet_counts"][0]["counts"].size());
+    for(size_t i = 0; i < 3; i++) {
+        const auto& count = results["facet_counts"][0]["counts"][i];
+        ASSERT_EQ(exhaustive_results["facet_counts"][0]["counts"][i]["value"], count["value"]);
+        ASSERT_EQ(100, count["count"].get<size_t>());
+        ASSERT_EQ(0, count["count_error"].get<size_t>());
+        ASSERT_TRUE(count["guaranteed"].get<bool>());
+    }
+
+    // sketches of the partitions are merged within the same bounds
+    Config::get_instance().set_facet_min_partition_size(1);
+    auto partitioned_results = search("sketch");
+    Config::get_instance().set_facet_min_partition_size(4096);
+
+    ASSERT_EQ(3, partitioned_results["facet_counts"][0]["counts"].size());
+    for(const auto& count: partitioned_results["facet_counts"][0]["counts"]) {
+        ASSERT_EQ(0, count["value"].get<std::string>().find("popular"));
+        ASSERT_GE(count["count"].get<size_t>(), 100);
+        ASSERT_LE(count["count"].get<size_t>() - count["count_error"].get<size_t>(), 100);
+    }
+}
+
+TEST_F(CollectionFacetingTest, RangeFacetCountsAndStats) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "rating", "type": "int32", "facet": true},
+                    {"name": "points", "type": "int32", "facet": true},
+                    {"name": "price", "type": "float", "facet": true}
+                ]
+                })"_json;
+
+    auto coll = collectionManager.create_collection(schema).get();
+
+    for(size_t i = 0; i < 200; i++) {
+        nlohmann::json doc;
+        doc["rating"] = int32_t(i % 5) + 1;
+        doc["points"] = int32_t(i);
+        doc["price"] = i * 0.5;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    // `rating` is counted off the id lists of its few distinct values, `price` off its column, while `points` has
+    // too many distinct values and is counted per result
+    auto results = coll->search("*", {}, "", {"rating(low:[0, 3], high:[3, 6])", "price(cheap:[0, 25], pricey:[25, 200])",
+                                              "points(first:[0, 100], second:[100, 200])"},
+                                {}, {0}, 10, 1, FREQUENCY, {false}).get();
+
+    ASSERT_EQ(3, results["facet_counts"].size());
+
+    const auto& rating_facet = results["facet_counts"][0];
+    ASSERT_EQ(2, rating_facet["counts"].size());
+    ASSERT_EQ("high", rating_facet["counts"][0]["value"]);
+    ASSERT_EQ(120, rating_facet["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ("low", rating_facet["counts"][1]["value"]);
+    ASSERT_EQ(80, rating_facet["counts"][1]["count"].get<size_t>());
+    ASSERT_FLOAT_EQ(1, rating_facet["stats"]["min"].get<double>());
+    ASSERT_FLOAT_EQ(5, rating_facet["stats"]["max"].get<double>());
+    ASSERT_FLOAT_EQ(600, rating_facet["stats"]["sum"].get<double>());
+    ASSERT_FLOAT_EQ(3, rating_facet["stats"]["avg"].get<double>());
+
+    const auto& price_facet = results["facet_counts"][1];
+    ASSERT_EQ(2, price_facet["counts"].size());
+    ASSERT_EQ("pricey", price_facet["counts"][0]["value"]);
+    ASSERT_EQ(150, price_facet["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ("cheap", price_facet["counts"][1]["value"]);
+    ASSERT_EQ(50, price_facet["counts"][1]["count"].get<size_t>());
+    ASSERT_FLOAT_EQ(0, price_facet["stats"]["min"].get<double>());
+    ASSERT_FLOAT_EQ(99.5, price_facet["stats"]["max"].get<double>());
+    ASSERT_FLOAT_EQ(9950, price_facet["stats"]["sum"].get<double>());
+
+    const auto& points_facet = results["facet_counts"][2];
+    ASSERT_EQ(2, points_facet["counts"].size());
+    ASSERT_EQ(100, points_facet["counts"][0]["count"].get<size_t>());
+    ASSERT_EQ(100, points_facet["counts"][1]["count"].get<size_t>());
+    ASSERT_FLOAT_EQ(199, points_facet["stats"]["max"].get<double>());
+
+    // stats of a float field read off its column match those of the values of the results
+    results = coll->search("*", {}, "points:<10", {"price"}, {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(10, results["facet_counts"][0]["counts"].size());
+    ASSERT_FLOAT_EQ(0, results["facet_counts"][0]["stats"]["min"].get<double>());
+    ASSERT_FLOAT_EQ(4.5, results["facet_counts"][0]["stats"]["max"].get<double>());
+    ASSERT_FLOAT_EQ(22.5, results["facet_counts"][0]["stats"]["sum"].get<double>());
+    ASSERT_FLOAT_EQ(2.25, results["facet_counts"][0]["stats"]["avg"].get<double>());
+}
+
+TEST_F(CollectionFacetingTest, SketchFacetPartitionsStraddleDenseThreshold) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "brand", "type": "string", "facet": true},
+                    {"name": "points", "type": "int32"}
+                ]
+                })"_json;
+
+    auto coll = collectionManager.create_collection(schema).get();
+
+    // The 70 results have 57 brands and the documents outside them have another 83, i.e. 140 facet codes.
+    for(size_t i = 0; i < 153; i++) {
+        nlohmann::json doc;
+        doc["brand"] = (i >= 70) ? "other" + std::to_string(i) :
+                       (i % 5 == 0) ? std::string("popular") : "rare" + std::to_string(i);
+        doc["points"] = int32_t(i);
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    auto search = [&]() {
+        return coll->search("*", {}, "points:<70", {"brand"}, {}, {0}, 10, 1, FREQUENCY, {false}, 1,
+                            spp::sparse_hash_set<std::string>(), spp::sparse_hash_set<std::string>(), 3, "", 30, 4,
+                            "", 20, {}, {}, {}, 0, "<mark>", "</mark>", {}, 1000, true, false, true, "", false,
+                            6000 * 1000, 4, 7, fallback, 4, {off}, 3, 3, 2, 2, false, "", true, 0, max_score, 100, 0,
+                            0, 4294967295UL, "sketch").get();
+    };
+
+    // 4 partitions of 18, 18, 18 and 16 results: the 140 codes are within 8 times the size of the first three, but
+    // not of the last one.
+    Config::get_instance().set_facet_min_partition_size(1);
+    auto results = search();
+    Config::get_instance().set_facet_min_partition_size(4096);
+
+    ASSERT_EQ(70, results["found"].get<size_t>());
+    ASSERT_TRUE(results["facet_counts"][0]["sketched"].get<bool>());
+    ASSERT_EQ(10, results["facet_counts"][0]["counts"].size());
+
+    const auto& top_count = results["facet_counts"][0]["counts"][0];
+    ASSERT_EQ("popular", top_count["value"].get<std::string>());
+    ASSERT_EQ(14, top_count["count"].get<size_t>());
+    ASSERT_EQ(0, top_count["count_error"].get<size_t>());
+
+    for(size_t i = 1; i < results["facet_counts"][0]["counts"].size(); i++) {
+        ASSERT_EQ(1, results["facet_counts"][0]["counts"][i]["count"].get<size_t>());
+    }
+
+    // a single partition of 70 results is counted densely, so the counts are not reported as sketched
+    results = search();
+    ASSERT_EQ(0, results["facet_counts"][0].count("sketched"));
+    ASSERT_EQ("popular", results["facet_counts"][0]["counts"][0]["value"].get<std::string>());
+    ASSERT_EQ(14, results["facet_counts"][0]["counts"][0]["count"].get<size_t>());
+}
+
+TEST_F(CollectionFacetingTest, FacetCountFilters) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "brand", "type": "string", "facet": true},
+                    {"name": "tags", "type": "string[]", "facet": true},
+                    {"name": "points", "type": "int32", "facet": true},
+                    {"name": "is_visible", "type": "bool"}
+                ]
+                })"_json;
+
+    auto coll = collectionManager.create_collection(schema).get();
+
+    auto add_doc = [&](size_t i) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["brand"] = "brand" + std::to_string(i % 5);
+        doc["tags"] = {"tag" + std::to_string(i % 3), "tag" + std::to_string(i % 5)};
+        doc["points"] = int32_t(i % 4);
+        doc["is_visible"] = (i % 3 != 0);
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    };
+
+    // documents indexed before the filter is registered are counted when it is registered
+    for(size_t i = 0; i < 50; i++) {
+        add_doc(i);
+    }
+
+    ASSERT_TRUE(coll->update_facet_count_filters({" is_visible:true "}).ok());
+    ASSERT_EQ(std::vector<std::string>{"is_visible:true"}, coll->get_facet_count_filters());
+
+    for(size_t i = 50; i < 100; i++) {
+        add_doc(i);
+    }
+
+    for(size_t i = 0; i < 100; i += 7) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["brand"] = "brand9";
+        doc["is_visible"] = (i % 3 == 0);
+        ASSERT_TRUE(coll->add(doc.dump(), UPDATE).ok());
+    }
+
+    for(size_t i = 0; i < 100; i += 11) {
+        ASSERT_TRUE(coll->remove(std::to_string(i)).ok());
+    }
+
+    auto search = [&](const std::string& filter_query, const std::string& pinned_hits = "",
+                      const std::string& hidden_hits = "") {
+        return coll->search("*", {}, filter_query, {"brand", "tags", "points"}, {}, {0}, 10, 1,
+                            FREQUENCY, {false}, 10, spp::sparse_hash_set<std::string>(),
+                            spp::sparse_hash_set<std::string>(), 10, "", 30, 4, "", Index::TYPO_TOKENS_THRESHOLD,
+                            pinned_hits, hidden_hits).get();
+    };
+
+    auto get_counts = [](const nlohmann::json& facet_count) {
+        std::map<std::string, size_t> counts;
+        for(const auto& count: facet_count["counts"]) {
+            counts[count["value"].get<std::string>()] = count["count"].get<size_t>();
+        }
+        return counts;
+    };
+
+    // the registered filter is matched verbatim, so the second filter is counted over its matching documents
+    auto results = search("is_visible:true");
+    auto counted_results = search("is_visible: true");
+
+    ASSERT_EQ(counted_results["found"], results["found"]);
+    ASSERT_EQ(3, results["facet_counts"].size());
+
+    for(size_t i = 0; i < 3; i++) {
+        ASSERT_EQ(get_counts(counted_results["facet_counts"][i]), get_counts(results["facet_counts"][i]));
+        ASSERT_EQ(counted_results["facet_counts"][i]["stats"]["total_values"],
+                  results["facet_counts"][i]["stats"]["total_values"]);
+    }
+
+    ASSERT_EQ(1, get_counts(results["facet_counts"][0]).count("brand9"));
+    ASSERT_EQ(6, results["facet_counts"][0]["stats"]["total_values"].get<size_t>());
+
+    // pinning a hidden document and hiding a visible one keeps the number of results but not the documents
+    results = search("is_visible:true", "3:1", "1");
+    counted_results = search("is_visible: true", "3:1", "1");
+
+    ASSERT_EQ(counted_results["found"], results["found"]);
+
+    for(size_t i = 0; i < 3; i++) {
+        ASSERT_EQ(get_counts(counted_results["facet_counts"][i]), get_counts(results["facet_counts"][i]));
+        ASSERT_EQ(counted_results["facet_counts"][i]["stats"]["total_values"],
+                  results["facet_counts"][i]["stats"]["total_values"]);
+    }
+
+    ASSERT_FALSE(coll->update_facet_count_filters({"unknown:true"}).ok());
+    ASSERT_FALSE(coll->update_facet_count_filters({" "}).ok());
+    ASSERT_EQ(1, coll->get_facet_count_filters().size());
+
+    ASSERT_TRUE(coll->update_facet_count_filters({}).ok());
+    ASSERT_TRUE(coll->get_facet_count_filters().empty());
+}
+
+TEST_F(CollectionFacetingTest, HierarchicalFacets) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "title", "type": "string"},
+                    {"name": "categories", "type": "string[]", "facet": true, "hierarchy_separator": " > "}
+                ]
+                })"_json;
+
+    auto coll_op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(coll_op.ok());
+    auto coll = coll_op.get();
+
+    std::vector<std::vector<std::string>> categories = {
+        {"Electronics > Phones > Android"},
+        {"Electronics > Phones > iOS"},
+        {"Electronics > Phones > Android", "Electronics > Laptops"},
+        {"Electronics > Laptops"},
+        {"Home > Kitchen"},
+    };
+
+    for(size_t i = 0; i < categories.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["categories"] = categories[i];
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    auto results = coll->search("*", {}, "", {"categories"}, {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(1, results["facet_counts"].size());
+
+    // a document is counted once for an ancestor shared by several of its values
+    const auto& hierarchy = results["facet_counts"][0]["hierarchy"];
+    ASSERT_EQ(2, hierarchy.size());
+    ASSERT_EQ("Electronics", hierarchy[0]["value"]);
+    ASSERT_EQ(4, hierarchy[0]["count"].get<size_t>());
+    ASSERT_EQ("Home", hierarchy[1]["value"]);
+    ASSERT_EQ(1, hierarchy[1]["count"].get<size_t>());
+
+    const auto& electronics = hierarchy[0]["children"];
+    ASSERT_EQ(2, electronics.size());
+    ASSERT_EQ("Electronics > Phones", electronics[0]["value"]);
+    ASSERT_EQ("Phones", electronics[0]["label"]);
+    ASSERT_EQ(3, electronics[0]["count"].get<size_t>());
+    ASSERT_EQ("Electronics > Laptops", electronics[1]["value"]);
+    ASSERT_EQ(2, electronics[1]["count"].get<size_t>());
+    ASSERT_EQ(0, electronics[1]["children"].size());
+
+    const auto& phones = electronics[0]["children"];
+    ASSERT_EQ(2, phones.size());
+    ASSERT_EQ("Android", phones[0]["label"]);
+    ASSERT_EQ(2, phones[0]["count"].get<size_t>());
+    ASSERT_EQ("iOS", phones[1]["label"]);
+    ASSERT_EQ(1, phones[1]["count"].get<size_t>());
+
+    // children are truncated per level
+    results = coll->search("*", {}, "", {"categories"}, {}, {0}, 10, 1, FREQUENCY, {false}, 1, spp::sparse_hash_set<std::string>(),
+                           spp::sparse_hash_set<std::string>(), 1).get();
+    ASSERT_EQ(1, results["facet_counts"][0]["hierarchy"].size());
+    ASSERT_EQ(1, results["facet_counts"][0]["hierarchy"][0]["children"].size());
+    ASSERT_EQ(1, results["facet_counts"][0]["hierarchy"][0]["children"][0]["children"].size());
+
+    // ancestors are removed along with the document
+    ASSERT_TRUE(coll->remove("4").ok());
+    ASSERT_TRUE(coll->remove("2").ok());
+
+    results = coll->search("*", {}, "", {"categories"}, {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    const auto& updated_hierarchy = results["facet_counts"][0]["hierarchy"];
+    ASSERT_EQ(1, updated_hierarchy.size());
+    ASSERT_EQ(3, updated_hierarchy[0]["count"].get<size_t>());
+    ASSERT_EQ(2, updated_hierarchy[0]["children"][0]["count"].get<size_t>());
+
+    // the separator is persisted with the schema
+    ASSERT_EQ(" > ", coll->get_summary_json()["fields"][1]["hierarchy_separator"]);
+
+    // children are truncated per level for the results of a facet count filter too
+    schema = R"({
+                "name": "test_visible",
+                "fields": [
+                    {"name": "categories", "type": "string[]", "facet": true, "hierarchy_separator": " > "},
+                    {"name": "is_visible", "type": "bool"}
+                ]
+                })"_json;
+
+    coll_op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(coll_op.ok());
+    auto visible_coll = coll_op.get();
+
+    for(size_t i = 0; i < categories.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["categories"] = categories[i];
+        doc["is_visible"] = (i != 4);
+        ASSERT_TRUE(visible_coll->add(doc.dump()).ok());
+    }
+
+    ASSERT_TRUE(visible_coll->update_facet_count_filters({"is_visible:true"}).ok());
+
+    results = visible_coll->search("*", {}, "is_visible:true", {"categories"}, {}, {0}, 10, 1, FREQUENCY, {false}, 10,
+                                   spp::sparse_hash_set<std::string>(), spp::sparse_hash_set<std::string>(), 2).get();
+    const auto& visible_hierarchy = results["facet_counts"][0]["hierarchy"];
+    ASSERT_EQ(1, visible_hierarchy.size());
+    ASSERT_EQ("Electronics", visible_hierarchy[0]["value"]);
+    ASSERT_EQ(4, visible_hierarchy[0]["count"].get<size_t>());
+
+    const auto& visible_electronics = visible_hierarchy[0]["children"];
+    ASSERT_EQ(2, visible_electronics.size());
+    ASSERT_EQ("Phones", visible_electronics[0]["label"]);
+    ASSERT_EQ(3, visible_electronics[0]["count"].get<size_t>());
+    ASSERT_EQ("Laptops", visible_electronics[1]["label"]);
+    ASSERT_EQ(2, visible_electronics[1]["count"].get<size_t>());
+
+    const auto& visible_phones = visible_electronics[0]["children"];
+    ASSERT_EQ(2, visible_phones.size());
+    ASSERT_EQ("Android", visible_phones[0]["label"]);
+    ASSERT_EQ(2, visible_phones[0]["count"].get<size_t>());
+    ASSERT_EQ("iOS", visible_phones[1]["label"]);
+    ASSERT_EQ(1, visible_phones[1]["count"].get<size_t>());
+
+    schema = R"({
+                "name": "test2",
+                "fields": [
+                    {"name": "categories", "type": "int32", "facet": true, "hierarchy_separator": " > "}
+                ]
+                })"_json;
+
+    coll_op = collectionManager.create_collection(schema);
+    ASSERT_FALSE(coll_op.ok());
+    ASSERT_EQ("Fields with the `hierarchy_separator` parameter can only be of type `string` or `string[]`.",
+              coll_op.error());
+}
+
+TEST_F(CollectionFacetingTest, DisjunctiveFacets) {
+    nlohmann::json schema = R"({
+                "name": "test",
+                "fields": [
+                    {"name": "title", "type": "string"},
+                    {"name": "brand", "type": "string", "facet": true},
+                    {"name": "color", "type": "string", "facet": true},
+                    {"name": "price", "type": "int32", "facet": true}
+                ]
+                })"_json;
+
+    auto coll_op = collectionManager.create_collection(schema);
+    ASSERT_TRUE(coll_op.ok());
+    auto coll = coll_op.get();
+
+    std::vector<std::tuple<std::string, std::string, std::string, int32_t>> records = {
+        {"running shoe", "nike", "red", 100},
+        {"running shoe", "nike", "blue", 120},
+        {"running shoe", "adidas", "red", 90},
+        {"walking shoe", "adidas", "green", 80},
+        {"running shoe", "puma", "red", 70},
+        {"running jacket", "puma", "blue", 5},
+    };
+
+    for(size_t i = 0; i < records.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = std::get<0>(records[i]);
+        doc["brand"] = std::get<1>(records[i]);
+        doc["color"] = std::get<2>(records[i]);
+        doc["price"] = std::get<3>(records[i]);
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    auto get_counts = [](const nlohmann::json& facet_counts) {
+        std::map<std::string, size_t> counts;
+        for(const auto& count: facet_counts["counts"]) {
+            counts[count["value"]] = count["count"].get<size_t>();
+        }
+        return counts;
+    };
+
+    const std::string filter_by = "brand:[nike, adidas] && color:red && price:>10";
+
+    // each facet is counted without the filter clauses on its own field
+    auto results = coll->search("*", {}, filter_by, {"brand(disjunctive:true)", "color(disjunctive:true)", "price"},
+                                {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(2, results["found"].get<size_t>());
+    ASSERT_EQ(3, results["facet_counts"].size());
+
+    std::map<std::string, size_t> expected_brands = {{"nike", 1}, {"adidas", 1}, {"puma", 1}};
+    std::map<std::string, size_t> expected_colors = {{"red", 2}, {"blue", 1}, {"green", 1}};
+    std::map<std::string, size_t> expected_prices = {{"100", 1}, {"90", 1}};
+    ASSERT_EQ(expected_brands, get_counts(results["facet_counts"][0]));
+    ASSERT_EQ(expected_colors, get_counts(results["facet_counts"][1]));
+    ASSERT_EQ(expected_prices, get_counts(results["facet_counts"][2]));
+
+    // text matches are narrowed by the clauses of the other fields
+    results = coll->search("running", {"title"}, filter_by, {"brand(disjunctive:true)", "color(disjunctive:true)"},
+                           {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(2, results["found"].get<size_t>());
+
+    expected_colors = {{"red", 2}, {"blue", 1}};
+    ASSERT_EQ(expected_brands, get_counts(results["facet_counts"][0]));
+    ASSERT_EQ(expected_colors, get_counts(results["facet_counts"][1]));
+
+    // a facet that is not disjunctive is counted against the results
+    results = coll->search("*", {}, filter_by, {"brand(disjunctive:false)", "color(disjunctive:true)"},
+                           {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    expected_brands = {{"nike", 1}, {"adidas", 1}};
+    expected_colors = {{"red", 2}, {"blue", 1}, {"green", 1}};
+    ASSERT_EQ(expected_brands, get_counts(results["facet_counts"][0]));
+    ASSERT_EQ(expected_colors, get_counts(results["facet_counts"][1]));
+
+    // facets have values even when the filter matches no document
+    results = coll->search("*", {}, "brand:puma && color:green && price:>10",
+                           {"brand(disjunctive:true)", "color(disjunctive:true)"},
+                           {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(0, results["found"].get<size_t>());
+
+    expected_brands = {{"adidas", 1}};
+    expected_colors = {{"red", 1}};
+    ASSERT_EQ(expected_brands, get_counts(results["facet_counts"][0]));
+    ASSERT_EQ(expected_colors, get_counts(results["facet_counts"][1]));
+
+    // excluded documents are not counted when the filter matches no document
+    results = coll->search("shoe -walking", {"title"}, "brand:puma && color:green && price:>10",
+                           {"brand(disjunctive:true)", "color(disjunctive:true)"},
+                           {}, {0}, 10, 1, FREQUENCY, {false}).get();
+    ASSERT_EQ(0, results["found"].get<size_t>());
+
+    expected_brands = {};
+    ASSERT_EQ(expected_brands, get_counts(results["facet_counts"][0]));
+    ASSERT_EQ(expected_colors, get_counts(results["facet_counts"][1]));
+
+    auto res_op = coll->search("*", {}, filter_by, {"brand(disjunctive:yes)"}, {}, {0}, 10, 1, FREQUENCY, {false});
+    ASSERT_FALSE(res_op.ok());
+    ASSERT_EQ("disjunctive string format is invalid.", res_op.error());
+}
+
 TEST_F(CollectionFacetingTest, FacetSearchWithFieldLevelSymbolsToIndex) {
     // symbols_to_index defined at collection level
     nlohmann::json schema2 = R"({
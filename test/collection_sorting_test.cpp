@@ -3220,6 +3220,91 @@ TEST_F(CollectionSortingTest, DecayFunctionsTest) {
     ASSERT_EQ(1728383250, results["hits"][4]["document"]["timestamp"].get<size_t>());
 }
 
+TEST_F(CollectionSortingTest, DerivedDecayFunctionField) {
+    auto schema_json = R"({
+            "name": "products",
+            "fields":[
+                {"name": "product_name","type": "string"},
+                {"name": "timestamp","type": "int64"},
+                {"name": "freshness","type": "float"}
+            ]
+    })"_json;
+
+    schema_json["fields"][2]["expression"] = "timestamp(origin: 1728385250, func: gauss, scale: 1000, decay: 0.5)";
+
+    auto coll_op = collectionManager.create_collection(schema_json);
+    ASSERT_TRUE(coll_op.ok());
+    auto coll = coll_op.get();
+
+    ASSERT_EQ("timestamp(origin: 1728385250, func: gauss, scale: 1000, decay: 0.5)",
+              coll->get_summary_json()["fields"][2]["expression"].get<std::string>());
+
+    std::vector<std::string> products = {"Samsung Smartphone", "Vivo SmartPhone", "Oneplus Smartphone", "Pixel Smartphone", "Moto Smartphone"};
+    nlohmann::json doc;
+    for (auto i = 0; i < products.size(); ++i) {
+        doc["id"] = std::to_string(i);
+        doc["product_name"] = products[i];
+        doc["timestamp"] = 1728383250 + i * 1000;
+        // values sent for a derived field are ignored
+        doc["freshness"] = 100;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    std::vector<sort_by> derived_sort_fields = {sort_by("freshness", "desc")};
+    sort_fields = {
+            sort_by("timestamp(origin: 1728385250, func: gauss, scale: 1000, decay: 0.5)", "desc"),
+    };
+
+    auto results = coll->search("smartphone", {"product_name"}, "", {}, derived_sort_fields, {0}).get();
+    auto expected_results = coll->search("smartphone", {"product_name"}, "", {}, sort_fields, {0}).get();
+
+    ASSERT_EQ(5, results["hits"].size());
+    std::vector<std::string> expected_ids = {"2", "3", "1", "4", "0"};
+    for (size_t i = 0; i < expected_ids.size(); i++) {
+        ASSERT_EQ(expected_ids[i], results["hits"][i]["document"]["id"]);
+        ASSERT_EQ(expected_ids[i], expected_results["hits"][i]["document"]["id"]);
+    }
+
+    ASSERT_FLOAT_EQ(1.0f, results["hits"][0]["document"]["freshness"].get<float>());
+    ASSERT_FLOAT_EQ(0.5f, results["hits"][1]["document"]["freshness"].get<float>());
+
+    // derived value follows updates of the source field
+    ASSERT_TRUE(coll->add(R"({"id": "0", "timestamp": 1728385250})"_json.dump(), UPDATE).ok());
+    results = coll->search("smartphone", {"product_name"}, "", {}, derived_sort_fields, {0}).get();
+    ASSERT_EQ(5, results["hits"].size());
+    ASSERT_FLOAT_EQ(1.0f, results["hits"][0]["document"]["freshness"].get<float>());
+    ASSERT_FLOAT_EQ(1.0f, results["hits"][1]["document"]["freshness"].get<float>());
+    ASSERT_FLOAT_EQ(0.5f, results["hits"][2]["document"]["freshness"].get<float>());
+
+    auto filter_results = coll->search("*", {}, "freshness:>= 0.9", {}, {}, {0}).get();
+    ASSERT_EQ(2, filter_results["found"].get<size_t>());
+
+    // invalid expressions
+    schema_json = R"({
+            "name": "products2",
+            "fields":[
+                {"name": "timestamp","type": "int64"},
+                {"name": "freshness","type": "int64"}
+            ]
+    })"_json;
+
+    schema_json["fields"][1]["expression"] = "timestamp(origin: 10, func: exp, scale: 10)";
+    coll_op = collectionManager.create_collection(schema_json);
+    ASSERT_FALSE(coll_op.ok());
+    ASSERT_EQ("Fields with the `expression` parameter can only be of type `float`.", coll_op.error());
+
+    schema_json["fields"][1]["type"] = "float";
+    schema_json["fields"][1]["expression"] = "title(origin: 10, func: exp, scale: 10)";
+    coll_op = collectionManager.create_collection(schema_json);
+    ASSERT_FALSE(coll_op.ok());
+    ASSERT_EQ("Property `expression` refers to the field `title` which is not found in the schema.", coll_op.error());
+
+    schema_json["fields"][1]["expression"] = "timestamp(origin: 10, scale: 10)";
+    coll_op = collectionManager.create_collection(schema_json);
+    ASSERT_FALSE(coll_op.ok());
+    ASSERT_EQ("Bad syntax. Missing param `func`.", coll_op.error());
+}
+
 TEST_F(CollectionSortingTest, TextMatchBucketSizeRanking) {
     std::vector<field> fields = {field("title", field_types::STRING, false),
                                  field("description", field_types::STRING, false),
@@ -3800,4 +3885,60 @@ TEST_F(CollectionSortingTest, EvalExpressionWithIdField) {
     ASSERT_EQ("3", res_obj["hits"][2]["document"]["id"].get<std::string>());
     ASSERT_EQ("5", res_obj["hits"][3]["document"]["id"].get<std::string>());
     ASSERT_EQ("4", res_obj["hits"][4]["document"]["id"].get<std::string>());
-}
\ No newline at end of file
+}
+
+TEST_F(CollectionSortingTest, SortByNumericArrayField) {
+    auto schema_json = R"({
+            "name": "products",
+            "fields":[
+                {"name": "product_name","type": "string"},
+                {"name": "prices","type": "int64[]", "sort": true},
+                {"name": "ratings","type": "float[]", "sort": true, "optional": true}
+            ]
+    })"_json;
+
+    auto coll_op = collectionManager.create_collection(schema_json);
+    ASSERT_TRUE(coll_op.ok());
+    auto coll = coll_op.get();
+
+    std::vector<std::vector<int64_t>> prices = {{30, 5}, {10, 20}, {8, 40}, {15}};
+    std::vector<std::vector<float>> ratings = {{-1.5, 4.0}, {2.5}, {}, {3.0, 0.5}};
+
+    for (size_t i = 0; i < prices.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["product_name"] = "Phone";
+        doc["prices"] = prices[i];
+        if (!ratings[i].empty()) {
+            doc["ratings"] = ratings[i];
+        }
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    // ascending sort orders arrays by their smallest value, descending sort by their largest value
+    std::vector<std::pair<sort_by, std::vector<std::string>>> sorts = {
+            {sort_by("prices", "asc"), {"0", "2", "1", "3"}},
+            {sort_by("prices", "desc"), {"2", "0", "1", "3"}},
+            {sort_by("ratings", "asc"), {"0", "3", "1", "2"}},
+            {sort_by("ratings", "desc"), {"0", "3", "1", "2"}},
+    };
+
+    for (const auto& sort: sorts) {
+        std::vector<sort_by> sort_fields_arr = {sort.first};
+        auto results = coll->search("phone", {"product_name"}, "", {}, sort_fields_arr, {0}).get();
+        ASSERT_EQ(4, results["hits"].size());
+
+        for (size_t i = 0; i < sort.second.size(); i++) {
+            ASSERT_EQ(sort.second[i], results["hits"][i]["document"]["id"]) << sort.first.name << " " << sort.first.order;
+        }
+    }
+
+    // removing a value narrows the bounds of the document
+    ASSERT_TRUE(coll->add(R"({"id": "2", "prices": [40]})"_json.dump(), UPDATE).ok());
+    std::vector<sort_by> sort_fields_arr = {sort_by("prices", "asc")};
+    auto results = coll->search("phone", {"product_name"}, "", {}, sort_fields_arr, {0}).get();
+    std::vector<std::string> expected_ids = {"0", "1", "3", "2"};
+    for (size_t i = 0; i < expected_ids.size(); i++) {
+        ASSERT_EQ(expected_ids[i], results["hits"][i]["document"]["id"]);
+    }
+}
@@ -5866,4 +5866,66 @@ nlohmann::json schema = R"({
     })"_json;
     add_op = coll1->add(doc.dump());
     ASSERT_TRUE(add_op.ok());
-}
\ No newline at end of file
+}
+
+TEST_F(CollectionVectorTest, LazyFilterEstimateNearFlatSearchCutoff) {
+    nlohmann::json schema = R"({
+        "name": "coll1",
+        "fields": [
+            {"name": "points", "type": "int32"},
+            {"name": "rank", "type": "int32"},
+            {"name": "vec", "type": "float[]", "num_dim": 4}
+        ]
+    })"_json;
+
+    Collection* coll1 = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 200; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["points"] = i;
+        doc["rank"] = 199 - i;
+        doc["vec"] = {float(i % 7) / 7, float(i % 11) / 11, float(i % 13) / 13, 1.0};
+        ASSERT_TRUE(coll1->add(doc.dump()).ok());
+    }
+
+    // Each clause matches 110 documents, but only the 20 documents from 90 to 109 match both.
+    auto search = [&](const std::string& flat_search_cutoff, const std::string& per_page) {
+        std::map<std::string, std::string> req_params = {
+                {"collection", "coll1"},
+                {"q", "*"},
+                {"filter_by", "points: >= 90 && rank: >= 90"},
+                {"vector_query", "vec:([0.5, 0.5, 0.5, 0.5], flat_search_cutoff: " + flat_search_cutoff + ")"},
+                {"per_page", per_page},
+                {"enable_lazy_filter", "true"}
+        };
+        nlohmann::json embedded_params;
+        std::string json_res;
+        auto now_ts = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        auto search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+        EXPECT_TRUE(search_op.ok());
+        return nlohmann::json::parse(json_res);
+    };
+
+    // The estimate of the filter is above the cutoff, but its exact count isn't: all the matches are searched
+    // exhaustively, instead of only the 10 nearest ones HNSW is asked for.
+    auto res = search("50", "10");
+    ASSERT_EQ(20, res["found"].get<size_t>());
+    ASSERT_EQ(10, res["hits"].size());
+
+    // The estimate is far above the cutoff, so HNSW is tried first and the search falls back to a flat search when it
+    // can't find as many hits as requested.
+    res = search("5", "30");
+    ASSERT_EQ(20, res["found"].get<size_t>());
+    ASSERT_EQ(20, res["hits"].size());
+
+    for (size_t i = 0; i < res["hits"].size(); i++) {
+        auto points = res["hits"][i]["document"]["points"].get<size_t>();
+        ASSERT_TRUE(points >= 90 && points < 110);
+
+        if (i != 0) {
+            ASSERT_LE(res["hits"][i - 1]["vector_distance"].get<float>(), res["hits"][i]["vector_distance"].get<float>());
+        }
+    }
+}
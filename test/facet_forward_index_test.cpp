@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <map>
+#include "facet_forward_index.h"
+
+namespace {
+    std::vector<std::pair<uint32_t, uint32_t>> get_entries(const facet_forward_index_t& index, uint32_t seq_id) {
+        const uint32_t* codes = nullptr;
+        const uint32_t* positions = nullptr;
+        const auto num_codes = index.get(seq_id, codes, positions);
+
+        std::vector<std::pair<uint32_t, uint32_t>> entries;
+        for (size_t i = 0; i < num_codes; i++) {
+            entries.emplace_back(index.get_facet_id(codes[i]), positions == nullptr ? 0 : positions[i]);
+        }
+
+        return entries;
+    }
+}
+
+TEST(FacetForwardIndexTest, UpsertGetErase) {
+    facet_forward_index_t index;
+
+    ASSERT_FALSE(index.contains(10));
+    ASSERT_TRUE(get_entries(index, 10).empty());
+    index.erase(10);
+
+    index.upsert(10, {7});
+    index.upsert(3, {UINT32_MAX});
+    ASSERT_EQ(2, index.num_ids());
+    ASSERT_EQ((std::vector<std::pair<uint32_t, uint32_t>>{{7, 0}}), get_entries(index, 10));
+    ASSERT_EQ((std::vector<std::pair<uint32_t, uint32_t>>{{UINT32_MAX, 0}}), get_entries(index, 3));
+
+    // duplicates are dropped, keeping the position of the first occurrence
+    index.upsert(20, {5, 9, 5, 2, 9});
+    ASSERT_EQ((std::vector<std::pair<uint32_t, uint32_t>>{{5, 0}, {9, 1}, {2, 3}}), get_entries(index, 20));
+
+    // an array with a single distinct value
+    index.upsert(21, {4, 4, 4});
+    ASSERT_EQ((std::vector<std::pair<uint32_t, uint32_t>>{{4, 0}}), get_entries(index, 21));
+
+    // replacing values moves the document between the layouts
+    index.upsert(10, {1, 2});
+    index.upsert(20, {8});
+    ASSERT_EQ((std::vector<std::pair<uint32_t, uint32_t>>{{1, 0}, {2, 1}}), get_entries(index, 10));
+    ASSERT_EQ((std::vector<std::pair<uint32_t, uint32_t>>{{8, 0}}), get_entries(index, 20));
+    ASSERT_EQ(4, index.num_ids());
+
+    index.upsert(21, {});
+    ASSERT_FALSE(index.contains(21));
+
+    index.erase(10);
+    index.erase(20);
+    ASSERT_FALSE(index.contains(10));
+    ASSERT_FALSE(index.contains(20));
+    ASSERT_EQ(1, index.num_ids());
+}
+
+TEST(FacetForwardIndexTest, CodesAreDenseAndReused) {
+    facet_forward_index_t index;
+
+    index.upsert(0, {1000});
+    index.upsert(1, {2000, 1000});
+    index.upsert(2, {3000});
+    ASSERT_EQ(3, index.num_codes());
+    ASSERT_EQ(3, index.num_facet_ids());
+
+    // the code of a value is released once no document has the value
+    index.erase(2);
+    ASSERT_EQ(2, index.num_facet_ids());
+
+    index.upsert(3, {4000});
+    ASSERT_EQ(3, index.num_codes());
+    ASSERT_EQ(3, index.num_facet_ids());
+
+    const uint32_t* codes = nullptr;
+    const uint32_t* positions = nullptr;
+    ASSERT_EQ(1, index.get(3, codes, positions));
+    ASSERT_EQ(4000, index.get_facet_id(codes[0]));
+}
+
+TEST(FacetForwardIndexTest, CountMatchesPerDocumentLookup) {
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<uint32_t> value_distr(0, 50);
+    std::uniform_int_distribution<uint32_t> len_distr(0, 4);
+
+    facet_forward_index_t index;
+    for (uint32_t seq_id = 0; seq_id < 3000; seq_id++) {
+        std::vector<uint32_t> values(len_distr(gen));
+        for (auto& value: values) {
+            value = value_distr(gen) * 7919;
+        }
+        index.upsert(seq_id, values);
+    }
+
+    std::vector<uint32_t> seq_ids;
+    for (uint32_t seq_id = 0; seq_id < 3500; seq_id += 1 + (gen() % 3)) {
+        seq_ids.push_back(seq_id);
+    }
+
+    for (size_t stride: {1, 2, 5}) {
+        std::vector<uint32_t> expected(index.num_codes(), 0);
+        for (size_t i = 0; i < seq_ids.size(); i += stride) {
+            const uint32_t* codes = nullptr;
+            const uint32_t* positions = nullptr;
+            const auto num_codes = index.get(seq_ids[i], codes, positions);
+            for (size_t j = 0; j < num_codes; j++) {
+                expected[codes[j]]++;
+            }
+        }
+
+        std::vector<uint32_t> counts(index.num_codes(), 0);
+        index.count(seq_ids.data(), seq_ids.size(), stride, counts.data());
+        ASSERT_EQ(expected, counts) << stride;
+    }
+}
+
+TEST(FacetForwardIndexTest, RandomOperations) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<uint32_t> value_distr(0, 20);
+    std::uniform_int_distribution<uint32_t> len_distr(0, 6);
+
+    const uint32_t num_ids = 5000;
+    facet_forward_index_t index;
+    std::map<uint32_t, std::vector<uint32_t>> id_values;
+
+    for (size_t i = 0; i < 50000; i++) {
+        const uint32_t seq_id = gen() % num_ids;
+
+        if (gen() % 4 == 0) {
+            index.erase(seq_id);
+            id_values.erase(seq_id);
+            continue;
+        }
+
+        std::vector<uint32_t> values(len_distr(gen));
+        for (auto& value: values) {
+            value = value_distr(gen);
+        }
+
+        index.upsert(seq_id, values);
+
+        if (values.empty()) {
+            id_values.erase(seq_id);
+        } else {
+            id_values[seq_id] = values;
+        }
+    }
+
+    ASSERT_EQ(id_values.size(), index.num_ids());
+
+    for (uint32_t seq_id = 0; seq_id < num_ids; seq_id++) {
+        const auto entries = get_entries(index, seq_id);
+        const auto it = id_values.find(seq_id);
+
+        if (it == id_values.end()) {
+            ASSERT_TRUE(entries.empty());
+            continue;
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> expected;
+        for (uint32_t pos = 0; pos < it->second.size(); pos++) {
+            bool seen = false;
+            for (const auto& entry: expected) {
+                seen = seen || entry.first == it->second[pos];
+            }
+
+            if (!seen) {
+                expected.emplace_back(it->second[pos], pos);
+            }
+        }
+
+        ASSERT_EQ(expected, entries);
+    }
+}
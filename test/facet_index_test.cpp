@@ -118,3 +118,52 @@ TEST(FacetIndexTest, FacetValueDeletionFloat) {
     findex.remove(doc, pricef, 2);
     ASSERT_FALSE(findex.facet_value_exists("price", "99.95"));
 }
+
+TEST(FacetIndexTest, FacetQueryOverTokenIndex) {
+    facet_index_t findex;
+    findex.initialize("brand");
+    findex.initialize_token_index("brand", true, "", {}, {});
+
+    std::unordered_map<facet_value_id_t, std::vector<uint32_t>, facet_value_id_t::Hash> fvalue_to_seq_ids;
+    std::unordered_map<uint32_t, std::vector<facet_value_id_t>> seq_id_to_fvalues;
+
+    std::vector<std::string> brands = {"Nike Air", "Nike Running", "New Balance", "Adidas Running", "Nike Air"};
+
+    for(uint32_t seq_id = 0; seq_id < brands.size(); seq_id++) {
+        facet_value_id_t fvalue(brands[seq_id]);
+        fvalue_to_seq_ids[fvalue].push_back(seq_id);
+        seq_id_to_fvalues[seq_id] = {fvalue};
+    }
+
+    findex.insert("brand", fvalue_to_seq_ids, seq_id_to_fvalues, true);
+
+    field brandf("brand", field_types::STRING, true);
+    std::vector<uint32_t> result_ids = {0, 1, 2, 3, 4};
+
+    auto search = [&](const std::vector<std::vector<std::string>>& searched_tokens,
+                      std::map<std::string, docid_count_t>& found) {
+        facet a_facet("brand", 0);
+        found.clear();
+        return findex.intersect(a_facet, brandf, true, false, 1, searched_tokens, {}, {},
+                                result_ids.data(), result_ids.size(), 10, found, false);
+    };
+
+    // every searched token must prefix one of the tokens of a value
+    std::map<std::string, docid_count_t> found;
+    ASSERT_EQ(1, search({{"nike", "a"}}, found));
+    ASSERT_EQ(2, found["Nike Air"].count);
+
+    ASSERT_EQ(3, search({{"nike", "a"}, {"runn"}}, found));
+    ASSERT_EQ(2, found["Nike Air"].count);
+    ASSERT_EQ(1, found["Nike Running"].count);
+    ASSERT_EQ(1, found["Adidas Running"].count);
+
+    ASSERT_EQ(0, search({{"puma"}}, found));
+
+    // values without documents are dropped from the token index
+    nlohmann::json doc;
+    doc["brand"] = "New Balance";
+    findex.remove(doc, brandf, 2);
+    ASSERT_EQ(2, search({{"n"}}, found));
+    ASSERT_EQ(0, found.count("New Balance"));
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "facet_value_dict.h"
+
+TEST(FacetValueDictTest, AddFindErase) {
+    facet_value_dict_t dict;
+    uint32_t facet_id = 0;
+
+    ASSERT_FALSE(dict.find("nike", facet_id));
+    ASSERT_TRUE(dict.get(1).empty());
+
+    ASSERT_TRUE(dict.add(1, "nike"));
+    ASSERT_TRUE(dict.add(2, "adidas"));
+    ASSERT_TRUE(dict.add(3, ""));
+
+    // neither a value nor an id is interned twice
+    ASSERT_FALSE(dict.add(4, "nike"));
+    ASSERT_FALSE(dict.add(2, "puma"));
+    ASSERT_EQ(3, dict.size());
+
+    ASSERT_TRUE(dict.find("nike", facet_id));
+    ASSERT_EQ(1, facet_id);
+    ASSERT_EQ("adidas", dict.get(2));
+    ASSERT_TRUE(dict.find("", facet_id));
+    ASSERT_EQ(3, facet_id);
+    ASSERT_FALSE(dict.find("puma", facet_id));
+
+    dict.erase(1);
+    dict.erase(10);
+    ASSERT_FALSE(dict.contains(1));
+    ASSERT_FALSE(dict.find("nike", facet_id));
+    ASSERT_EQ(2, dict.size());
+
+    // an erased value can come back under a new id
+    ASSERT_TRUE(dict.add(5, "nike"));
+    ASSERT_TRUE(dict.find("nike", facet_id));
+    ASSERT_EQ(5, facet_id);
+
+    dict.clear();
+    ASSERT_EQ(0, dict.size());
+    ASSERT_EQ(0, dict.allocated_bytes());
+}
+
+TEST(FacetValueDictTest, CompactsErasedValues) {
+    facet_value_dict_t dict;
+    const size_t num_values = 20000;
+
+    for(uint32_t i = 0; i < num_values; i++) {
+        ASSERT_TRUE(dict.add(i, "value_" + std::to_string(i)));
+    }
+
+    const size_t allocated_bytes = dict.allocated_bytes();
+
+    for(uint32_t i = 0; i < num_values; i++) {
+        if(i % 10 != 0) {
+            dict.erase(i);
+        }
+    }
+
+    // the values left behind are moved into fewer blocks
+    ASSERT_EQ(num_values / 10, dict.size());
+    ASSERT_LT(dict.allocated_bytes(), allocated_bytes / 2);
+
+    for(uint32_t i = 0; i < num_values; i += 10) {
+        uint32_t facet_id = 0;
+        const std::string value = "value_" + std::to_string(i);
+        ASSERT_EQ(value, dict.get(i));
+        ASSERT_TRUE(dict.find(value, facet_id));
+        ASSERT_EQ(i, facet_id);
+    }
+
+    // values longer than a block get their own
+    const std::string long_value(100 * 1024, 'a');
+    ASSERT_TRUE(dict.add(num_values, long_value));
+    ASSERT_EQ(long_value, dict.get(num_values));
+}
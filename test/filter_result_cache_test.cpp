@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "filter_result_cache.h"
+
+TEST(FilterResultCacheTest, LookupAndInvalidation) {
+    filter_result_cache_t cache;
+    std::shared_ptr<const std::vector<uint32_t>> ids;
+
+    // the cache is disabled until it is given a budget
+    ASSERT_FALSE(cache.is_enabled());
+    cache.insert("points:>10", cache.get_epochs({"points"}), {1, 2, 3});
+    ASSERT_EQ(0, cache.size());
+
+    cache.set_max_bytes(1024 * 1024);
+    ASSERT_TRUE(cache.is_enabled());
+    ASSERT_FALSE(cache.lookup("points:>10", ids));
+
+    cache.insert("points:>10", cache.get_epochs({"points"}), {1, 2, 3});
+    cache.insert("(points:>10&&tags:!=gold)", cache.get_epochs({"points", "tags", "id"}), {2});
+    ASSERT_EQ(2, cache.size());
+
+    ASSERT_TRUE(cache.lookup("points:>10", ids));
+    ASSERT_EQ(std::vector<uint32_t>({1, 2, 3}), *ids);
+
+    // a write to any of the fields of an entry makes it stale
+    cache.bump_epoch("id");
+    ASSERT_FALSE(cache.lookup("(points:>10&&tags:!=gold)", ids));
+    ASSERT_TRUE(cache.lookup("points:>10", ids));
+    ASSERT_EQ(1, cache.size());
+
+    // a result computed from epochs read before a write is stale as soon as it is added
+    auto field_epochs = cache.get_epochs({"points"});
+    cache.bump_epoch("points");
+    cache.insert("points:<5", field_epochs, {4});
+    ASSERT_FALSE(cache.lookup("points:<5", ids));
+    ASSERT_FALSE(cache.lookup("points:>10", ids));
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(0, cache.bytes());
+
+    cache.insert("points:<5", cache.get_epochs({"points"}), {4});
+    cache.clear();
+    ASSERT_EQ(0, cache.size());
+    ASSERT_FALSE(cache.lookup("points:<5", ids));
+}
+
+TEST(FilterResultCacheTest, EvictsLeastRecentlyUsed) {
+    filter_result_cache_t cache;
+    cache.set_max_bytes(8 * 1024);
+
+    const std::vector<uint32_t> ids(500, 1);
+    cache.insert("a", {}, std::vector<uint32_t>(ids));
+    cache.insert("b", {}, std::vector<uint32_t>(ids));
+    cache.insert("c", {}, std::vector<uint32_t>(ids));
+    ASSERT_EQ(3, cache.size());
+
+    std::shared_ptr<const std::vector<uint32_t>> cached_ids;
+    ASSERT_TRUE(cache.lookup("a", cached_ids));
+
+    // `b` is the least recently used
+    cache.insert("d", {}, std::vector<uint32_t>(ids));
+    ASSERT_EQ(3, cache.size());
+    ASSERT_FALSE(cache.lookup("b", cached_ids));
+    ASSERT_TRUE(cache.lookup("a", cached_ids));
+    ASSERT_TRUE(cache.lookup("c", cached_ids));
+    ASSERT_TRUE(cache.lookup("d", cached_ids));
+    ASSERT_LE(cache.bytes(), 8 * 1024);
+
+    // ids handed out stay valid after their entry is evicted
+    cache.set_max_bytes(0);
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(500, cached_ids->size());
+
+    // a result larger than the whole budget is not cached
+    cache.set_max_bytes(1024);
+    cache.insert("e", {}, std::vector<uint32_t>(ids));
+    ASSERT_EQ(0, cache.size());
+}
@@ -6,6 +6,7 @@
 #include <filter.h>
 #include <posting.h>
 #include <chrono>
+#include <future>
 #include "collection.h"
 
 class FilterTest : public ::testing::Test {
@@ -2737,4 +2738,1059 @@ TEST_F(FilterTest, ObjectFitlterIterator) {
     ASSERT_EQ(filter_result_iterator_t::invalid, not_object_filter_test.validity);
 
     delete filter_tree_root;
-}
\ No newline at end of file
+
+    // An object filter that can't be compiled fails the initialization instead of matching no document.
+    filter_op = filter::parse_filter_query("ingredients.{name: ^= chee && concentration: [25..45]}",
+                                           coll->get_schema(), store, doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+
+    auto prefix_object_filter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root,
+                                                              enable_lazy_evaluation);
+    ASSERT_FALSE(prefix_object_filter_test.init_status().ok());
+    ASSERT_EQ(400, prefix_object_filter_test.init_status().code());
+    ASSERT_EQ("Error with filter field `ingredients.name`: Prefix and suffix filters are not supported within object "
+              "filters.", prefix_object_filter_test.init_status().error());
+    ASSERT_EQ(filter_result_iterator_t::invalid, prefix_object_filter_test.validity);
+
+    delete filter_tree_root;
+}
+
+TEST_F(FilterTest, NumericHistogramFilterOrdering) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "points", "type": "int32"},
+                    {"name": "rank", "type": "int32"},
+                    {"name": "rating", "type": "float"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 100; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["points"] = (int32_t) (i % 10);
+        doc["rank"] = (int32_t) i;
+        doc["rating"] = i * 0.5;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    auto const& histograms = coll->_get_index()->_get_numeric_histogram_index();
+    ASSERT_EQ(3, histograms.size());
+    ASSERT_EQ(100, histograms.at("rank")->size());
+    ASSERT_EQ(0, histograms.at("rank")->min());
+    ASSERT_EQ(99, histograms.at("rank")->max());
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    filter_node_t* filter_tree_root = nullptr;
+
+    // Broad subtree is probed with the ids of the selective subtree.
+    Option<bool> filter_op = filter::parse_filter_query("points: >= 0 && rank: [5, 47]", coll->get_schema(), store,
+                                                        doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+
+    for (auto const& enable_lazy_evaluation: {false, true}) {
+        auto iter_probe_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root,
+                                                        enable_lazy_evaluation);
+        ASSERT_TRUE(iter_probe_test.init_status().ok());
+
+        iter_probe_test.compute_iterators();
+
+        std::vector<uint32_t> expected = {5, 47};
+        for (auto const& id: expected) {
+            ASSERT_EQ(filter_result_iterator_t::valid, iter_probe_test.validity);
+            ASSERT_EQ(id, iter_probe_test.seq_id);
+            iter_probe_test.next();
+        }
+        ASSERT_EQ(filter_result_iterator_t::invalid, iter_probe_test.validity);
+    }
+
+    delete filter_tree_root;
+    filter_tree_root = nullptr;
+
+    // Range outside of the value domain of `rating` is evaluated first and short-circuits the filter.
+    filter_op = filter::parse_filter_query("points: >= 0 && rating: > 100", coll->get_schema(), store,
+                                           doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+
+    auto iter_out_of_range_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+    ASSERT_TRUE(iter_out_of_range_test.init_status().ok());
+    ASSERT_EQ(filter_result_iterator_t::invalid, iter_out_of_range_test.validity);
+    ASSERT_TRUE(iter_out_of_range_test._get_is_filter_result_initialized());
+    ASSERT_EQ(nullptr, iter_out_of_range_test._get_left_it());
+    ASSERT_EQ(nullptr, iter_out_of_range_test._get_right_it());
+
+    delete filter_tree_root;
+    filter_tree_root = nullptr;
+
+    // Histograms are updated on removal.
+    for (size_t i = 0; i < 50; i++) {
+        ASSERT_TRUE(coll->remove(std::to_string(i)).ok());
+    }
+
+    ASSERT_EQ(50, histograms.at("points")->size());
+    ASSERT_EQ(50, histograms.at("rank")->size());
+    ASSERT_NEAR(0, histograms.at("rank")->approx_range_count(0, 49), 5);
+    ASSERT_NEAR(50, histograms.at("rank")->approx_range_count(50, 99), 5);
+}
+
+TEST_F(FilterTest, FloatColumnRangeFilter) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "rating", "type": "float"},
+                    {"name": "score", "type": "float", "range_index": true},
+                    {"name": "ratings", "type": "float[]"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    std::vector<float> values = {-2.5, -0.0, 0.0, 1.5, 3.25, -7.0, 10.0, 0.0};
+    for (size_t i = 0; i < values.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["rating"] = values[i];
+        doc["score"] = values[i];
+        doc["ratings"] = {values[i]};
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    ASSERT_TRUE(coll->remove("3").ok());
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+
+    // Broad ranges are evaluated off the float column and must match the numeric index (`ratings` has no column).
+    std::vector<std::string> filters = {"[-3..1.5]", ">= -0.0", "> 0", "< 0", "<= -2.5", "[-10..-3, 3..10]"};
+    std::vector<std::vector<uint32_t>> expected = {{0, 1, 2, 7}, {1, 2, 4, 6, 7}, {4, 6}, {0, 1, 5}, {0, 5},
+                                                   {4, 5, 6}};
+
+    for (size_t i = 0; i < filters.size(); i++) {
+        for (const auto& field_name: {"rating", "score", "ratings"}) {
+            filter_node_t* filter_tree_root = nullptr;
+            Option<bool> filter_op = filter::parse_filter_query(std::string(field_name) + ": " + filters[i],
+                                                                coll->get_schema(), store, doc_id_prefix,
+                                                                filter_tree_root);
+            ASSERT_TRUE(filter_op.ok());
+
+            auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, false);
+            ASSERT_TRUE(iter_test.init_status().ok());
+
+            std::vector<uint32_t> ids;
+            while (iter_test.validity == filter_result_iterator_t::valid) {
+                ids.push_back(iter_test.seq_id);
+                iter_test.next();
+            }
+
+            ASSERT_EQ(expected[i], ids) << field_name << ": " << filters[i];
+            delete filter_tree_root;
+        }
+    }
+}
+
+TEST_F(FilterTest, NumericArrayMinMaxProbe) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "values", "type": "int32[]"},
+                    {"name": "weights", "type": "float[]", "range_index": true}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    std::vector<std::vector<int32_t>> values = {{1, 10}, {5}, {2, 8}, {20, 30}, {7, 7}, {-5, 15}};
+    for (size_t i = 0; i < values.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["values"] = values[i];
+        doc["weights"] = nlohmann::json::array();
+        for (const auto& value: values[i]) {
+            doc["weights"].push_back(value * 0.5);
+        }
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    // Changing the array must not leave the bounds of the old values behind.
+    nlohmann::json doc;
+    doc["id"] = "4";
+    doc["values"] = {40};
+    doc["weights"] = {20.0};
+    ASSERT_TRUE(coll->add(doc.dump(), UPDATE).ok());
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    const std::vector<uint32_t> probe_ids = {0, 1, 2, 3, 4, 5};
+
+    // Bounds decide most of the ids; ids whose bounds straddle the range are checked against the values.
+    std::vector<std::string> filters = {"values: [1..8]", "values: [-5..2]", "values: >15", "values: [3..4, 6..9]",
+                                        "weights: [0.5..4]", "weights: >= 10"};
+    std::vector<std::vector<uint32_t>> expected = {{0, 1, 2}, {0, 2, 5}, {3, 4}, {2}, {0, 1, 2}, {3, 4}};
+
+    for (size_t i = 0; i < filters.size(); i++) {
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> filter_op = filter::parse_filter_query(filters[i], coll->get_schema(), store, doc_id_prefix,
+                                                            filter_tree_root);
+        ASSERT_TRUE(filter_op.ok());
+
+        auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, true);
+        ASSERT_TRUE(iter_test.init_status().ok());
+
+        filter_result_t result;
+        iter_test.and_scalar(probe_ids.data(), probe_ids.size(), result);
+
+        ASSERT_EQ(expected[i], std::vector<uint32_t>(result.docs, result.docs + result.count)) << filters[i];
+        delete filter_tree_root;
+    }
+}
+
+TEST_F(FilterTest, FilterTreeCache) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "name", "type": "string"},
+                    {"name": "points", "type": "int32"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 3; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["name"] = "name_" + std::to_string(i);
+        doc["points"] = i;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    filter_tree_cache_t cache;
+    cache.set_max_entries(10);
+
+    filter_node_t* first_root = nullptr;
+    auto filter_op = cache.parse_filter_query("points: >0 && id: [1, 2, 5]", coll->get_schema(), store,
+                                              doc_id_prefix, first_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> first_root_guard(first_root);
+    ASSERT_EQ(1, cache.size());
+
+    // every query gets its own copy of the tree
+    filter_node_t* second_root = nullptr;
+    filter_op = cache.parse_filter_query("points: >0 && id: [1, 2, 5]", coll->get_schema(), store,
+                                         doc_id_prefix, second_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> second_root_guard(second_root);
+    ASSERT_NE(first_root, second_root);
+    ASSERT_NE(first_root->right, second_root->right);
+    ASSERT_EQ(std::vector<std::string>({"1", "2"}), second_root->right->filter_exp.values);
+    ASSERT_EQ("points: >0 && id: [1, 2, 5]", second_root->filter_query);
+
+    // errors are not cached
+    filter_node_t* error_root = nullptr;
+    filter_op = cache.parse_filter_query("unknown: 1", coll->get_schema(), store, doc_id_prefix, error_root);
+    ASSERT_FALSE(filter_op.ok());
+    ASSERT_EQ(1, cache.size());
+
+    // a tree with `id` filters is parsed again once a document id is written
+    nlohmann::json doc;
+    doc["id"] = "5";
+    doc["name"] = "name_5";
+    doc["points"] = 5;
+    ASSERT_TRUE(coll->add(doc.dump()).ok());
+    cache.bump_doc_ids_epoch();
+
+    filter_node_t* third_root = nullptr;
+    filter_op = cache.parse_filter_query("points: >0 && id: [1, 2, 5]", coll->get_schema(), store,
+                                         doc_id_prefix, third_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> third_root_guard(third_root);
+    ASSERT_EQ(std::vector<std::string>({"1", "2", "3"}), third_root->right->filter_exp.values);
+
+    cache.bump_schema_version();
+    ASSERT_EQ(0, cache.size());
+
+    // searches see the documents added after the filter was first parsed
+    auto results = coll->search("*", {}, "id: [0, 6]", {}, {}, {0}).get();
+    ASSERT_EQ(1, results["found"].get<size_t>());
+
+    doc["id"] = "6";
+    doc["name"] = "name_6";
+    doc["points"] = 6;
+    ASSERT_TRUE(coll->add(doc.dump()).ok());
+
+    results = coll->search("*", {}, "id: [0, 6]", {}, {}, {0}).get();
+    ASSERT_EQ(2, results["found"].get<size_t>());
+
+    ASSERT_TRUE(coll->remove("6").ok());
+    results = coll->search("*", {}, "id: [0, 6]", {}, {}, {0}).get();
+    ASSERT_EQ(1, results["found"].get<size_t>());
+}
+
+TEST_F(FilterTest, CostBasedFilterPlan) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "brand", "type": "string", "facet": true},
+                    {"name": "title", "type": "string"},
+                    {"name": "points", "type": "int32"},
+                    {"name": "in_stock", "type": "bool"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 100; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["brand"] = (i % 20 == 0) ? "Nike" : "Adidas";
+        doc["title"] = (i % 4 == 0) ? "running shoe" : "tennis shoe";
+        doc["points"] = (int32_t) i;
+        doc["in_stock"] = true;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    filter_node_t* filter_tree_root = nullptr;
+
+    Option<bool> filter_op = filter::parse_filter_query("in_stock: true && points: >= 10 && title: running && "
+                                                        "brand:= Nike", coll->get_schema(), store, doc_id_prefix,
+                                                        filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    filter_result_iterator_t::reorder_filter_tree(coll->_get_index(), filter_tree_root);
+
+    // Operands are ordered by their estimated number of matches and the root stays the root.
+    ASSERT_EQ(filter_tree_root_guard.get(), filter_tree_root);
+    ASSERT_EQ("in_stock", filter_tree_root->right->filter_exp.field_name);
+    ASSERT_EQ("points", filter_tree_root->left->right->filter_exp.field_name);
+    ASSERT_EQ("title", filter_tree_root->left->left->right->filter_exp.field_name);
+    ASSERT_EQ("brand", filter_tree_root->left->left->left->filter_exp.field_name);
+
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    iter_test.compute_iterators();
+
+    std::vector<uint32_t> expected = {20, 40, 60, 80};
+    for (auto const& id: expected) {
+        ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+        ASSERT_EQ(id, iter_test.seq_id);
+        iter_test.next();
+    }
+    ASSERT_EQ(filter_result_iterator_t::invalid, iter_test.validity);
+
+    // A chain with a reference filter nested in one of its operands is left as it is.
+    filter_node_t* reference_root = nullptr;
+    filter_op = filter::parse_filter_query("(title: running || $Collection(in_stock: true)) && brand:= Nike",
+                                           coll->get_schema(), store, doc_id_prefix, reference_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> reference_root_guard(reference_root);
+
+    filter_result_iterator_t::reorder_filter_tree(coll->_get_index(), reference_root);
+    ASSERT_TRUE(reference_root->left->isOperator);
+    ASSERT_EQ("brand", reference_root->right->filter_exp.field_name);
+
+    std::map<std::string, std::string> req_params = {
+            {"collection", "Collection"},
+            {"q", "*"},
+            {"filter_by", "points: >= 0 && id: [7, 8]"},
+            {"explain", "true"}
+    };
+    nlohmann::json embedded_params;
+    std::string json_res;
+    auto now_ts = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+    auto search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+
+    auto res_obj = nlohmann::json::parse(json_res);
+    ASSERT_EQ(2, res_obj["found"].get<size_t>());
+
+    auto const& plan = res_obj["explain"]["filter_by"];
+    ASSERT_EQ("&&", plan["operator"]);
+    ASSERT_EQ("materialize", plan["strategy"]);
+    ASSERT_EQ(2, plan["children"].size());
+    ASSERT_EQ("id: [7, 8]", plan["children"][0]["filter"]);
+    ASSERT_EQ(2, plan["children"][0]["estimated_ids"]);
+    ASSERT_EQ("points: >= 0", plan["children"][1]["filter"]);
+
+    req_params.erase("explain");
+    search_op = collectionManager.do_search(req_params, embedded_params, json_res, now_ts);
+    ASSERT_TRUE(search_op.ok());
+    ASSERT_EQ(0, nlohmann::json::parse(json_res).count("explain"));
+}
+
+TEST_F(FilterTest, DenseFilterResult) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "points", "type": "int32"},
+                    {"name": "in_stock", "type": "bool"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 200; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["points"] = (int32_t) i;
+        doc["in_stock"] = i % 2 == 0;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    filter_node_t* filter_tree_root = nullptr;
+
+    Option<bool> filter_op = filter::parse_filter_query("in_stock: true", coll->get_schema(), store, doc_id_prefix,
+                                                        filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    iter_test.compute_iterators();
+    ASSERT_TRUE(iter_test._get_is_dense_result());
+
+    ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+    ASSERT_EQ(0, iter_test.seq_id);
+    iter_test.next();
+    ASSERT_EQ(2, iter_test.seq_id);
+
+    ASSERT_EQ(1, iter_test.is_valid(100));
+    ASSERT_EQ(100, iter_test.seq_id);
+    ASSERT_EQ(0, iter_test.is_valid(101));
+    ASSERT_EQ(102, iter_test.seq_id);
+    ASSERT_EQ(-1, iter_test.is_valid(199));
+    ASSERT_EQ(filter_result_iterator_t::invalid, iter_test.validity);
+
+    iter_test.reset();
+    ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+    ASSERT_EQ(0, iter_test.seq_id);
+
+    std::vector<uint32_t> ids = {1, 2, 3, 150, 151, 300};
+    uint32_t* and_result = nullptr;
+    ASSERT_EQ(2, iter_test.and_scalar(ids.data(), ids.size(), and_result));
+    ASSERT_EQ(2, and_result[0]);
+    ASSERT_EQ(150, and_result[1]);
+    delete [] and_result;
+
+    // Excluded ids are skipped while collecting ids.
+    std::vector<uint32_t> excluded_ids = {2, 4};
+    uint32_t excluded_result_index = 0;
+    auto result = new filter_result_t();
+    std::unique_ptr<filter_result_t> result_guard(result);
+    iter_test.get_n_ids(3, excluded_result_index, excluded_ids.data(), excluded_ids.size(), result);
+    ASSERT_EQ(3, result->count);
+    ASSERT_EQ(0, result->docs[0]);
+    ASSERT_EQ(6, result->docs[1]);
+    ASSERT_EQ(8, result->docs[2]);
+    ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+    ASSERT_EQ(10, iter_test.seq_id);
+
+    uint32_t* filter_ids = nullptr;
+    ASSERT_EQ(100, iter_test.to_filter_id_array(filter_ids));
+    for (uint32_t i = 0; i < 100; i++) {
+        ASSERT_EQ(i * 2, filter_ids[i]);
+    }
+    delete [] filter_ids;
+
+    // Two dense operands are combined as bitsets, a sparse result is held as an array.
+    std::map<std::string, uint32_t> expected_counts = {
+            {"in_stock: true && points: < 150", 75},
+            {"in_stock: true || points: < 150", 175},
+            {"in_stock: true && points: < 10", 5}
+    };
+    for (auto const& expected_count: expected_counts) {
+        filter_tree_root = nullptr;
+        filter_op = filter::parse_filter_query(expected_count.first, coll->get_schema(), store, doc_id_prefix,
+                                               filter_tree_root);
+        ASSERT_TRUE(filter_op.ok());
+        filter_tree_root_guard.reset(filter_tree_root);
+
+        auto iter = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+        ASSERT_TRUE(iter.init_status().ok());
+        iter.compute_iterators();
+        ASSERT_EQ(expected_count.second >= dense_filter_result_min_ids, iter._get_is_dense_result());
+
+        uint32_t count = 0;
+        for (uint32_t id = 0; id < 200; id++) {
+            auto const is_match = expected_count.first.find("&&") != std::string::npos ?
+                                  (id % 2 == 0 && id < (expected_count.second == 5 ? 10 : 150)) :
+                                  (id % 2 == 0 || id < 150);
+            if (!is_match) {
+                continue;
+            }
+
+            ASSERT_EQ(filter_result_iterator_t::valid, iter.validity);
+            ASSERT_EQ(id, iter.seq_id);
+            iter.next();
+            count++;
+        }
+        ASSERT_EQ(expected_count.second, count);
+        ASSERT_EQ(filter_result_iterator_t::invalid, iter.validity);
+    }
+}
+
+TEST_F(FilterTest, InListFilter) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "product_id", "type": "string"},
+                    {"name": "tags", "type": "string[]"},
+                    {"name": "points", "type": "int32"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 300; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["product_id"] = "p" + std::to_string(i);
+        doc["tags"] = {"size " + std::to_string(i % 10), "color " + std::to_string(i % 7)};
+        doc["points"] = (int32_t) i;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+
+    // Values are deduplicated, unknown values are skipped and the ids of the values are merged.
+    std::string product_ids, doc_ids, points;
+    std::vector<uint32_t> expected_ids;
+    for (size_t i = 0; i < 300; i += 3) {
+        product_ids += "p" + std::to_string(i) + ", ";
+        doc_ids += std::to_string(i) + ", ";
+        points += std::to_string(i) + ", ";
+        expected_ids.push_back(i);
+    }
+    product_ids += "P0, p3, unknown";
+    doc_ids += "0, 3, unknown";
+    points += "0, 3, 1000";
+
+    std::vector<std::string> filter_queries = {
+            "product_id: [" + product_ids + "]",
+            "product_id:= [" + product_ids + "]",
+            "id: [" + doc_ids + "]",
+            "points: [" + points + "]"
+    };
+
+    for (auto const& filter_query: filter_queries) {
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> filter_op = filter::parse_filter_query(filter_query, coll->get_schema(), store, doc_id_prefix,
+                                                            filter_tree_root);
+        ASSERT_TRUE(filter_op.ok());
+        std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+        auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+        ASSERT_TRUE(iter_test.init_status().ok());
+        iter_test.compute_iterators();
+
+        uint32_t* filter_ids = nullptr;
+        auto const filter_ids_length = iter_test.to_filter_id_array(filter_ids);
+        std::unique_ptr<uint32_t[]> filter_ids_guard(filter_ids);
+
+        ASSERT_EQ(expected_ids, std::vector<uint32_t>(filter_ids, filter_ids + filter_ids_length)) << filter_query;
+    }
+
+    // Values that repeat tokens of each other are matched as a whole.
+    filter_node_t* filter_tree_root = nullptr;
+    Option<bool> filter_op = filter::parse_filter_query("tags:= [size 1, size 2, color 1, `size 1`]",
+                                                        coll->get_schema(), store, doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    iter_test.compute_iterators();
+
+    uint32_t count = 0;
+    for (uint32_t id = 0; id < 300; id++) {
+        if (id % 10 != 1 && id % 10 != 2 && id % 7 != 1) {
+            continue;
+        }
+
+        ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+        ASSERT_EQ(id, iter_test.seq_id);
+        iter_test.next();
+        count++;
+    }
+    ASSERT_EQ(filter_result_iterator_t::invalid, iter_test.validity);
+    ASSERT_LT(0, count);
+}
+
+TEST_F(FilterTest, VectorFilterFunctorProbesLazily) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "points", "type": "int32"},
+                    {"name": "in_stock", "type": "bool"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 50; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["points"] = (int32_t) i;
+        doc["in_stock"] = i % 3 == 0;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    filter_node_t* filter_tree_root = nullptr;
+    Option<bool> filter_op = filter::parse_filter_query("points: >= 10 && in_stock: true", coll->get_schema(), store,
+                                                        doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, true);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    ASSERT_FALSE(iter_test._get_is_filter_result_initialized());
+
+    std::vector<uint32_t> excluded_ids = {30};
+    VectorFilterFunctor filter_functor(&iter_test, excluded_ids.data(), excluded_ids.size());
+
+    // Ids are probed in no particular order, as HNSW visits them.
+    std::vector<std::pair<uint32_t, bool>> probes = {{12, true}, {45, true}, {13, false}, {9, false}, {30, false},
+                                                     {48, true}, {15, true}, {49, false}, {12, true}};
+    for (auto const& probe: probes) {
+        ASSERT_EQ(probe.second, filter_functor(probe.first)) << probe.first;
+    }
+
+    ASSERT_FALSE(iter_test._get_is_filter_result_initialized());
+}
+
+TEST_F(FilterTest, PrefixSuffixFilter) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "sku", "type": "string", "infix": true},
+                    {"name": "tags", "type": "string[]"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> records = {
+            {"shoe1001red", {"summer", "sale"}},
+            {"shoe1002blue", {"summit"}},
+            {"boot2001red", {"winter"}},
+            {"sandal3001green", {"sumo", "sale"}},
+            {"shoe1003green", {"autumn"}},
+    };
+
+    for (size_t i = 0; i < records.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["sku"] = records[i].first;
+        doc["tags"] = records[i].second;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+
+    std::map<std::string, std::vector<uint32_t>> expected = {
+            {"sku:^= shoe", {0, 1, 4}},
+            {"sku:$= red", {0, 2}},
+            {"sku:$= [green, blue]", {1, 3, 4}},
+            {"tags:^= sum", {0, 1, 3}},
+            {"tags:^= [win, aut]", {2, 4}},
+            {"tags:^= [sum, su]", {0, 1, 3}},
+            {"tags:^= xyz", {}},
+            {"sku:^= shoe && tags:^= sum", {0, 1}},
+    };
+
+    for (auto const& item: expected) {
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> filter_op = filter::parse_filter_query(item.first, coll->get_schema(), store, doc_id_prefix,
+                                                            filter_tree_root);
+        ASSERT_TRUE(filter_op.ok()) << item.first;
+        std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+        auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+        ASSERT_TRUE(iter_test.init_status().ok()) << item.first;
+
+        std::vector<uint32_t> ids;
+        while (iter_test.validity == filter_result_iterator_t::valid) {
+            ids.push_back(iter_test.seq_id);
+            iter_test.next();
+        }
+        ASSERT_EQ(item.second, ids) << item.first;
+    }
+
+    // A suffix filter needs the infix index and a pattern has to be a single token.
+    std::map<std::string, std::string> errors = {
+            {"tags:$= mer", "Error with filter field `tags`: Suffix filters need the infix index of the field. "
+                            "Make sure to enable it by specifying `infix: true` in the schema."},
+            {"tags:^= sum mer", "Error with filter field `tags`: The value `sum mer` of a prefix or suffix filter "
+                                  "must be a single token."},
+            {"tags:^= s", "Error with filter field `tags`: The prefix `s` matches more than 3 tokens. "
+                          "Use a longer prefix."},
+    };
+
+    for (auto const& item: errors) {
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> filter_op = filter::parse_filter_query(item.first, coll->get_schema(), store, doc_id_prefix,
+                                                            filter_tree_root);
+        ASSERT_TRUE(filter_op.ok()) << item.first;
+        std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+        auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root);
+        ASSERT_FALSE(iter_test.init_status().ok());
+        ASSERT_EQ(item.second, iter_test.init_status().error());
+    }
+
+    // The tokens a lazily evaluated filter expands into are OR-ed when there are few of them, otherwise the ids are
+    // materialized.
+    std::map<std::string, bool> is_materialized = {
+            {"tags:^= [sum, aut]", false},
+            {"tags:^= [sum, su]", true},
+    };
+
+    for (auto const& item: is_materialized) {
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> filter_op = filter::parse_filter_query(item.first, coll->get_schema(), store, doc_id_prefix,
+                                                            filter_tree_root);
+        ASSERT_TRUE(filter_op.ok()) << item.first;
+        std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+        auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, true);
+        ASSERT_TRUE(iter_test.init_status().ok()) << item.first;
+        ASSERT_EQ(item.second, iter_test._get_is_filter_result_initialized()) << item.first;
+        ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+        ASSERT_EQ(0, iter_test.seq_id);
+    }
+}
+
+TEST_F(FilterTest, FilterProfile) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "tags", "type": "string[]"},
+                    {"name": "points", "type": "int32"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 100; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["tags"] = {"tag " + std::to_string(i % 10)};
+        doc["points"] = (int32_t) i;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+
+    filter_node_t* filter_tree_root = nullptr;
+    Option<bool> filter_op = filter::parse_filter_query("tags: `tag 1` || points: <20", coll->get_schema(), store,
+                                                        doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    filter_profile_t profile;
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, false,
+                                              DEFAULT_FILTER_BY_CANDIDATES, 0, UINT64_MAX, true, nullptr, nullptr,
+                                              &profile);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    iter_test.compute_iterators();
+
+    // Only the clauses are profiled, their result sizes are recorded before the subtrees are dropped.
+    ASSERT_EQ(2, profile.clauses.size());
+    ASSERT_EQ("tags: `tag 1`", profile.clauses[0].filter);
+    ASSERT_EQ(10, profile.clauses[0].num_ids);
+    ASSERT_TRUE(profile.clauses[0].is_materialized);
+    ASSERT_EQ("points: <20", profile.clauses[1].filter);
+    ASSERT_EQ(20, profile.clauses[1].num_ids);
+    ASSERT_FALSE(profile.clauses[1].search_cutoff);
+
+    auto profile_json = profile.to_json();
+    ASSERT_EQ(2, profile_json.size());
+    ASSERT_EQ("materialize", profile_json[0]["strategy"]);
+    ASSERT_EQ(10, profile_json[0]["num_ids"]);
+}
+
+TEST_F(FilterTest, FilterContinuations) {
+    filter_continuations_t continuations;
+
+    // The first continuation holds on to the worker until it is released.
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto blocked_op = continuations.add("coll", "points: >0", [released]() {
+        released.wait();
+        return Option<uint32_t>(7);
+    });
+    ASSERT_TRUE(blocked_op.ok());
+
+    auto id_op = continuations.add("coll", "points: >10", []() { return Option<uint32_t>(42); });
+    auto failed_id_op = continuations.add("coll", "points: >", []() { return Option<uint32_t>(400, "Bad filter."); });
+    ASSERT_TRUE(id_op.ok());
+    ASSERT_TRUE(failed_id_op.ok());
+
+    // the queue is bounded
+    for (size_t i = 3; i < filter_continuations_t::MAX_PENDING; i++) {
+        ASSERT_TRUE(continuations.add("coll", "points: >10", []() { return Option<uint32_t>(42); }).ok());
+    }
+
+    auto rejected_op = continuations.add("coll", "points: >10", []() { return Option<uint32_t>(42); });
+    ASSERT_FALSE(rejected_op.ok());
+    ASSERT_EQ(429, rejected_op.code());
+
+    nlohmann::json status;
+    ASSERT_TRUE(continuations.get("coll", id_op.get(), status));
+    ASSERT_EQ("pending", status["status"]);
+
+    release.set_value();
+    for (size_t i = 0; i < 500 && status["status"] == "pending"; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        status.clear();
+        ASSERT_TRUE(continuations.get("coll", failed_id_op.get(), status));
+    }
+
+    ASSERT_EQ("failed", status["status"]);
+    ASSERT_EQ("Bad filter.", status["error"]);
+
+    status.clear();
+    ASSERT_TRUE(continuations.get("coll", id_op.get(), status));
+    ASSERT_EQ("completed", status["status"]);
+    ASSERT_EQ(42, status["found"]);
+    ASSERT_EQ("points: >10", status["filter_by"]);
+
+    // continuations are only visible to their own collection
+    ASSERT_FALSE(continuations.get("other", id_op.get(), status));
+    ASSERT_FALSE(continuations.get("coll", blocked_op.get() + filter_continuations_t::MAX_PENDING, status));
+
+    continuations.shutdown();
+    auto stopped_op = continuations.add("coll", "points: >10", []() { return Option<uint32_t>(42); });
+    ASSERT_FALSE(stopped_op.ok());
+    ASSERT_EQ(503, stopped_op.code());
+}
+
+TEST_F(FilterTest, ComplementIterator) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "points", "type": "int32"}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    for (size_t i = 0; i < 100; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["points"] = (int32_t) i;
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+
+    filter_node_t* filter_tree_root = nullptr;
+    Option<bool> filter_op = filter::parse_filter_query("id: != [0, 5, 6, 99, 7]", coll->get_schema(), store,
+                                                        doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    std::vector<uint32_t> expected_ids;
+    for (uint32_t id = 0; id < 100; id++) {
+        if (id != 0 && id != 5 && id != 6 && id != 7 && id != 99) {
+            expected_ids.push_back(id);
+        }
+    }
+
+    // The excluded ids are skipped while iterating, instead of materializing the rest of the collection.
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, true);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    ASSERT_FALSE(iter_test._get_is_filter_result_initialized());
+    ASSERT_EQ(95, iter_test.approx_filter_ids_length);
+
+    std::vector<uint32_t> ids;
+    while (iter_test.validity == filter_result_iterator_t::valid) {
+        ids.push_back(iter_test.seq_id);
+        iter_test.next();
+    }
+    ASSERT_EQ(expected_ids, ids);
+
+    iter_test.reset();
+    ASSERT_EQ(filter_result_iterator_t::valid, iter_test.validity);
+    ASSERT_EQ(1, iter_test.seq_id);
+
+    ASSERT_EQ(0, iter_test.is_valid(5));
+    ASSERT_EQ(8, iter_test.seq_id);
+
+    ASSERT_EQ(1, iter_test.is_valid(10));
+    ASSERT_EQ(-1, iter_test.is_valid(99));
+    ASSERT_EQ(filter_result_iterator_t::invalid, iter_test.validity);
+
+    iter_test.reset();
+    uint32_t* and_ids = nullptr;
+    std::vector<uint32_t> probe_ids = {0, 3, 6, 50, 99};
+    auto const and_ids_length = iter_test.and_scalar(probe_ids.data(), probe_ids.size(), and_ids);
+    std::unique_ptr<uint32_t[]> and_ids_guard(and_ids);
+    ASSERT_EQ(std::vector<uint32_t>({3, 50}), std::vector<uint32_t>(and_ids, and_ids + and_ids_length));
+
+    // The complement is only materialized when the ids are computed.
+    iter_test.compute_iterators();
+    ASSERT_TRUE(iter_test._get_is_filter_result_initialized());
+
+    uint32_t* filter_ids = nullptr;
+    auto const filter_ids_length = iter_test.to_filter_id_array(filter_ids);
+    std::unique_ptr<uint32_t[]> filter_ids_guard(filter_ids);
+    ASSERT_EQ(expected_ids, std::vector<uint32_t>(filter_ids, filter_ids + filter_ids_length));
+}
+
+TEST_F(FilterTest, NegatedJoinComplementIterator) {
+    auto schema_json =
+            R"({
+                "name": "books",
+                "fields": [
+                    {"name": "title", "type": "string"},
+                    {"name": "author_id", "type": "string", "reference": "authors.id", "async_reference": true}
+                ]
+            })"_json;
+    auto books_coll = collectionManager.create_collection(schema_json).get();
+
+    std::vector<std::string> author_ids = {"0", "1", "1", "3"};
+    for (size_t i = 0; i < author_ids.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["title"] = "Title " + std::to_string(i);
+        doc["author_id"] = author_ids[i];
+        ASSERT_TRUE(books_coll->add(doc.dump()).ok());
+    }
+
+    schema_json =
+            R"({
+                "name": "authors",
+                "fields": [
+                    {"name": "name", "type": "string"}
+                ]
+            })"_json;
+    auto coll = collectionManager.create_collection(schema_json).get();
+
+    for (size_t i = 0; i < 5; i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["name"] = "Author " + std::to_string(i);
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+
+    filter_node_t* filter_tree_root = nullptr;
+    Option<bool> filter_op = filter::parse_filter_query("!$books(author_id: 1)", coll->get_schema(), store,
+                                                        doc_id_prefix, filter_tree_root);
+    ASSERT_TRUE(filter_op.ok());
+    std::unique_ptr<filter_node_t> filter_tree_root_guard(filter_tree_root);
+
+    auto get_references = [](const filter_result_iterator_t& it) {
+        auto const ref_it = it.reference.find("books");
+        return ref_it == it.reference.end() ? std::vector<uint32_t>() :
+               std::vector<uint32_t>(ref_it->second.docs, ref_it->second.docs + ref_it->second.count);
+    };
+
+    auto get_ids_and_references = [&](filter_result_iterator_t& it) {
+        std::map<uint32_t, std::vector<uint32_t>> ids_and_references;
+        while (it.validity == filter_result_iterator_t::valid) {
+            ids_and_references[it.seq_id] = get_references(it);
+            it.next();
+        }
+        return ids_and_references;
+    };
+
+    // Every author except the one with a matching book, where only the authors of the other books have references.
+    std::map<uint32_t, std::vector<uint32_t>> expected = {{0, {0}}, {2, {}}, {3, {3}}, {4, {}}};
+
+    auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, true);
+    ASSERT_TRUE(iter_test.init_status().ok());
+    ASSERT_FALSE(iter_test._get_is_filter_result_initialized());
+    ASSERT_EQ(expected, get_ids_and_references(iter_test));
+
+    iter_test.reset();
+    ASSERT_EQ(0, iter_test.is_valid(1));
+    ASSERT_EQ(2, iter_test.seq_id);
+    ASSERT_TRUE(get_references(iter_test).empty());
+
+    ASSERT_EQ(1, iter_test.is_valid(3));
+    ASSERT_EQ(std::vector<uint32_t>{3}, get_references(iter_test));
+    ASSERT_EQ(-1, iter_test.is_valid(5));
+    ASSERT_EQ(filter_result_iterator_t::invalid, iter_test.validity);
+
+    // The materialized complement has the same ids and references as the eagerly evaluated filter.
+    iter_test.reset();
+    iter_test.compute_iterators();
+    ASSERT_TRUE(iter_test._get_is_filter_result_initialized());
+    ASSERT_EQ(expected, get_ids_and_references(iter_test));
+
+    auto eager_iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, false);
+    ASSERT_TRUE(eager_iter_test.init_status().ok());
+    ASSERT_TRUE(eager_iter_test._get_is_filter_result_initialized());
+    ASSERT_EQ(expected, get_ids_and_references(eager_iter_test));
+}
+
+TEST_F(FilterTest, NumericArrayMinMaxAfterUpdateAndDelete) {
+    nlohmann::json schema =
+            R"({
+                "name": "Collection",
+                "fields": [
+                    {"name": "values", "type": "int32[]", "sort": true}
+                ]
+            })"_json;
+
+    Collection* coll = collectionManager.create_collection(schema).get();
+
+    std::vector<std::vector<int32_t>> values = {{1, 10}, {5}, {2, 8}};
+    for (size_t i = 0; i < values.size(); i++) {
+        nlohmann::json doc;
+        doc["id"] = std::to_string(i);
+        doc["values"] = values[i];
+        ASSERT_TRUE(coll->add(doc.dump()).ok());
+    }
+
+    // Neither the old values of an updated document nor the values of a deleted one may stay in the bounds.
+    ASSERT_TRUE(coll->add(R"({"id": "0", "values": [20]})"_json.dump(), UPDATE).ok());
+    ASSERT_TRUE(coll->remove("2").ok());
+
+    const std::string doc_id_prefix = std::to_string(coll->get_collection_id()) + "_" + Collection::DOC_ID_PREFIX + "_";
+    const std::vector<uint32_t> probe_ids = {0, 1, 2};
+
+    std::vector<std::string> filters = {"values: [1..3]", "values: >= 9", "values: [4..6]"};
+    std::vector<std::vector<uint32_t>> expected = {{}, {0}, {1}};
+
+    for (size_t i = 0; i < filters.size(); i++) {
+        filter_node_t* filter_tree_root = nullptr;
+        Option<bool> filter_op = filter::parse_filter_query(filters[i], coll->get_schema(), store, doc_id_prefix,
+                                                            filter_tree_root);
+        ASSERT_TRUE(filter_op.ok());
+
+        auto iter_test = filter_result_iterator_t(coll->get_name(), coll->_get_index(), filter_tree_root, true);
+        ASSERT_TRUE(iter_test.init_status().ok());
+
+        filter_result_t result;
+        iter_test.and_scalar(probe_ids.data(), probe_ids.size(), result);
+
+        ASSERT_EQ(expected[i], std::vector<uint32_t>(result.docs, result.docs + result.count)) << filters[i];
+        delete filter_tree_root;
+    }
+
+    std::vector<sort_by> sort_fields = {sort_by("values", "asc")};
+    auto results = coll->search("*", {}, "", {}, sort_fields, {0}).get();
+    ASSERT_EQ(2, results["found"].get<size_t>());
+    ASSERT_EQ("1", results["hits"][0]["document"]["id"]);
+    ASSERT_EQ("0", results["hits"][1]["document"]["id"]);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <map>
+#include <set>
+#include "filtered_facet_counts.h"
+
+TEST(FilteredFacetCountsTest, AddRemoveIds) {
+    filtered_facet_counts_t counts;
+
+    ASSERT_FALSE(counts.contains(10));
+    ASSERT_FALSE(counts.remove(10));
+
+    ASSERT_TRUE(counts.add(10));
+    ASSERT_FALSE(counts.add(10));
+    ASSERT_TRUE(counts.add(1000));
+    ASSERT_EQ(2, counts.size());
+
+    ASSERT_TRUE(counts.contains(10));
+    ASSERT_FALSE(counts.contains(11));
+
+    ASSERT_TRUE(counts.remove(10));
+    ASSERT_FALSE(counts.contains(10));
+    ASSERT_EQ(1, counts.size());
+}
+
+TEST(FilteredFacetCountsTest, TopCounts) {
+    filtered_facet_counts_t counts;
+
+    std::vector<uint32_t> doc1 = {100, 200};
+    std::vector<uint32_t> doc2 = {200, 300};
+    std::vector<uint32_t> doc3 = {200};
+
+    counts.add_facet_ids("tags", doc1.data(), doc1.size());
+    counts.add_facet_ids("tags", doc2.data(), doc2.size());
+    counts.add_facet_ids("tags", doc3.data(), doc3.size());
+
+    std::vector<std::pair<uint32_t, uint32_t>> top_counts;
+    counts.get_top_counts("tags", 2, top_counts);
+
+    // ties are broken by facet id
+    ASSERT_EQ(2, top_counts.size());
+    ASSERT_EQ(200, top_counts[0].first);
+    ASSERT_EQ(3, top_counts[0].second);
+    ASSERT_EQ(100, top_counts[1].first);
+    ASSERT_EQ(1, top_counts[1].second);
+
+    counts.remove_facet_ids("tags", doc1.data(), doc1.size());
+    ASSERT_EQ(0, counts.get_count("tags", 100));
+    ASSERT_EQ(2, counts.get_count("tags", 200));
+
+    top_counts.clear();
+    counts.get_top_counts("tags", 10, top_counts);
+    ASSERT_EQ(2, top_counts.size());
+
+    // values of unknown fields and values are ignored
+    std::vector<uint32_t> unknown = {999};
+    counts.remove_facet_ids("brand", doc3.data(), doc3.size());
+    counts.remove_facet_ids("tags", unknown.data(), unknown.size());
+    ASSERT_EQ(2, counts.get_count("tags", 200));
+
+    counts.erase_field("tags");
+    top_counts.clear();
+    counts.get_top_counts("tags", 10, top_counts);
+    ASSERT_TRUE(top_counts.empty());
+}
+
+TEST(FilteredFacetCountsTest, RandomOperations) {
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<uint32_t> value_distr(0, 20);
+
+    filtered_facet_counts_t counts;
+    std::map<uint32_t, std::vector<uint32_t>> docs;
+    std::map<uint32_t, uint32_t> expected;
+
+    for (size_t i = 0; i < 5000; i++) {
+        const uint32_t seq_id = gen() % 300;
+        const auto doc_it = docs.find(seq_id);
+
+        if (doc_it != docs.end()) {
+            ASSERT_TRUE(counts.remove(seq_id));
+            counts.remove_facet_ids("f", doc_it->second.data(), doc_it->second.size());
+            for (const auto facet_id: doc_it->second) {
+                expected[facet_id]--;
+            }
+            docs.erase(doc_it);
+            continue;
+        }
+
+        std::set<uint32_t> values = {value_distr(gen), value_distr(gen)};
+        std::vector<uint32_t> facet_ids(values.begin(), values.end());
+
+        ASSERT_TRUE(counts.add(seq_id));
+        counts.add_facet_ids("f", facet_ids.data(), facet_ids.size());
+        for (const auto facet_id: facet_ids) {
+            expected[facet_id]++;
+        }
+        docs.emplace(seq_id, facet_ids);
+    }
+
+    ASSERT_EQ(docs.size(), counts.size());
+
+    std::vector<std::pair<uint32_t, uint32_t>> top_counts;
+    counts.get_top_counts("f", SIZE_MAX, top_counts);
+
+    size_t num_values = 0;
+    for (const auto& kv: expected) {
+        ASSERT_EQ(kv.second, counts.get_count("f", kv.first));
+        num_values += (kv.second != 0);
+    }
+
+    ASSERT_EQ(num_values, top_counts.size());
+    for (size_t i = 1; i < top_counts.size(); i++) {
+        ASSERT_GE(top_counts[i - 1].second, top_counts[i].second);
+    }
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include "float_column.h"
+
+namespace {
+    // reference encoding used by the int64 keyed numeric indices
+    int64_t float_to_int64_t(float f) {
+        int32_t i;
+        memcpy(&i, &f, sizeof i);
+        if (i < 0) {
+            i ^= INT32_MAX;
+        }
+        return i;
+    }
+}
+
+TEST(FloatColumnTest, KeyMatchesInt64Encoding) {
+    std::vector<float> values = {0.0f, -0.0f, 1.0f, -1.0f, 1.5f, -1.5f, 1e-38f, -1e-38f, 3.4e38f, -3.4e38f,
+                                 INFINITY, -INFINITY, std::numeric_limits<float>::denorm_min(), 123.456f};
+
+    for (const auto value: values) {
+        ASSERT_EQ(float_to_int64_t(value), float_column_t::to_key(value));
+
+        const float decoded = float_column_t::from_key(float_column_t::to_key(value));
+        ASSERT_EQ(0, memcmp(&value, &decoded, sizeof value));
+    }
+
+    ASSERT_LT(float_column_t::to_key(-0.0f), float_column_t::to_key(0.0f));
+    ASSERT_LT(float_column_t::to_key(-1.5f), float_column_t::to_key(-1.0f));
+    ASSERT_LT(float_column_t::to_key(-INFINITY), float_column_t::to_key(-3.4e38f));
+}
+
+TEST(FloatColumnTest, SetGetRemove) {
+    float_column_t column;
+    float value;
+
+    ASSERT_FALSE(column.get(10, value));
+    column.remove(10);
+
+    column.set(10, 1.25f);
+    column.set(200, -3.5f);
+    ASSERT_EQ(2, column.size());
+
+    ASSERT_TRUE(column.get(10, value));
+    ASSERT_EQ(1.25f, value);
+    ASSERT_TRUE(column.get(200, value));
+    ASSERT_EQ(-3.5f, value);
+    ASSERT_FALSE(column.contains(11));
+
+    // a value of zero is distinct from a missing value
+    column.set(11, 0.0f);
+    ASSERT_TRUE(column.contains(11));
+
+    column.set(10, 2.0f);
+    ASSERT_EQ(3, column.size());
+
+    column.remove(10);
+    ASSERT_FALSE(column.contains(10));
+    ASSERT_EQ(2, column.size());
+
+    std::vector<uint32_t> ids;
+    column.range_search(INT32_MIN, INT32_MAX, ids);
+    ASSERT_EQ(std::vector<uint32_t>({11, 200}), ids);
+}
+
+TEST(FloatColumnTest, RangeSearchMatchesScalarComparison) {
+    std::mt19937 gen(1337);
+    std::uniform_real_distribution<float> distr(-100, 100);
+
+    float_column_t column;
+    std::vector<std::pair<uint32_t, float>> records;
+
+    for (uint32_t id = 0; id < 5000; id++) {
+        if (id % 7 == 0) {
+            continue;
+        }
+
+        float value = (id % 11 == 0) ? -0.0f : (id % 13 == 0) ? 0.0f : distr(gen);
+        column.set(id, value);
+        records.emplace_back(id, value);
+    }
+
+    std::vector<std::pair<float, float>> ranges = {{-10, 10}, {-0.0f, -0.0f}, {0.0f, 0.0f}, {-100, -99},
+                                                   {50, 25}, {-INFINITY, INFINITY}};
+
+    for (const auto& range: ranges) {
+        const auto start_key = float_column_t::to_key(range.first);
+        const auto end_key = float_column_t::to_key(range.second);
+
+        std::vector<uint32_t> expected;
+        for (const auto& record: records) {
+            const auto key = float_to_int64_t(record.second);
+            if (key >= start_key && key <= end_key) {
+                expected.push_back(record.first);
+            }
+        }
+
+        std::vector<uint32_t> ids;
+        column.range_search(start_key, end_key, ids);
+        ASSERT_EQ(expected, ids);
+    }
+}
+
+TEST(FloatColumnTest, MinMaxOfIds) {
+    float_column_t column;
+    column.set(1, 5.5f);
+    column.set(2, -0.0f);
+    column.set(3, 0.0f);
+    column.set(4, -7.25f);
+
+    float min, max;
+    std::vector<uint32_t> ids = {0, 2, 3, 9};
+    ASSERT_TRUE(column.get_min_max(ids.data(), ids.size(), min, max));
+    ASSERT_TRUE(std::signbit(min));
+    ASSERT_EQ(0.0f, min);
+    ASSERT_FALSE(std::signbit(max));
+
+    ids = {1, 2, 3, 4};
+    ASSERT_TRUE(column.get_min_max(ids.data(), ids.size(), min, max));
+    ASSERT_EQ(-7.25f, min);
+    ASSERT_EQ(5.5f, max);
+
+    ids = {0, 5, 100};
+    ASSERT_FALSE(column.get_min_max(ids.data(), ids.size(), min, max));
+}
+
+TEST(FloatColumnTest, StatsOfIds) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> distr(-1000, 1000);
+
+    float_column_t column;
+    std::vector<uint32_t> ids;
+
+    for (uint32_t id = 0; id < 1003; id++) {
+        if (id % 5 != 0) {
+            column.set(id, (id % 97 == 0) ? -0.0f : distr(gen));
+        }
+
+        if (id % 3 != 0) {
+            ids.push_back(id);
+        }
+    }
+
+    float min, max, expected_min, expected_max;
+    double sum;
+    size_t count;
+
+    ASSERT_TRUE(column.get_stats(ids.data(), ids.size(), min, max, sum, count));
+    ASSERT_TRUE(column.get_min_max(ids.data(), ids.size(), expected_min, expected_max));
+    ASSERT_EQ(0, memcmp(&expected_min, &min, sizeof min));
+    ASSERT_EQ(0, memcmp(&expected_max, &max, sizeof max));
+
+    double expected_sum = 0;
+    size_t expected_count = 0;
+    for (const auto id: ids) {
+        float value;
+        if (column.get(id, value)) {
+            expected_sum += value;
+            expected_count++;
+        }
+    }
+
+    ASSERT_EQ(expected_count, count);
+    ASSERT_NEAR(expected_sum, sum, 1e-6 * std::abs(expected_sum) + 1e-3);
+
+    // ids without values, fewer than a full group of four
+    ids = {0, 5, 10};
+    ASSERT_FALSE(column.get_stats(ids.data(), ids.size(), min, max, sum, count));
+
+    ids = {0, 1, 5, 10, 15, 20};
+    ASSERT_TRUE(column.get_stats(ids.data(), ids.size(), min, max, sum, count));
+    ASSERT_EQ(1, count);
+    ASSERT_EQ(min, max);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "id_bitset.h"
+
+TEST(IdBitsetTest, LookupAndIteration) {
+    std::vector<uint32_t> ids = {0, 3, 63, 64, 65, 200, 1000};
+    id_bitset_t bitset(ids.data(), ids.size());
+
+    ASSERT_EQ(7, bitset.size());
+    ASSERT_EQ(1000, bitset.last_id());
+    ASSERT_EQ(16 * sizeof(uint64_t), bitset.num_bytes());
+
+    for (const auto id: ids) {
+        ASSERT_TRUE(bitset.contains(id));
+    }
+    ASSERT_FALSE(bitset.contains(1));
+    ASSERT_FALSE(bitset.contains(62));
+    ASSERT_FALSE(bitset.contains(1001));
+    ASSERT_FALSE(bitset.contains(UINT32_MAX));
+
+    ASSERT_EQ(0, bitset.next(0));
+    ASSERT_EQ(3, bitset.next(1));
+    ASSERT_EQ(63, bitset.next(4));
+    ASSERT_EQ(200, bitset.next(66));
+    ASSERT_EQ(1000, bitset.next(201));
+    ASSERT_EQ(UINT32_MAX, bitset.next(1001));
+    ASSERT_EQ(UINT32_MAX, bitset.next(UINT32_MAX));
+
+    uint32_t* all_ids = nullptr;
+    ASSERT_EQ(7, bitset.to_ids(all_ids));
+    ASSERT_EQ(ids, std::vector<uint32_t>(all_ids, all_ids + 7));
+    delete [] all_ids;
+
+    std::vector<uint32_t> some_ids;
+    ASSERT_EQ(3, bitset.to_ids(4, 3, some_ids));
+    ASSERT_EQ(std::vector<uint32_t>({63, 64, 65}), some_ids);
+
+    std::vector<uint32_t> A = {2, 3, 64, 500, 1000, 5000};
+    uint32_t* results = nullptr;
+    ASSERT_EQ(3, bitset.and_scalar(A.data(), A.size(), results));
+    ASSERT_EQ(std::vector<uint32_t>({3, 64, 1000}), std::vector<uint32_t>(results, results + 3));
+    delete [] results;
+}
+
+TEST(IdBitsetTest, AndOrBitsets) {
+    std::vector<uint32_t> a_ids, b_ids;
+    for (uint32_t i = 0; i < 1000; i += 2) {
+        a_ids.push_back(i);
+    }
+    for (uint32_t i = 0; i < 700; i += 3) {
+        b_ids.push_back(i);
+    }
+
+    id_bitset_t a(a_ids.data(), a_ids.size()), b(b_ids.data(), b_ids.size());
+
+    id_bitset_t and_result;
+    id_bitset_t::and_bitsets(a, b, and_result);
+    ASSERT_EQ(117, and_result.size());
+    ASSERT_EQ(696, and_result.last_id());
+    for (uint32_t i = 0; i < 1000; i++) {
+        ASSERT_EQ(i % 6 == 0 && i < 700, and_result.contains(i));
+    }
+
+    id_bitset_t or_result;
+    id_bitset_t::or_bitsets(b, a, or_result);
+    ASSERT_EQ(500 + 234 - 117, or_result.size());
+    ASSERT_EQ(998, or_result.last_id());
+    for (uint32_t i = 0; i < 1000; i++) {
+        ASSERT_EQ(i % 2 == 0 || (i % 3 == 0 && i < 700), or_result.contains(i));
+    }
+
+    // trailing words left empty by the intersection are dropped
+    std::vector<uint32_t> c_ids = {1, 640};
+    id_bitset_t c(c_ids.data(), c_ids.size());
+    id_bitset_t::and_bitsets(a, c, and_result);
+    ASSERT_EQ(1, and_result.size());
+    ASSERT_EQ(640, and_result.last_id());
+
+    c_ids = {1, 3};
+    c = id_bitset_t(c_ids.data(), c_ids.size());
+    id_bitset_t::and_bitsets(a, c, and_result);
+    ASSERT_EQ(0, and_result.size());
+    ASSERT_EQ(0, and_result.num_bytes());
+    ASSERT_EQ(UINT32_MAX, and_result.next(0));
+
+    // 1 in 16 ids is the break even point of a 2x smaller bitset
+    ASSERT_TRUE(id_bitset_t::is_dense(4096, 65535, 1024, 2));
+    ASSERT_FALSE(id_bitset_t::is_dense(4095, 65535, 1024, 2));
+    ASSERT_FALSE(id_bitset_t::is_dense(100, 100, 1024, 2));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <algorithm>
+#include "min_max_column.h"
+
+TEST(MinMaxColumnTest, InsertGetRemove) {
+    min_max_column_t column;
+    int64_t min, max;
+
+    ASSERT_FALSE(column.get(10, min, max));
+    ASSERT_EQ(min_max_column_t::no_match, column.match_range(10, INT64_MIN, INT64_MAX));
+    column.remove(10);
+
+    column.insert(10, 5);
+    column.insert(10, -3);
+    column.insert(10, 2);
+    column.insert(4, 0);
+    ASSERT_EQ(2, column.size());
+
+    ASSERT_TRUE(column.get(10, min, max));
+    ASSERT_EQ(-3, min);
+    ASSERT_EQ(5, max);
+
+    ASSERT_TRUE(column.get(4, min, max));
+    ASSERT_EQ(0, min);
+    ASSERT_EQ(0, max);
+    ASSERT_FALSE(column.contains(5));
+
+    column.remove(10);
+    ASSERT_FALSE(column.contains(10));
+    ASSERT_EQ(1, column.size());
+
+    // bounds start afresh after removal
+    column.insert(10, 100);
+    ASSERT_TRUE(column.get(10, min, max));
+    ASSERT_EQ(100, min);
+    ASSERT_EQ(100, max);
+}
+
+TEST(MinMaxColumnTest, MatchRange) {
+    min_max_column_t column;
+    column.insert(1, 10);
+    column.insert(1, 20);
+
+    ASSERT_EQ(min_max_column_t::no_match, column.match_range(1, 0, 9));
+    ASSERT_EQ(min_max_column_t::no_match, column.match_range(1, 21, 30));
+    ASSERT_EQ(min_max_column_t::match, column.match_range(1, 0, 10));
+    ASSERT_EQ(min_max_column_t::match, column.match_range(1, 20, 30));
+    ASSERT_EQ(min_max_column_t::match, column.match_range(1, 5, 25));
+    ASSERT_EQ(min_max_column_t::maybe_match, column.match_range(1, 11, 19));
+    ASSERT_EQ(min_max_column_t::no_match, column.match_range(1, 20, 10));
+}
+
+TEST(MinMaxColumnTest, MatchRangeIsConsistentWithValues) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> value_distr(-1000, 1000);
+
+    min_max_column_t column;
+    std::vector<std::vector<int64_t>> doc_values(500);
+
+    for (uint32_t id = 0; id < doc_values.size(); id++) {
+        const size_t num_values = id % 5;
+        for (size_t i = 0; i < num_values; i++) {
+            doc_values[id].push_back(value_distr(gen));
+            column.insert(id, doc_values[id].back());
+        }
+    }
+
+    for (size_t i = 0; i < 200; i++) {
+        int64_t start = value_distr(gen), end = value_distr(gen);
+        if (start > end) {
+            std::swap(start, end);
+        }
+
+        for (uint32_t id = 0; id < doc_values.size(); id++) {
+            const bool any = std::any_of(doc_values[id].begin(), doc_values[id].end(), [&](int64_t value) {
+                return value >= start && value <= end;
+            });
+
+            const auto result = column.match_range(id, start, end);
+            if (result == min_max_column_t::no_match) {
+                ASSERT_FALSE(any);
+            } else if (result == min_max_column_t::match) {
+                ASSERT_TRUE(any);
+            }
+        }
+    }
+}
@@ -73,6 +73,24 @@ TEST(NumTreeTest, EraseFullList) {
     ASSERT_EQ(nullptr, ids);
 }
 
+TEST(NumTreeTest, ValueCounts) {
+    num_tree_t tree;
+    tree.insert(-1200, 0);
+    tree.insert(-1750, 1);
+    tree.insert(0, 2);
+    tree.insert(100, 3);
+    tree.insert(2000, 4);
+    tree.insert(-1200, 5);
+    tree.insert(100, 6);
+
+    std::vector<uint32_t> result_ids = {0, 3, 4, 5, 6};
+    std::vector<std::pair<int64_t, size_t>> value_counts;
+    tree.get_value_counts(result_ids.data(), result_ids.size(), value_counts);
+
+    std::vector<std::pair<int64_t, size_t>> expected = {{-1200, 2}, {100, 2}, {2000, 1}};
+    ASSERT_EQ(expected, value_counts);
+}
+
 TEST(NumTreeTest, Iterator) {
     num_tree_t compact_tree;
     compact_tree.insert(-1200, 0);
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "numeric_histogram.h"
+
+TEST(NumericHistogramTest, EmptyHistogram) {
+    numeric_histogram_t histogram;
+
+    ASSERT_TRUE(histogram.empty());
+    ASSERT_EQ(0, histogram.num_buckets());
+    ASSERT_EQ(0, histogram.approx_range_count(INT64_MIN, INT64_MAX));
+
+    histogram.remove(10);
+    ASSERT_EQ(0, histogram.size());
+}
+
+TEST(NumericHistogramTest, MinMaxSynopsis) {
+    numeric_histogram_t histogram;
+
+    for (int64_t i = -50; i <= 100; i++) {
+        histogram.insert(i);
+    }
+
+    ASSERT_EQ(151, histogram.size());
+    ASSERT_EQ(-50, histogram.min());
+    ASSERT_EQ(100, histogram.max());
+
+    // ranges outside of the value domain are empty
+    ASSERT_EQ(0, histogram.approx_range_count(101, INT64_MAX));
+    ASSERT_EQ(0, histogram.approx_range_count(INT64_MIN, -51));
+    ASSERT_EQ(0, histogram.approx_range_count(10, 5));
+
+    ASSERT_EQ(151, histogram.approx_range_count(INT64_MIN, INT64_MAX));
+    ASSERT_EQ(151, histogram.approx_range_count(-50, 100));
+}
+
+TEST(NumericHistogramTest, UniformDistributionEstimates) {
+    numeric_histogram_t histogram;
+
+    std::mt19937 gen(137723);
+    std::uniform_int_distribution<int64_t> distr(0, 9999);
+    for (size_t i = 0; i < 100000; i++) {
+        histogram.insert(distr(gen));
+    }
+
+    ASSERT_EQ(100000, histogram.size());
+    ASSERT_LE(histogram.num_buckets(), numeric_histogram_t::DEFAULT_MAX_BUCKETS);
+
+    // ~10% of the values
+    auto count = histogram.approx_range_count(0, 999);
+    ASSERT_NEAR(10000, count, 1000);
+
+    // ~50% of the values
+    count = histogram.approx_range_count(5000, INT64_MAX);
+    ASSERT_NEAR(50000, count, 2500);
+}
+
+TEST(NumericHistogramTest, SkewedDistributionEstimates) {
+    numeric_histogram_t histogram;
+
+    // a single hot value and a long tail
+    for (size_t i = 0; i < 50000; i++) {
+        histogram.insert(42);
+    }
+
+    for (int64_t i = 0; i < 50000; i++) {
+        histogram.insert(1000 + i);
+    }
+
+    ASSERT_NEAR(50000, histogram.approx_equals_count(42), 2500);
+    ASSERT_NEAR(1, histogram.approx_equals_count(30000), 10);
+    ASSERT_NEAR(25000, histogram.approx_range_count(1000, 25999), 2500);
+}
+
+TEST(NumericHistogramTest, Removal) {
+    numeric_histogram_t histogram;
+
+    for (int64_t i = 0; i < 10000; i++) {
+        histogram.insert(i);
+    }
+
+    for (int64_t i = 0; i < 5000; i++) {
+        histogram.remove(i);
+    }
+
+    ASSERT_EQ(5000, histogram.size());
+    ASSERT_NEAR(0, histogram.approx_range_count(0, 4999), 500);
+    ASSERT_NEAR(5000, histogram.approx_range_count(5000, 9999), 500);
+
+    for (int64_t i = 5000; i < 10000; i++) {
+        histogram.remove(i);
+    }
+
+    ASSERT_TRUE(histogram.empty());
+    ASSERT_EQ(0, histogram.num_buckets());
+    ASSERT_EQ(0, histogram.approx_range_count(INT64_MIN, INT64_MAX));
+}
+
+TEST(NumericHistogramTest, ExtremeValues) {
+    numeric_histogram_t histogram;
+
+    for (size_t i = 0; i < 1000; i++) {
+        histogram.insert(INT64_MIN);
+        histogram.insert(INT64_MAX);
+        histogram.insert(0);
+    }
+
+    ASSERT_EQ(3000, histogram.size());
+    ASSERT_EQ(INT64_MIN, histogram.min());
+    ASSERT_EQ(INT64_MAX, histogram.max());
+    ASSERT_EQ(3000, histogram.approx_range_count(INT64_MIN, INT64_MAX));
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "field.h"
+#include "filter.h"
+#include "object_filter.h"
+
+TEST(ObjectFilterTest, CompiledPredicate) {
+    tsl::htrie_map<char, field> search_schema;
+    search_schema.emplace("ingredients.name", field("ingredients.name", field_types::STRING, false));
+    search_schema.emplace("ingredients.concentration", field("ingredients.concentration", field_types::INT64, false));
+    search_schema.emplace("ingredients.tags", field("ingredients.tags", field_types::STRING_ARRAY, false));
+
+    // name: chee* && (concentration: [20..40] || tags: != spicy)
+    auto filter_tree_root = std::make_unique<filter_node_t>(AND,
+            new filter_node_t(filter{"ingredients.name", {"chee*"}, {CONTAINS}}),
+            new filter_node_t(OR,
+                    new filter_node_t(filter{"ingredients.concentration", {"20", "40"}, {RANGE_INCLUSIVE}}),
+                    new filter_node_t(filter{"ingredients.tags", {"spicy"}, {NOT_EQUALS}})));
+
+    object_filter_t object_filter;
+    ASSERT_FALSE(object_filter.is_compiled());
+    ASSERT_TRUE(object_filter_t::compile(search_schema, filter_tree_root.get(), object_filter).ok());
+    ASSERT_TRUE(object_filter.is_compiled());
+
+    ASSERT_TRUE(object_filter.matches(R"({"name": "cheese", "concentration": 30, "tags": ["spicy"]})"_json));
+    ASSERT_TRUE(object_filter.matches(R"({"name": "cheese", "concentration": 60, "tags": ["mild", "soft"]})"_json));
+    ASSERT_FALSE(object_filter.matches(R"({"name": "cheese", "concentration": 60, "tags": ["mild", "spicy"]})"_json));
+    ASSERT_FALSE(object_filter.matches(R"({"name": "olives", "concentration": 30, "tags": []})"_json));
+
+    // missing keys and values of another type do not match
+    ASSERT_FALSE(object_filter.matches(R"({"concentration": 30})"_json));
+    ASSERT_FALSE(object_filter.matches(R"({"name": "cheese", "concentration": "30", "tags": ["spicy"]})"_json));
+
+    auto bad_filter_root = std::make_unique<filter_node_t>(filter{"ingredients.concentration", {"abc"}, {EQUALS}});
+    auto compile_op = object_filter_t::compile(search_schema, bad_filter_root.get(), object_filter);
+    ASSERT_FALSE(compile_op.ok());
+    ASSERT_EQ("Error with filter field `ingredients.concentration`: Not an int64.", compile_op.error());
+
+    auto prefix_filter_root = std::make_unique<filter_node_t>(filter{"ingredients.name", {"chee"}, {STARTS_WITH}});
+    compile_op = object_filter_t::compile(search_schema, prefix_filter_root.get(), object_filter);
+    ASSERT_FALSE(compile_op.ok());
+    ASSERT_EQ(400, compile_op.code());
+    ASSERT_EQ("Error with filter field `ingredients.name`: Prefix and suffix filters are not supported within object "
+              "filters.", compile_op.error());
+
+    auto document = R"({"menu": {"ingredients": [{"name": "cheese"}]}})"_json;
+    auto object_array = object_filter_t::get_path(document, "menu.ingredients");
+    ASSERT_NE(nullptr, object_array);
+    ASSERT_TRUE(object_array->is_array());
+    ASSERT_EQ(nullptr, object_filter_t::get_path(document, "menu.toppings"));
+    ASSERT_EQ(nullptr, object_filter_t::get_path(document, "menu.ingredients.name"));
+}
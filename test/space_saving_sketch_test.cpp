@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <map>
+#include "space_saving_sketch.h"
+
+namespace {
+    void assert_bounds(const space_saving_sketch_t& sketch, const std::map<uint32_t, uint32_t>& frequencies) {
+        std::map<uint32_t, const space_saving_sketch_t::counter_t*> monitored;
+        for(const auto& counter: sketch.get_counters()) {
+            monitored[counter.item] = &counter;
+        }
+
+        for(const auto& kv: frequencies) {
+            const auto it = monitored.find(kv.first);
+            if(it == monitored.end()) {
+                ASSERT_LE(kv.second, sketch.max_unmonitored_count());
+                continue;
+            }
+
+            ASSERT_GE(it->second->count, kv.second);
+            ASSERT_LE(it->second->count - it->second->error, kv.second);
+        }
+    }
+}
+
+TEST(SpaceSavingSketchTest, ExactBelowCapacity) {
+    space_saving_sketch_t sketch(4);
+
+    for(uint32_t i = 0; i < 10; i++) {
+        sketch.update(i % 3, i, 0);
+    }
+
+    ASSERT_EQ(3, sketch.size());
+    ASSERT_EQ(0, sketch.max_unmonitored_count());
+
+    for(const auto& counter: sketch.get_counters()) {
+        ASSERT_EQ(0, counter.error);
+        ASSERT_EQ(counter.item == 0 ? 4 : 3, counter.count);
+    }
+
+    // a summary without counters ignores updates
+    space_saving_sketch_t empty_sketch;
+    empty_sketch.update(1, 1, 0);
+    ASSERT_EQ(0, empty_sketch.size());
+}
+
+TEST(SpaceSavingSketchTest, EvictsSmallestCount) {
+    space_saving_sketch_t sketch(2);
+    sketch.update(1, 0, 0);
+    sketch.update(1, 1, 0);
+    sketch.update(2, 2, 0);
+    sketch.update(3, 3, 5);
+
+    ASSERT_EQ(2, sketch.size());
+    ASSERT_EQ(2, sketch.max_unmonitored_count());
+
+    std::map<uint32_t, space_saving_sketch_t::counter_t> counters;
+    for(const auto& counter: sketch.get_counters()) {
+        counters[counter.item] = counter;
+    }
+
+    ASSERT_EQ(1, counters.count(1));
+    ASSERT_EQ(2, counters[1].count);
+    ASSERT_EQ(0, counters[1].error);
+
+    ASSERT_EQ(1, counters.count(3));
+    ASSERT_EQ(2, counters[3].count);
+    ASSERT_EQ(1, counters[3].error);
+    ASSERT_EQ(3, counters[3].doc_id);
+    ASSERT_EQ(5, counters[3].array_pos);
+}
+
+TEST(SpaceSavingSketchTest, BoundsOfSkewedStreamAndMerge) {
+    std::mt19937 gen(42);
+    std::discrete_distribution<uint32_t> distr({500, 250, 120, 60, 30, 20, 10, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+                                                5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5});
+
+    std::map<uint32_t, uint32_t> frequencies;
+    std::vector<space_saving_sketch_t> partitions(4, space_saving_sketch_t(8));
+
+    for(uint32_t i = 0; i < 20000; i++) {
+        const uint32_t item = distr(gen);
+        frequencies[item]++;
+        partitions[i % partitions.size()].update(item, i, 0);
+    }
+
+    space_saving_sketch_t merged;
+    for(const auto& partition: partitions) {
+        merged.merge(partition);
+    }
+
+    ASSERT_EQ(8, merged.capacity());
+    ASSERT_EQ(8, merged.size());
+    assert_bounds(merged, frequencies);
+
+    // the heaviest items are monitored with a lower bound above any other item's upper bound
+    std::map<uint32_t, const space_saving_sketch_t::counter_t*> monitored;
+    for(const auto& counter: merged.get_counters()) {
+        monitored[counter.item] = &counter;
+    }
+
+    for(uint32_t item = 0; item < 2; item++) {
+        ASSERT_EQ(1, monitored.count(item));
+        ASSERT_GT(monitored[item]->count - monitored[item]->error, merged.max_unmonitored_count());
+    }
+
+    // a single stream obeys the same bounds
+    space_saving_sketch_t sketch(8);
+    std::map<uint32_t, uint32_t> stream_frequencies;
+
+    for(uint32_t i = 0; i < 20000; i++) {
+        const uint32_t item = distr(gen);
+        stream_frequencies[item]++;
+        sketch.update(item, i, 0);
+    }
+
+    assert_bounds(sketch, stream_frequencies);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <algorithm>
+#include "string_sort_column.h"
+#include "adi_tree.h"
+
+TEST(StringSortColumnTest, BasicOps) {
+    string_sort_column_t column;
+
+    // operations on fresh column
+    ASSERT_EQ(INT64_MAX, column.rank(100));
+    column.remove(100);
+
+    column.index(100, "f");
+    ASSERT_NE(INT64_MAX, column.rank(100));
+
+    column.index(101, "e");
+    ASSERT_LT(column.rank(101), column.rank(100));
+
+    // empty values are not indexed
+    column.index(102, "");
+    ASSERT_EQ(INT64_MAX, column.rank(102));
+
+    // re-indexing an id is a no-op
+    column.index(101, "z");
+    ASSERT_LT(column.rank(101), column.rank(100));
+
+    column.remove(101);
+    ASSERT_EQ(INT64_MAX, column.rank(101));
+    ASSERT_NE(INT64_MAX, column.rank(100));
+
+    column.remove(100);
+    ASSERT_EQ(INT64_MAX, column.rank(100));
+    ASSERT_EQ(0, column.num_delta_values());
+}
+
+TEST(StringSortColumnTest, OrderInsertedStrings) {
+    std::vector<std::pair<uint32_t, std::string>> records = {
+        {1, "alpha"}, {2, "beta"},
+        {3, "foo"}, {4, "ant"}, {5, "foobar"},
+        {6, "buzz"}, {7, "foo"}, {8, "t"}, {9, "to"}
+    };
+
+    string_sort_column_t column;
+    for(auto& record: records) {
+        column.index(record.first, record.second);
+    }
+
+    auto assert_order = [&]() {
+        // alpha, ant, beta, buzz, foo, foo, foobar, t, to
+        ASSERT_LT(column.rank(1), column.rank(4));
+        ASSERT_LT(column.rank(4), column.rank(2));
+        ASSERT_LT(column.rank(2), column.rank(6));
+        ASSERT_LT(column.rank(6), column.rank(3));
+        ASSERT_EQ(column.rank(3), column.rank(7));
+        ASSERT_LT(column.rank(7), column.rank(5));
+        ASSERT_LT(column.rank(5), column.rank(8));
+        ASSERT_LT(column.rank(8), column.rank(9));
+    };
+
+    // values are in the delta
+    ASSERT_EQ(0, column.num_dictionary_values());
+    assert_order();
+
+    column.compact();
+    ASSERT_EQ(8, column.num_dictionary_values());
+    ASSERT_EQ(0, column.num_delta_values());
+    assert_order();
+
+    // new values interleave with the dictionary values
+    column.index(10, "aardvark");
+    column.index(11, "fooz");
+    column.index(12, "foo");
+    ASSERT_EQ(2, column.num_delta_values());
+
+    ASSERT_LT(column.rank(10), column.rank(1));
+    ASSERT_LT(column.rank(5), column.rank(11));
+    ASSERT_LT(column.rank(11), column.rank(8));
+    ASSERT_EQ(column.rank(3), column.rank(12));
+
+    column.remove(3);
+    column.remove(7);
+    column.remove(12);
+    column.compact();
+
+    ASSERT_EQ(9, column.num_dictionary_values());
+    ASSERT_EQ(INT64_MAX, column.rank(3));
+    ASSERT_LT(column.rank(10), column.rank(1));
+    ASSERT_LT(column.rank(6), column.rank(5));
+    ASSERT_LT(column.rank(5), column.rank(11));
+}
+
+TEST(StringSortColumnTest, OrderMatchesAdiTree) {
+    std::vector<std::string> values = {"t", "to", "T", "té", "tö", "t o", "élan", "zoo", "Zoo", "123", "1", "~"};
+
+    string_sort_column_t column;
+    adi_tree_t tree;
+
+    for (uint32_t i = 0; i < values.size(); i++) {
+        column.index(i, values[i]);
+        tree.index(i, values[i]);
+    }
+
+    for (uint32_t i = 0; i < values.size(); i++) {
+        for (uint32_t j = 0; j < values.size(); j++) {
+            ASSERT_EQ(tree.rank(i) < tree.rank(j), column.rank(i) < column.rank(j));
+        }
+    }
+}
+
+TEST(StringSortColumnTest, RandomOperations) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> value_distr(0, 5000);
+    std::uniform_int_distribution<uint32_t> op_distr(0, 9);
+
+    const uint32_t num_ids = 20000;
+    std::vector<std::string> id_values(num_ids);
+    string_sort_column_t column;
+
+    auto to_value = [](uint32_t v) {
+        return "title " + std::to_string(v);
+    };
+
+    // ascending appends followed by random inserts and removals
+    for (uint32_t id = 0; id < num_ids / 2; id++) {
+        id_values[id] = to_value(id);
+        column.index(id, id_values[id]);
+    }
+
+    for (size_t i = 0; i < 50000; i++) {
+        uint32_t id = gen() % num_ids;
+        if (op_distr(gen) < 3) {
+            column.remove(id);
+            id_values[id].clear();
+        } else if (id_values[id].empty()) {
+            id_values[id] = to_value(value_distr(gen));
+            column.index(id, id_values[id]);
+        }
+    }
+
+    ASSERT_LE(column.num_delta_values(), std::max<size_t>(string_sort_column_t::MIN_DELTA_LIMIT,
+                                                          column.num_dictionary_values() / 16));
+
+    std::vector<uint32_t> ids;
+    for (uint32_t id = 0; id < num_ids; id++) {
+        if (id_values[id].empty()) {
+            ASSERT_EQ(INT64_MAX, column.rank(id));
+        } else {
+            ids.push_back(id);
+        }
+    }
+
+    std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+        return id_values[a] < id_values[b];
+    });
+
+    for (size_t i = 1; i < ids.size(); i++) {
+        if (id_values[ids[i - 1]] == id_values[ids[i]]) {
+            ASSERT_EQ(column.rank(ids[i - 1]), column.rank(ids[i]));
+        } else {
+            ASSERT_LT(column.rank(ids[i - 1]), column.rank(ids[i]));
+        }
+    }
+}